@@ -2,9 +2,12 @@
 
 #include "src/Manager.h"
 
-int main() {
+int main(int argc, char *argv[]) {
     Manager manager = Manager();
 
+    if (argc > 1)
+        return manager.commandLine(std::vector<std::string>(argv + 1, argv + argc));
+
     manager.mainMenu();
 
     return 0;
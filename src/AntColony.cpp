@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <barrier>
+#include <cmath>
+#include <thread>
+#include "AntColony.h"
+
+AntColony::AntColony(const TSPInstance &instance, const AntColonyParameters &params)
+    : instance(instance), params(params), n(instance.size())
+{
+    this->params.ants = std::max(1, params.ants);
+    this->params.threads = std::max(1, std::min(params.threads, this->params.ants));
+    this->neighbours = instance.nearestNeighbours(params.neighbours);
+    this->k = std::max(0, std::min(params.neighbours, n - 1));
+
+    this->heuristic.resize((size_t)n * k);
+    for (int i = 0; i < n; i++)
+        for (int x = 0; x < k; x++)
+        {
+            double d = std::max(instance.dist(i, neighbours[(size_t)i * k + x]), 1e-9);
+            heuristic[(size_t)i * k + x] = (float)std::pow(1.0 / d, params.beta);
+        }
+    this->choice.resize((size_t)n * k);
+}
+
+int AntColony::getIterations() const
+{
+    return this->iterations;
+}
+
+void AntColony::setBounds(double bestCost)
+{
+    tauMax = (float)(1.0 / (params.rho * bestCost));
+    tauMin = tauMax / (2.0f * (float)n);
+}
+
+void AntColony::updateChoice()
+{
+    size_t m = (size_t)n * k;
+    if (params.alpha == 1)
+    {
+        for (size_t i = 0; i < m; i++)
+            choice[i] = pheromone[(i / k) * n + neighbours[i]] * heuristic[i];
+    }
+    else
+    {
+        auto alpha = (float)params.alpha;
+        for (size_t i = 0; i < m; i++)
+            choice[i] = std::pow(pheromone[(i / k) * n + neighbours[i]], alpha) * heuristic[i];
+    }
+}
+
+void AntColony::buildTour(std::mt19937 &rng, std::vector<int> &tour, std::vector<char> &visited, std::vector<float> &weights) const
+{
+    std::fill(visited.begin(), visited.end(), 0);
+    std::uniform_int_distribution<int> pickStart(0, n - 1);
+    std::uniform_real_distribution<float> roulette(0, 1);
+
+    int current = pickStart(rng);
+    tour[0] = current;
+    visited[current] = 1;
+    for (int step = 1; step < n; step++)
+    {
+        // roulette wheel over the unvisited candidates
+        float total = 0;
+        const float *c = &choice[(size_t)current * k];
+        const int *cand = &neighbours[(size_t)current * k];
+        for (int x = 0; x < k; x++)
+        {
+            weights[x] = visited[cand[x]] ? 0.0f : c[x];
+            total += weights[x];
+        }
+
+        int next = -1;
+        if (total > 0)
+        {
+            float r = roulette(rng) * total;
+            for (int x = 0; x < k; x++)
+            {
+                r -= weights[x];
+                if (r <= 0 && weights[x] > 0)
+                {
+                    next = cand[x];
+                    break;
+                }
+            }
+            if (next == -1)
+                for (int x = k - 1; x >= 0 && next == -1; x--)
+                    if (weights[x] > 0)
+                        next = cand[x];
+        }
+        else
+        {
+            // every candidate was visited: take the best unvisited vertex overall
+            double best = -1;
+            for (int j = 0; j < n; j++)
+            {
+                if (visited[j])
+                    continue;
+                double value = pheromone[(size_t)current * n + j] / std::pow(std::max(instance.dist(current, j), 1e-9), params.beta);
+                if (value > best)
+                {
+                    best = value;
+                    next = j;
+                }
+            }
+        }
+        tour[step] = next;
+        visited[next] = 1;
+        current = next;
+    }
+}
+
+void AntColony::evaporate()
+{
+    float keep = 1.0f - (float)params.rho;
+    float low = tauMin;
+    float *p = pheromone.data();
+    size_t m = pheromone.size();
+    for (size_t i = 0; i < m; i++)
+        p[i] = std::max(p[i] * keep, low);
+}
+
+void AntColony::deposit(const std::vector<int> &tour, double cost)
+{
+    auto amount = (float)(1.0 / cost);
+    for (size_t i = 0; i < tour.size(); i++)
+    {
+        int a = tour[i], b = tour[(i + 1) % tour.size()];
+        float value = std::min(pheromone[(size_t)a * n + b] + amount, tauMax);
+        pheromone[(size_t)a * n + b] = value;
+        pheromone[(size_t)b * n + a] = value;
+    }
+}
+
+std::vector<int> AntColony::run(const std::vector<int> &initialTour, SolverControl &control)
+{
+    std::vector<int> bestTour = initialTour;
+    double bestCost = instance.tourCost(initialTour);
+    this->iterations = 0;
+    if (n < 5 || k == 0)
+        return bestTour;
+
+    control.report(bestCost);
+    setBounds(bestCost);
+    pheromone.assign((size_t)n * n, tauMax);
+
+    int ants = params.ants;
+    int threads = params.threads;
+    std::vector<std::vector<int>> tours(ants, std::vector<int>(n));
+    std::vector<double> costs(ants);
+    std::vector<LocalSearchWorkspace> workspaces(threads);
+    std::vector<std::vector<char>> visited(threads, std::vector<char>(n));
+    std::vector<std::vector<float>> weights(threads, std::vector<float>(k));
+
+    int sinceImprovement = 0;
+    bool running = iterations < params.iterations && !control.shouldStop();
+    if (running)
+        updateChoice();
+
+    // the ants of an iteration are shared among workers that live for the whole run; the last one to reach the barrier
+    // updates the pheromone and prepares the next iteration
+    auto finishIteration = [&]() noexcept
+    {
+        int iterationBest = (int)(std::min_element(costs.begin(), costs.end()) - costs.begin());
+        if (costs[iterationBest] < bestCost - 1e-9)
+        {
+            bestCost = costs[iterationBest];
+            bestTour = tours[iterationBest];
+            setBounds(bestCost);
+            sinceImprovement = 0;
+        }
+        else
+            sinceImprovement++;
+        control.report(bestCost, ants);
+
+        evaporate();
+        if (iterations % 10 == 0)
+            deposit(bestTour, bestCost);
+        else
+            deposit(tours[iterationBest], costs[iterationBest]);
+
+        if (sinceImprovement >= 250)
+        {
+            // stagnation: restart the pheromone trails
+            std::fill(pheromone.begin(), pheromone.end(), tauMax);
+            sinceImprovement = 0;
+        }
+        iterations++;
+        running = iterations < params.iterations && !control.shouldStop();
+        if (running)
+            updateChoice();
+    };
+    std::barrier sync(threads, finishIteration);
+
+    auto work = [&](int t)
+    {
+        while (running)
+        {
+            for (int a = t; a < ants; a += threads)
+            {
+                std::mt19937 rng(params.seed + 1000003u * (unsigned)iterations + (unsigned)a);
+                buildTour(rng, tours[a], visited[t], weights[t]);
+                twoOptNeighbours(instance, tours[a], neighbours, k, workspaces[t]);
+                costs[a] = instance.tourCost(tours[a]);
+            }
+            sync.arrive_and_wait();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(work, t);
+    work(0);
+    for (auto &th : pool)
+        th.join();
+    return bestTour;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file AntColony.h
+ * @brief This file contains the implementation of the MAX-MIN Ant System.
+ */
+
+#ifndef DAPROJECT2_ANTCOLONY_H
+#define DAPROJECT2_ANTCOLONY_H
+
+#include <random>
+#include <vector>
+#include "LocalSearch.h"
+
+/**
+ * @struct AntColonyParameters
+ * @brief Parameters of the ant colony optimization.
+ */
+struct AntColonyParameters
+{
+    int ants = 25;            /**< Ants per iteration. */
+    int iterations = 100000;  /**< Maximum number of iterations. */
+    int neighbours = 15;      /**< Size of the candidate lists. */
+    double alpha = 1;         /**< Weight of the pheromone. */
+    double beta = 3;          /**< Weight of the distance heuristic. */
+    double rho = 0.02;        /**< Pheromone evaporation rate. */
+    int threads = 4;          /**< Threads building tours. */
+    unsigned seed = 42;       /**< Seed of the random number generators. */
+};
+
+/**
+ * @class AntColony
+ * @brief MAX-MIN Ant System (MMAS) with candidate lists and 2-opt.
+ *
+ * Pheromone is stored in a dense float matrix indexed by the instance's dense vertex indexes.
+ * Ants choose the next vertex among the k nearest unvisited neighbours of the current one and only fall back to
+ * the whole vertex set when all of them were visited. The ants of an iteration are built in parallel by worker threads
+ * kept for the whole run, which meet at a barrier between iterations; each ant has its own random generator seeded
+ * from the iteration and ant number, so results do not depend on the number of threads.
+ */
+class AntColony
+{
+public:
+    static const int MAX_VERTICES = 5000; /**< Largest instance whose pheromone matrix is stored. */
+
+    /**
+     * @brief Constructs the ant colony for an instance.
+     *
+     * @param instance The instance to solve.
+     * @param params The parameters.
+     */
+    AntColony(const TSPInstance &instance, const AntColonyParameters &params);
+
+    /**
+     * @brief Runs the ant colony until the iteration limit is reached or the control asks it to stop.
+     *
+     * Time complexity: O(I * A * V * k) being I the number of iterations and A the number of ants
+     *
+     * @param initialTour A tour used to initialize the pheromone bounds (for example the triangular approximation tour).
+     * @param control Deadline, cancellation and progress reporting.
+     * @return The best tour found.
+     */
+    std::vector<int> run(const std::vector<int> &initialTour, SolverControl &control);
+
+    /**
+     * @brief Returns the number of iterations run by the last call to run().
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of iterations.
+     */
+    int getIterations() const;
+
+private:
+    const TSPInstance &instance;
+    AntColonyParameters params;
+    int n;
+    int k;
+    std::vector<int> neighbours;    /**< Candidate lists, k per vertex. */
+    std::vector<float> pheromone;   /**< Dense n x n pheromone matrix. */
+    std::vector<float> heuristic;   /**< (1 / distance)^beta of each candidate edge. */
+    std::vector<float> choice;      /**< pheromone^alpha * heuristic of each candidate edge. */
+    float tauMin = 0;
+    float tauMax = 0;
+    int iterations = 0;
+
+    void updateChoice();
+    void buildTour(std::mt19937 &rng, std::vector<int> &tour, std::vector<char> &visited, std::vector<float> &weights) const;
+    void evaporate();
+    void deposit(const std::vector<int> &tour, double cost);
+    void setBounds(double bestCost);
+};
+
+#endif // DAPROJECT2_ANTCOLONY_H
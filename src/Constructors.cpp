@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <numeric>
+#include "Constructors.h"
+
+void completeTour(const TSPInstance &instance, std::vector<int> &tour)
+{
+    int n = instance.size();
+    if ((int)tour.size() >= n)
+        return;
+
+    std::vector<char> visited(n, 0);
+    for (int v : tour)
+        visited[v] = 1;
+    std::vector<int> missing;
+    for (int v = 0; v < n; v++)
+        if (!visited[v])
+            missing.push_back(v);
+
+    int last = tour.back();
+    while (!missing.empty())
+    {
+        int bestPos = 0;
+        double bestDist = instance.dist(last, missing[0]);
+        for (int p = 1; p < (int)missing.size(); p++)
+        {
+            double d = instance.dist(last, missing[p]);
+            if (d < bestDist)
+            {
+                bestDist = d;
+                bestPos = p;
+            }
+        }
+        last = missing[bestPos];
+        tour.push_back(last);
+        missing[bestPos] = missing.back();
+        missing.pop_back();
+    }
+}
+
+std::vector<int> nearestNeighbourTour(const TSPInstance &instance, int start)
+{
+    std::vector<int> tour = {start};
+    completeTour(instance, tour);
+    return tour;
+}
+
+std::vector<int> mstPreorderTour(const TSPInstance &instance, int root)
+{
+    int n = instance.size();
+    std::vector<double> key(n, INF);
+    std::vector<int> parentOf(n, -1);
+    std::vector<char> inTree(n, 0);
+    key[root] = 0;
+
+    for (int step = 0; step < n; step++)
+    {
+        int u = -1;
+        for (int v = 0; v < n; v++)
+            if (!inTree[v] && (u == -1 || key[v] < key[u]))
+                u = v;
+        inTree[u] = 1;
+        for (int v = 0; v < n; v++)
+        {
+            if (inTree[v])
+                continue;
+            double d = instance.dist(u, v);
+            if (d < key[v])
+            {
+                key[v] = d;
+                parentOf[v] = u;
+            }
+        }
+    }
+
+    // children lists in CSR form, then an iterative preorder
+    std::vector<int> start(n + 1, 0), children(n);
+    for (int v = 0; v < n; v++)
+        if (parentOf[v] != -1)
+            start[parentOf[v] + 1]++;
+    for (int v = 0; v < n; v++)
+        start[v + 1] += start[v];
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (int v = 0; v < n; v++)
+        if (parentOf[v] != -1)
+            children[fill[parentOf[v]]++] = v;
+
+    std::vector<int> tour, stack = {root};
+    tour.reserve(n);
+    while (!stack.empty())
+    {
+        int v = stack.back();
+        stack.pop_back();
+        tour.push_back(v);
+        for (int c = start[v + 1] - 1; c >= start[v]; c--)
+            stack.push_back(children[c]);
+    }
+    return tour;
+}
+
+static int findRoot(std::vector<int> &root, int v)
+{
+    while (root[v] != v)
+    {
+        root[v] = root[root[v]];
+        v = root[v];
+    }
+    return v;
+}
+
+std::vector<int> greedyEdgeTour(const TSPInstance &instance, const std::vector<int> &neighbours, int k, int start)
+{
+    int n = instance.size();
+    if (n < 3)
+    {
+        std::vector<int> tour(n);
+        std::iota(tour.begin(), tour.end(), 0);
+        return tour;
+    }
+
+    std::vector<std::pair<double, std::pair<int, int>>> edges;
+    edges.reserve((size_t)n * k);
+    for (int i = 0; i < n; i++)
+        for (int x = 0; x < k; x++)
+        {
+            int j = neighbours[(size_t)i * k + x];
+            if (i < j)
+                edges.push_back({instance.dist(i, j), {i, j}});
+        }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<int> root(n), degree(n, 0);
+    std::vector<int> link(2 * (size_t)n, -1); // two tour neighbours per vertex
+    std::iota(root.begin(), root.end(), 0);
+    for (auto &e : edges)
+    {
+        int a = e.second.first, b = e.second.second;
+        if (degree[a] == 2 || degree[b] == 2)
+            continue;
+        int ra = findRoot(root, a), rb = findRoot(root, b);
+        if (ra == rb)
+            continue;
+        root[ra] = rb;
+        link[2 * a + degree[a]++] = b;
+        link[2 * b + degree[b]++] = a;
+    }
+
+    // walk every path from one of its ends and join the paths in nearest-neighbour order
+    std::vector<char> visited(n, 0);
+    std::vector<int> ends;
+    for (int v = 0; v < n; v++)
+        if (degree[v] < 2)
+            ends.push_back(v);
+
+    std::vector<int> tour;
+    tour.reserve(n);
+    auto walk = [&](int v)
+    {
+        int prev = -1;
+        while (v != -1)
+        {
+            visited[v] = 1;
+            tour.push_back(v);
+            int next = -1;
+            for (int s = 0; s < degree[v]; s++)
+                if (link[2 * v + s] != prev && !visited[link[2 * v + s]])
+                    next = link[2 * v + s];
+            prev = v;
+            v = next;
+        }
+    };
+
+    int first = ends.empty() ? 0 : ends[0];
+    if (start >= 0 && start < n)
+    {
+        // the walk begins at an end of the path holding the start vertex
+        int prev = -1;
+        first = start;
+        while (degree[first] == 2)
+        {
+            int next = link[2 * first] != prev ? link[2 * first] : link[2 * first + 1];
+            prev = first;
+            first = next;
+        }
+    }
+    walk(first);
+    while ((int)tour.size() < n)
+    {
+        int last = tour.back(), best = -1;
+        for (int v : ends)
+            if (!visited[v] && (best == -1 || instance.dist(last, v) < instance.dist(last, best)))
+                best = v;
+        walk(best);
+    }
+    return tour;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file Constructors.h
+ * @brief This file contains the heuristics that build an initial tour for the solvers.
+ */
+
+#ifndef DAPROJECT2_CONSTRUCTORS_H
+#define DAPROJECT2_CONSTRUCTORS_H
+
+#include <vector>
+#include "TSPInstance.h"
+
+/**
+ * @brief Completes a partial tour with the vertices it does not visit yet, in nearest-neighbour order.
+ *
+ * Used when the minimum spanning tree does not reach every vertex (for example real-world graphs loaded without edges).
+ *
+ * Time complexity: O(V * M) being M the number of missing vertexes
+ *
+ * @param instance The instance.
+ * @param tour The partial tour, extended in place (it must have at least one vertex).
+ */
+void completeTour(const TSPInstance &instance, std::vector<int> &tour);
+
+/**
+ * @brief Builds a tour with the nearest neighbour heuristic.
+ *
+ * Time complexity: O(V^2)
+ *
+ * @param instance The instance.
+ * @param start Dense index of the first vertex.
+ * @return The tour.
+ */
+std::vector<int> nearestNeighbourTour(const TSPInstance &instance, int start);
+
+/**
+ * @brief Builds the triangular approximation tour (preorder of a minimum spanning tree) directly on the instance.
+ *
+ * The tree is built with the array-scan version of Prim's algorithm, which needs no priority queue.
+ *
+ * Time complexity: O(V^2)
+ *
+ * @param instance The instance.
+ * @param root Dense index of the root of the tree.
+ * @return The tour.
+ */
+std::vector<int> mstPreorderTour(const TSPInstance &instance, int root);
+
+/**
+ * @brief Builds a tour with the greedy edge heuristic restricted to the neighbour lists.
+ *
+ * Candidate edges are added by increasing length whenever both ends have degree below two and no cycle is closed.
+ * The resulting paths are then joined end to end in nearest-neighbour order, from the path holding the start vertex,
+ * so different start vertices join the paths differently.
+ *
+ * Time complexity: O(V * k * log(V * k) + F^2) being F the number of paths left
+ *
+ * @param instance The instance.
+ * @param neighbours The neighbour lists, as returned by TSPInstance::nearestNeighbours.
+ * @param k The number of neighbours per vertex.
+ * @param start Dense index of the start vertex (-1 to start from the first path end).
+ * @return The tour.
+ */
+std::vector<int> greedyEdgeTour(const TSPInstance &instance, const std::vector<int> &neighbours, int k, int start = -1);
+
+#endif // DAPROJECT2_CONSTRUCTORS_H
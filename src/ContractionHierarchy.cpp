@@ -0,0 +1,638 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <thread>
+#include "ContractionHierarchy.h"
+
+namespace
+{
+const uint32_t FILE_MAGIC = 0x48435044; // "DPCH"
+const uint32_t FILE_VERSION = 1;
+
+/*
+ * An arc of the graph being contracted: to (or from) node, skipping middle if it is a shortcut.
+ */
+struct Arc
+{
+    int node;
+    double weight;
+    int middle;
+};
+
+/*
+ * The graph during the contraction, by dense vertex index, with the witness search. Arcs to contracted vertices are
+ * removed, so the arcs of a vertex are its arcs in the hierarchy once it is contracted.
+ */
+class Contractor
+{
+public:
+    std::vector<std::vector<Arc>> out;
+    std::vector<std::vector<Arc>> in;
+    std::vector<char> contracted;
+    std::vector<int> deleted; /**< Neighbours already contracted. */
+
+    explicit Contractor(const Graph &graph)
+    {
+        int n = graph.getNumVertex();
+        out.resize(n);
+        in.resize(n);
+        contracted.assign(n, 0);
+        deleted.assign(n, 0);
+        queue.reset(n);
+        dist.assign(n, INF);
+        direct.assign(n, INF);
+        wanted.assign(n, 0);
+        for (const Vertex *v : graph.getVertices())
+            for (auto &e : v->getAdj())
+            {
+                int x = e.second->getDest()->getIndex();
+                if (x != v->getIndex())
+                    addArc(v->getIndex(), x, e.second->getWeight(), -1);
+            }
+    }
+
+    void addArc(int u, int x, double weight, int middle)
+    {
+        for (Arc &a : out[u])
+            if (a.node == x)
+            {
+                if (weight < a.weight)
+                {
+                    a.weight = weight;
+                    a.middle = middle;
+                    for (Arc &b : in[x])
+                        if (b.node == u)
+                            b = {u, weight, middle};
+                }
+                return;
+            }
+        out[u].push_back({x, weight, middle});
+        in[x].push_back({u, weight, middle});
+    }
+
+    /*
+     * Counts the shortcuts that contracting v needs and, unless simulating, adds them.
+     */
+    int contract(int v, bool simulate)
+    {
+        int added = 0;
+        for (size_t k = 0; k < in[v].size(); k++)
+        {
+            Arc from = in[v][k];
+            int u = from.node;
+            // the paths through v that a direct arc of u already matches need no search
+            for (const Arc &a : out[u])
+                direct[a.node] = a.weight;
+            int needed = 0;
+            double limit = 0;
+            for (const Arc &to : out[v])
+                if (to.node != u && direct[to.node] > from.weight + to.weight)
+                {
+                    wanted[to.node] = 1;
+                    needed++;
+                    limit = std::max(limit, from.weight + to.weight);
+                }
+            for (const Arc &a : out[u])
+                direct[a.node] = INF;
+            if (needed == 0)
+                continue;
+
+            witness(u, v, limit, needed);
+            for (const Arc &to : out[v])
+                if (wanted[to.node])
+                {
+                    wanted[to.node] = 0;
+                    double via = from.weight + to.weight;
+                    if (dist[to.node] > via)
+                    {
+                        added++;
+                        if (!simulate)
+                            addArc(u, to.node, via, v);
+                    }
+                }
+        }
+        return added;
+    }
+
+    double priority(int v)
+    {
+        return contract(v, true) - (double)(out[v].size() + in[v].size()) + deleted[v];
+    }
+
+    /*
+     * Marks v contracted and removes its arcs from its neighbours, returning them.
+     */
+    std::vector<int> remove(int v)
+    {
+        std::vector<int> neighbours;
+        auto detach = [&](std::vector<Arc> &arcs, int node)
+        {
+            for (size_t k = 0; k < arcs.size(); k++)
+                if (arcs[k].node == node)
+                {
+                    arcs[k] = arcs.back();
+                    arcs.pop_back();
+                    break;
+                }
+        };
+        for (const Arc &a : out[v])
+        {
+            detach(in[a.node], v);
+            neighbours.push_back(a.node);
+        }
+        for (const Arc &a : in[v])
+        {
+            detach(out[a.node], v);
+            neighbours.push_back(a.node);
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (int x : neighbours)
+            deleted[x]++;
+        contracted[v] = 1;
+        return neighbours;
+    }
+
+private:
+    IndexedHeap<4> queue;
+    std::vector<double> dist;
+    std::vector<int> touched;
+    std::vector<double> direct; /**< Weight of the arc from the vertex being searched from to every vertex. */
+    std::vector<char> wanted;   /**< Whether a path to every vertex is looked for. */
+
+    /*
+     * Dijkstra from u without going through v, up to the distance limit, until the wanted vertices are settled.
+     */
+    void witness(int u, int v, double limit, int needed)
+    {
+        for (int x : touched)
+            dist[x] = INF;
+        touched.clear();
+        queue.clear();
+        dist[u] = 0;
+        touched.push_back(u);
+        queue.push(u, 0);
+        for (int settled = 0; !queue.empty() && settled < ContractionHierarchy::WITNESS_SETTLE_LIMIT; settled++)
+        {
+            int x = queue.pop();
+            double dx = dist[x];
+            if (dx > limit || (wanted[x] && --needed == 0))
+                break;
+            for (const Arc &a : out[x])
+            {
+                double d = dx + a.weight;
+                if (a.node != v && d < dist[a.node])
+                {
+                    if (dist[a.node] == INF)
+                        touched.push_back(a.node);
+                    dist[a.node] = d;
+                    queue.pushOrDecrease(a.node, d);
+                }
+            }
+        }
+    }
+};
+
+template <class T>
+void writeArray(std::ofstream &file, const std::vector<T> &values)
+{
+    file.write(reinterpret_cast<const char *>(values.data()), (std::streamsize)(values.size() * sizeof(T)));
+}
+
+template <class T>
+bool readArray(std::ifstream &file, std::vector<T> &values, size_t count)
+{
+    values.resize(count);
+    return (bool)file.read(reinterpret_cast<char *>(values.data()), (std::streamsize)(count * sizeof(T)));
+}
+} // namespace
+
+ContractionHierarchy::ContractionHierarchy(const Graph &graph) : fingerprint(graph.fingerprint())
+{
+    int n = graph.getNumVertex();
+    Contractor contractor(graph);
+
+    // lazy updates: a vertex is contracted only if its priority, computed again, is still the smallest
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    std::vector<double> priority(n);
+    for (int v = 0; v < n; v++)
+    {
+        priority[v] = contractor.priority(v);
+        queue.emplace(priority[v], v);
+    }
+    std::vector<int> order, rank(n);
+    std::vector<std::vector<Arc>> up(n), down(n);
+    while (!queue.empty())
+    {
+        auto [key, v] = queue.top();
+        queue.pop();
+        if (contractor.contracted[v] || key != priority[v])
+            continue;
+        priority[v] = contractor.priority(v);
+        if (!queue.empty() && priority[v] > queue.top().first)
+        {
+            queue.emplace(priority[v], v);
+            continue;
+        }
+        contractor.contract(v, false);
+        std::vector<int> neighbours = contractor.remove(v);
+        up[v] = std::move(contractor.out[v]);
+        down[v] = std::move(contractor.in[v]);
+        rank[v] = (int)order.size();
+        order.push_back(v);
+    }
+
+    auto build = [&](const std::vector<std::vector<Arc>> &arcs, Arcs &result)
+    {
+        result.start.assign(1, 0);
+        for (int v : order)
+        {
+            for (const Arc &a : arcs[v])
+            {
+                result.target.push_back(rank[a.node]);
+                result.middle.push_back(a.middle == -1 ? -1 : rank[a.middle]);
+                result.weight.push_back(a.weight);
+                if (a.middle != -1)
+                    this->shortcuts++;
+            }
+            result.start.push_back((int)result.target.size());
+        }
+    };
+    build(up, this->forward);
+    build(down, this->backward);
+    for (int v : order)
+    {
+        this->rankOf[graph.getVertices()[v]->getId()] = (int)this->ids.size();
+        this->ids.push_back(graph.getVertices()[v]->getId());
+    }
+}
+
+int ContractionHierarchy::size() const
+{
+    return (int)this->ids.size();
+}
+
+uint64_t ContractionHierarchy::getFingerprint() const
+{
+    return this->fingerprint;
+}
+
+size_t ContractionHierarchy::getShortcuts() const
+{
+    return this->shortcuts;
+}
+
+size_t ContractionHierarchy::memoryUsage() const
+{
+    size_t arcs = this->forward.target.size() + this->backward.target.size();
+    return sizeof(ContractionHierarchy) + this->ids.size() * (3 * sizeof(int) + 2 * sizeof(void *) + 2 * sizeof(int)) +
+           arcs * (2 * sizeof(int) + sizeof(double));
+}
+
+int ContractionHierarchy::findRank(int id) const
+{
+    auto it = this->rankOf.find(id);
+    return it == this->rankOf.end() ? -1 : it->second;
+}
+
+void ContractionHierarchy::Search::prepare(int n)
+{
+    if ((int)this->dist.size() != n)
+    {
+        this->queue.reset(n);
+        this->dist.assign(n, INF);
+        this->parent.assign(n, -1);
+        this->arc.assign(n, -1);
+        this->touched.clear();
+    }
+}
+
+void ContractionHierarchy::Search::start(int rank)
+{
+    for (int v : this->touched)
+    {
+        this->dist[v] = INF;
+        this->parent[v] = -1;
+    }
+    this->touched.clear();
+    this->queue.clear();
+    this->dist[rank] = 0;
+    this->touched.push_back(rank);
+    this->queue.push(rank, 0);
+}
+
+void ContractionHierarchy::relax(const Arcs &arcs, int u, Search &search)
+{
+    double du = search.dist[u];
+    for (int a = arcs.start[u]; a < arcs.start[u + 1]; a++)
+    {
+        int v = arcs.target[a];
+        double d = du + arcs.weight[a];
+        if (d < search.dist[v])
+        {
+            if (search.dist[v] == INF)
+                search.touched.push_back(v);
+            search.dist[v] = d;
+            search.parent[v] = u;
+            search.arc[v] = a;
+            search.queue.pushOrDecrease(v, d);
+        }
+    }
+}
+
+void ContractionHierarchy::upward(const Arcs &arcs, Search &search) const
+{
+    while (!search.queue.empty())
+        relax(arcs, search.queue.pop(), search);
+}
+
+double ContractionHierarchy::meet(int source, int target, Search &up, Search &down, int &top) const
+{
+    up.start(source);
+    down.start(target);
+    double best = INF;
+    top = -1;
+    bool forwardTurn = true;
+    while (true)
+    {
+        // a side stops once its closest vertex is farther than the best path found
+        bool forwardDone = up.queue.empty() || up.queue.key(up.queue.top()) >= best;
+        bool backwardDone = down.queue.empty() || down.queue.key(down.queue.top()) >= best;
+        if (forwardDone && backwardDone)
+            break;
+        bool useForward = backwardDone || (forwardTurn && !forwardDone);
+        forwardTurn = !forwardTurn;
+        Search &side = useForward ? up : down;
+        Search &other = useForward ? down : up;
+        int u = side.queue.pop();
+        double d = side.dist[u] + other.dist[u];
+        if (d < best)
+        {
+            best = d;
+            top = u;
+        }
+        relax(useForward ? this->forward : this->backward, u, side);
+    }
+    return best;
+}
+
+double ContractionHierarchy::distance(int sourceId, int targetId) const
+{
+    int source = findRank(sourceId), target = findRank(targetId);
+    if (source == -1 || target == -1)
+        return INF;
+    static thread_local Search up, down;
+    up.prepare(size());
+    down.prepare(size());
+    int top;
+    return meet(source, target, up, down, top);
+}
+
+std::vector<double> ContractionHierarchy::distances(int sourceId, const std::vector<int> &targetIds) const
+{
+    return table({sourceId}, targetIds);
+}
+
+std::vector<double> ContractionHierarchy::table(const std::vector<int> &sourceIds, const std::vector<int> &targetIds,
+                                                int threads) const
+{
+    int s = (int)sourceIds.size(), t = (int)targetIds.size(), n = size();
+    std::vector<double> result((size_t)s * t, INF);
+    if (s == 0 || t == 0)
+        return result;
+    auto run = [threads](int count, const std::function<void(int, Search &)> &task)
+    {
+        std::atomic<int> next{0};
+        auto work = [&]()
+        {
+            Search search;
+            for (int i; (i = next++) < count;)
+                task(i, search);
+        };
+        std::vector<std::thread> pool;
+        for (int k = 1; k < std::min(threads, count); k++)
+            pool.emplace_back(work);
+        work();
+        for (auto &thread : pool)
+            thread.join();
+    };
+
+    // the backward search space of every target, stored in buckets by vertex
+    std::vector<std::vector<std::pair<int, double>>> spaces(t);
+    run(t, [&](int j, Search &search)
+        {
+            int target = findRank(targetIds[j]);
+            if (target == -1)
+                return;
+            search.prepare(n);
+            search.start(target);
+            upward(this->backward, search);
+            for (int v : search.touched)
+                spaces[j].emplace_back(v, search.dist[v]);
+        });
+    std::vector<int> bucketStart(n + 1, 0);
+    for (auto &space : spaces)
+        for (auto &entry : space)
+            bucketStart[entry.first + 1]++;
+    for (int v = 0; v < n; v++)
+        bucketStart[v + 1] += bucketStart[v];
+    std::vector<std::pair<int, double>> buckets(bucketStart[n]);
+    std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (int j = 0; j < t; j++)
+    {
+        for (auto &entry : spaces[j])
+            buckets[fill[entry.first]++] = {j, entry.second};
+        std::vector<std::pair<int, double>>().swap(spaces[j]);
+    }
+
+    run(s, [&](int i, Search &search)
+        {
+            int source = findRank(sourceIds[i]);
+            if (source == -1)
+                return;
+            search.prepare(n);
+            search.start(source);
+            upward(this->forward, search);
+            double *row = result.data() + (size_t)i * t;
+            for (int v : search.touched)
+                for (int b = bucketStart[v]; b < bucketStart[v + 1]; b++)
+                    row[buckets[b].first] = std::min(row[buckets[b].first], search.dist[v] + buckets[b].second);
+        });
+    return result;
+}
+
+void ContractionHierarchy::unpack(int from, int to, int middle, std::vector<int> &ranks) const
+{
+    // a shortcut from -> to skipping middle is the arc from -> middle (kept backward at middle, which is lower) followed
+    // by the arc middle -> to (kept forward at middle)
+    auto middleOf = [](const Arcs &arcs, int at, int target)
+    {
+        for (int a = arcs.start[at]; a < arcs.start[at + 1]; a++)
+            if (arcs.target[a] == target)
+                return arcs.middle[a];
+        return -1;
+    };
+    std::vector<std::array<int, 3>> stack = {{from, to, middle}};
+    while (!stack.empty())
+    {
+        auto [a, b, m] = stack.back();
+        stack.pop_back();
+        if (m == -1)
+        {
+            ranks.push_back(b);
+            continue;
+        }
+        stack.push_back({m, b, middleOf(this->forward, m, b)});
+        stack.push_back({a, m, middleOf(this->backward, m, a)});
+    }
+}
+
+std::vector<int> ContractionHierarchy::path(int sourceId, int targetId) const
+{
+    int source = findRank(sourceId), target = findRank(targetId);
+    if (source == -1 || target == -1)
+        return {};
+    Search up, down;
+    up.prepare(size());
+    down.prepare(size());
+    int top;
+    if (meet(source, target, up, down, top) >= INF)
+        return {};
+
+    std::vector<int> climb;
+    for (int v = top; v != source; v = up.parent[v])
+        climb.push_back(v);
+    std::vector<int> ranks = {source};
+    for (int k = (int)climb.size() - 1; k >= 0; k--)
+    {
+        int v = climb[k];
+        unpack(up.parent[v], v, this->forward.middle[up.arc[v]], ranks);
+    }
+    for (int v = top; v != target; v = down.parent[v])
+        unpack(v, down.parent[v], this->backward.middle[down.arc[v]], ranks);
+
+    std::vector<int> result;
+    for (int r : ranks)
+        result.push_back(this->ids[r]);
+    return result;
+}
+
+bool ContractionHierarchy::save(const std::string &path, std::string &error) const
+{
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        if (!file)
+        {
+            error = "cannot write " + path;
+            return false;
+        }
+        int32_t n = size();
+        file.write(reinterpret_cast<const char *>(&FILE_MAGIC), sizeof(FILE_MAGIC));
+        file.write(reinterpret_cast<const char *>(&FILE_VERSION), sizeof(FILE_VERSION));
+        file.write(reinterpret_cast<const char *>(&this->fingerprint), sizeof(this->fingerprint));
+        file.write(reinterpret_cast<const char *>(&n), sizeof(n));
+        writeArray(file, this->ids);
+        for (const Arcs *arcs : {&this->forward, &this->backward})
+        {
+            int64_t count = (int64_t)arcs->target.size();
+            file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+            writeArray(file, arcs->start);
+            writeArray(file, arcs->target);
+            writeArray(file, arcs->middle);
+            writeArray(file, arcs->weight);
+        }
+        if (!file)
+        {
+            error = "cannot write " + path;
+            return false;
+        }
+    }
+    std::error_code code;
+    std::filesystem::rename(temporary, path, code);
+    if (code)
+    {
+        error = "cannot write " + path + ": " + code.message();
+        return false;
+    }
+    return true;
+}
+
+bool ContractionHierarchy::load(const std::string &path, std::string &error)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    uint32_t magic = 0, version = 0;
+    uint64_t fingerprint = 0;
+    int32_t n = -1;
+    file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char *>(&version), sizeof(version));
+    file.read(reinterpret_cast<char *>(&fingerprint), sizeof(fingerprint));
+    file.read(reinterpret_cast<char *>(&n), sizeof(n));
+    if (!file || magic != FILE_MAGIC || version != FILE_VERSION || n < 0)
+    {
+        error = path + " is not a contraction hierarchy";
+        return false;
+    }
+
+    // every size and index is checked, so the searches and the unpacking of a damaged file cannot go out of bounds
+    // or loop: arcs only go up, and a shortcut only skips a vertex lower than both its ends
+    auto bad = [&error, &path]()
+    {
+        error = path + " is damaged";
+        return false;
+    };
+    std::vector<int> ids;
+    if (!readArray(file, ids, n))
+        return bad();
+    std::unordered_map<int, int> rankOf;
+    for (int r = 0; r < n; r++)
+        if (!rankOf.emplace(ids[r], r).second)
+            return bad();
+    Arcs arcs[2];
+    size_t shortcuts = 0;
+    for (Arcs &result : arcs)
+    {
+        int64_t count = -1;
+        file.read(reinterpret_cast<char *>(&count), sizeof(count));
+        if (!file || count < 0 || count > INT32_MAX || !readArray(file, result.start, n + 1) ||
+            !readArray(file, result.target, count) || !readArray(file, result.middle, count) ||
+            !readArray(file, result.weight, count))
+            return bad();
+        if (result.start[0] != 0 || result.start[n] != count)
+            return bad();
+        for (int r = 0; r < n; r++)
+        {
+            if (result.start[r + 1] < result.start[r])
+                return bad();
+            for (int a = result.start[r]; a < result.start[r + 1]; a++)
+            {
+                if (result.target[a] <= r || result.target[a] >= n || result.middle[a] < -1 || result.middle[a] >= r ||
+                    !(result.weight[a] >= 0))
+                    return bad();
+                if (result.middle[a] != -1)
+                    shortcuts++;
+            }
+        }
+    }
+    if (file.peek() != EOF)
+        return bad();
+
+    this->fingerprint = fingerprint;
+    this->ids = std::move(ids);
+    this->rankOf = std::move(rankOf);
+    this->forward = std::move(arcs[0]);
+    this->backward = std::move(arcs[1]);
+    this->shortcuts = shortcuts;
+    return true;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file ContractionHierarchy.h
+ * @brief This file contains the contraction hierarchy of a graph, an index answering shortest path distances quickly.
+ */
+
+#ifndef DAPROJECT2_CONTRACTIONHIERARCHY_H
+#define DAPROJECT2_CONTRACTIONHIERARCHY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Graph.h"
+#include "IndexedHeap.h"
+
+/**
+ * @class ContractionHierarchy
+ * @brief Shortest path distances over the edges of a graph, answered by searches that only visit a few vertices, for
+ * large sparse graphs such as road networks.
+ *
+ * The vertices are contracted one by one, the one whose removal adds the fewest shortcuts (edge difference plus the
+ * number of neighbours already contracted) first; a priority is computed again when the vertex reaches the top of the
+ * queue, and the vertex goes back in if it is no longer the smallest. Contracting a vertex adds a shortcut between two of its neighbours
+ * when no witness path, found by a Dijkstra search limited to WITNESS_SETTLE_LIMIT vertices, is as short as the path
+ * through it. The contraction order is the rank of the vertices, and every edge and shortcut is kept in the index of
+ * its lower end, in CSR form: the arcs to higher vertices (forward) and the arcs from higher vertices (backward).
+ *
+ * A query searches upwards from both ends and meets at the highest vertex of the shortest path; the one-to-many and
+ * table queries store the backward search spaces of the targets in buckets, scanned by the forward search of every
+ * source. Queries only read the index, so several threads can run them at once. Shortcuts keep the vertex they skip,
+ * so paths can be unpacked into the edges of the graph.
+ *
+ * Edge weights must not be negative. The index does not follow changes to the graph: it carries the fingerprint of the
+ * graph it was built from (see Graph::fingerprint).
+ */
+class ContractionHierarchy
+{
+public:
+    static const int WITNESS_SETTLE_LIMIT = 500; /**< Vertices settled by a witness search before it gives up. */
+
+    /**
+     * @brief Constructs an empty hierarchy, to be read with load.
+     */
+    ContractionHierarchy() = default;
+
+    /**
+     * @brief Builds the hierarchy of a graph.
+     *
+     * Time complexity: O(V * D^2 * W) in the worst case, being D the largest degree during the contraction and W the
+     * cost of a witness search; close to O(V * log(V)) on road networks
+     *
+     * @param graph The graph.
+     */
+    explicit ContractionHierarchy(const Graph &graph);
+
+    /**
+     * @brief Returns the number of vertices of the hierarchy.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of vertices.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns the fingerprint of the graph the hierarchy was built from.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The fingerprint.
+     */
+    uint64_t getFingerprint() const;
+
+    /**
+     * @brief Returns the number of shortcuts added by the contraction.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of shortcuts.
+     */
+    size_t getShortcuts() const;
+
+    /**
+     * @brief Estimates the memory used by the hierarchy.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The memory, in bytes.
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * @brief Computes the shortest path distance between two vertices.
+     *
+     * Time complexity: O(S * log(S)) being S the size of the upward search spaces (small on road networks)
+     *
+     * @param sourceId The ID of the source.
+     * @param targetId The ID of the target.
+     * @return The distance (INF if there is no path or a vertex is not in the hierarchy).
+     */
+    double distance(int sourceId, int targetId) const;
+
+    /**
+     * @brief Computes the shortest path distances from one vertex to several.
+     *
+     * Time complexity: O((T + 1) * S * log(S) + B) being T the number of targets and B the size of the buckets scanned
+     *
+     * @param sourceId The ID of the source.
+     * @param targetIds The IDs of the targets.
+     * @return The distance to every target, in order (INF for unreachable or unknown vertices).
+     */
+    std::vector<double> distances(int sourceId, const std::vector<int> &targetIds) const;
+
+    /**
+     * @brief Computes the shortest path distances between every source and every target.
+     *
+     * Time complexity: O((S + T) * S' * log(S') / threads + B) being S and T the numbers of sources and targets, S' the
+     * size of an upward search space and B the size of the buckets scanned
+     *
+     * @param sourceIds The IDs of the sources.
+     * @param targetIds The IDs of the targets.
+     * @param threads Number of threads running the searches.
+     * @return The distances, row by row: the one from source i to target j is at i * targetIds.size() + j.
+     */
+    std::vector<double> table(const std::vector<int> &sourceIds, const std::vector<int> &targetIds, int threads = 1) const;
+
+    /**
+     * @brief Finds a shortest path between two vertices, with its shortcuts unpacked into edges of the graph.
+     *
+     * Time complexity: O(S * log(S) + L * D) being L the number of edges of the path and D the degree in the hierarchy
+     *
+     * @param sourceId The ID of the source.
+     * @param targetId The ID of the target.
+     * @return The IDs of the vertices of the path, both ends included (empty if there is no path).
+     */
+    std::vector<int> path(int sourceId, int targetId) const;
+
+    /**
+     * @brief Writes the hierarchy to a binary file, through a temporary file renamed over it.
+     *
+     * Time complexity: O(V + A) being A the number of arcs
+     *
+     * @param path The path of the file.
+     * @param error Receives the reason when the file cannot be written.
+     * @return True if the file was written.
+     */
+    bool save(const std::string &path, std::string &error) const;
+
+    /**
+     * @brief Replaces the hierarchy with one read from a file written by save.
+     *
+     * Time complexity: O(V + A)
+     *
+     * @param path The path of the file.
+     * @param error Receives the reason when the file cannot be read or is not a valid hierarchy.
+     * @return True if the hierarchy was read (otherwise it is left unchanged).
+     */
+    bool load(const std::string &path, std::string &error);
+
+private:
+    /**
+     * @struct Arcs
+     * @brief Arcs of the hierarchy in CSR form, by rank: the arcs of vertex r are start[r] to start[r + 1] - 1.
+     */
+    struct Arcs
+    {
+        std::vector<int> start;
+        std::vector<int> target;    /**< Rank of the other end, always higher. */
+        std::vector<int> middle;    /**< Rank of the vertex a shortcut skips (-1 for an edge of the graph). */
+        std::vector<double> weight;
+    };
+
+    /**
+     * @struct Search
+     * @brief Buffers of one upward search, reused between queries; only the vertices it reached are cleared.
+     */
+    struct Search
+    {
+        IndexedHeap<4> queue;
+        std::vector<double> dist;
+        std::vector<int> parent;    /**< Rank the search reached every vertex from (-1 for the start). */
+        std::vector<int> arc;       /**< Arc it was reached by. */
+        std::vector<int> touched;
+
+        void prepare(int n);
+        void start(int rank);
+    };
+
+    uint64_t fingerprint = 0;
+    std::vector<int> ids;                   /**< ID of the vertex of every rank. */
+    std::unordered_map<int, int> rankOf;    /**< Rank of every vertex ID. */
+    Arcs forward;                           /**< Arcs from every vertex to higher ones. */
+    Arcs backward;                          /**< Arcs into every vertex from higher ones. */
+    size_t shortcuts = 0;
+
+    int findRank(int id) const;
+    static void relax(const Arcs &arcs, int u, Search &search);
+    void upward(const Arcs &arcs, Search &search) const;
+    double meet(int source, int target, Search &up, Search &down, int &top) const;
+    void unpack(int from, int to, int middle, std::vector<int> &ranks) const;
+};
+
+#endif // DAPROJECT2_CONTRACTIONHIERARCHY_H
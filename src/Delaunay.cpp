@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include "Delaunay.h"
+
+namespace
+{
+    /*
+     * Position of a point of a 2^16 x 2^16 grid along the Hilbert curve.
+     */
+    uint64_t hilbertIndex(uint32_t x, uint32_t y)
+    {
+        uint64_t index = 0;
+        for (uint32_t s = 1u << 15; s > 0; s >>= 1)
+        {
+            uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+            index += (uint64_t)s * s * ((3 * rx) ^ ry);
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = s - 1 - x;
+                    y = s - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        return index;
+    }
+
+    /*
+     * Triangulation stored as triangles with counter-clockwise vertices. next[t][i] is the triangle on the other side
+     * of the edge opposite vertex i of triangle t (-1 on the outer boundary).
+     */
+    class Triangulation
+    {
+    public:
+        Triangulation(const std::vector<double> &x, const std::vector<double> &y) : x(x), y(y) {}
+
+        /*
+         * Creates the first triangle, whose vertices must be in counter-clockwise order.
+         */
+        void start(int a, int b, int c)
+        {
+            vertices.push_back({a, b, c});
+            next.push_back({-1, -1, -1});
+        }
+
+        void insert(int p)
+        {
+            int t = locate(p);
+            int side = -1;
+            for (int i = 0; i < 3; i++)
+                if (orientation(vertices[t][(i + 1) % 3], vertices[t][(i + 2) % 3], p) == 0)
+                    side = i;
+            if (side == -1 || next[t][side] == -1)
+                splitTriangle(t, p);
+            else
+                splitEdge(t, side, p);
+
+            while (!pending.empty())
+            {
+                int s = pending.back();
+                pending.pop_back();
+                legalize(s, p);
+            }
+        }
+
+        std::vector<std::pair<int, int>> edges(int count) const
+        {
+            std::vector<std::pair<int, int>> result;
+            for (auto &t : vertices)
+                for (int i = 0; i < 3; i++)
+                {
+                    int a = t[i], b = t[(i + 1) % 3];
+                    // every inner edge is in two triangles, in opposite directions
+                    if (a < b && b < count)
+                        result.emplace_back(a, b);
+                }
+            return result;
+        }
+
+    private:
+        const std::vector<double> &x;
+        const std::vector<double> &y;
+        std::vector<std::array<int, 3>> vertices;
+        std::vector<std::array<int, 3>> next;
+        std::vector<int> pending; /**< Triangles whose edge opposite the new point must be checked. */
+        int last = 0;             /**< Triangle where the next walk starts. */
+
+        double orientation(int a, int b, int c) const
+        {
+            return (x[b] - x[a]) * (y[c] - y[a]) - (y[b] - y[a]) * (x[c] - x[a]);
+        }
+
+        /*
+         * Positive if d is inside the circle through a, b and c (in counter-clockwise order).
+         */
+        bool inCircle(int a, int b, int c, int d) const
+        {
+            long double adx = x[a] - x[d], ady = y[a] - y[d];
+            long double bdx = x[b] - x[d], bdy = y[b] - y[d];
+            long double cdx = x[c] - x[d], cdy = y[c] - y[d];
+            long double det = (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) +
+                              (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy) +
+                              (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+            return det > 0;
+        }
+
+        /*
+         * Walks from the last triangle towards p, crossing an edge that has p on its outer side. If rounding makes the
+         * walk too long, every triangle is checked instead.
+         */
+        int locate(int p)
+        {
+            int t = last;
+            for (size_t steps = 0; steps <= vertices.size(); steps++)
+            {
+                int crossed = -1;
+                for (int k = 0; k < 3 && crossed == -1; k++)
+                {
+                    int i = (k + (int)steps) % 3;
+                    if (next[t][i] != -1 && orientation(vertices[t][(i + 1) % 3], vertices[t][(i + 2) % 3], p) < 0)
+                        crossed = i;
+                }
+                if (crossed == -1)
+                    return t;
+                t = next[t][crossed];
+            }
+            for (int s = 0; s < (int)vertices.size(); s++)
+            {
+                auto &v = vertices[s];
+                if (orientation(v[0], v[1], p) >= 0 && orientation(v[1], v[2], p) >= 0 && orientation(v[2], v[0], p) >= 0)
+                    return s;
+            }
+            return t;
+        }
+
+        void set(int t, int a, int b, int c, int na, int nb, int nc)
+        {
+            if (t == (int)vertices.size())
+            {
+                vertices.push_back({a, b, c});
+                next.push_back({na, nb, nc});
+            }
+            else
+            {
+                vertices[t] = {a, b, c};
+                next[t] = {na, nb, nc};
+            }
+        }
+
+        /*
+         * Makes triangle t, which was a neighbour of before, a neighbour of after.
+         */
+        void relink(int t, int before, int after)
+        {
+            if (t == -1)
+                return;
+            for (int i = 0; i < 3; i++)
+                if (next[t][i] == before)
+                    next[t][i] = after;
+        }
+
+        void splitTriangle(int t, int p)
+        {
+            auto [a, b, c] = vertices[t];
+            auto [na, nb, nc] = next[t];
+            int t1 = (int)vertices.size(), t2 = t1 + 1;
+            set(t, a, b, p, t1, t2, nc);
+            set(t1, b, c, p, t2, t, na);
+            set(t2, c, a, p, t, t1, nb);
+            relink(na, t, t1);
+            relink(nb, t, t2);
+            pending.insert(pending.end(), {t, t1, t2});
+            last = t;
+        }
+
+        /*
+         * Splits triangle t and its neighbour across the edge opposite vertex side, on which p lies, into four.
+         */
+        void splitEdge(int t, int side, int p)
+        {
+            int a = vertices[t][side], b = vertices[t][(side + 1) % 3], c = vertices[t][(side + 2) % 3];
+            int nb = next[t][(side + 1) % 3], nc = next[t][(side + 2) % 3];
+            int u = next[t][side], j = 0;
+            while (next[u][j] != t)
+                j++;
+            int d = vertices[u][j];
+            int uc = next[u][(j + 1) % 3], ub = next[u][(j + 2) % 3]; // u is (d, c, b)
+
+            int t2 = (int)vertices.size(), t3 = t2 + 1;
+            set(t, a, b, p, t3, u, nc);
+            set(u, a, p, c, t2, nb, t);
+            set(t2, d, c, p, u, t3, ub);
+            set(t3, d, p, b, t, uc, t2);
+            relink(nb, t, u);
+            relink(ub, u, t2);
+            relink(uc, u, t3);
+            pending.insert(pending.end(), {t, u, t2, t3});
+            last = t;
+        }
+
+        /*
+         * Flips the edge of triangle t opposite p if the point across it is inside the circumcircle of t.
+         */
+        void legalize(int t, int p)
+        {
+            int i = 0;
+            while (vertices[t][i] != p)
+                i++;
+            int u = next[t][i];
+            if (u == -1)
+                return;
+            int b = vertices[t][(i + 1) % 3], c = vertices[t][(i + 2) % 3];
+            int j = 0;
+            while (next[u][j] != t)
+                j++;
+            int d = vertices[u][j];
+            if (!inCircle(p, b, c, d))
+                return;
+
+            int tb = next[t][(i + 1) % 3], tc = next[t][(i + 2) % 3];
+            int uc = next[u][(j + 1) % 3], ub = next[u][(j + 2) % 3]; // u is (d, c, b)
+            set(t, p, b, d, uc, u, tc);
+            set(u, p, d, c, ub, tb, t);
+            relink(uc, u, t);
+            relink(tb, t, u);
+            pending.push_back(t);
+            pending.push_back(u);
+        }
+    };
+}
+
+std::vector<std::pair<int, int>> delaunayEdges(const std::vector<double> &x, const std::vector<double> &y)
+{
+    int n = (int)x.size();
+    std::vector<std::pair<int, int>> result;
+    if (n < 2)
+        return result;
+
+    // equal points: the first one is triangulated, the others are joined to it
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return x[a] < x[b] || (x[a] == x[b] && y[a] < y[b]); });
+    std::vector<int> unique;
+    for (int a = 0; a < n; a++)
+    {
+        if (a > 0 && x[order[a]] == x[order[a - 1]] && y[order[a]] == y[order[a - 1]])
+            result.emplace_back(std::min(unique.back(), order[a]), std::max(unique.back(), order[a]));
+        else
+            unique.push_back(order[a]);
+    }
+
+    // the points are scaled to the unit square, and the enclosing triangle added after them
+    double minX = *std::min_element(x.begin(), x.end()), maxX = *std::max_element(x.begin(), x.end());
+    double minY = *std::min_element(y.begin(), y.end()), maxY = *std::max_element(y.begin(), y.end());
+    double scale = std::max({maxX - minX, maxY - minY, 1e-300});
+    std::vector<double> px(n + 3), py(n + 3);
+    for (int i = 0; i < n; i++)
+    {
+        px[i] = (x[i] - minX) / scale;
+        py[i] = (y[i] - minY) / scale;
+    }
+    const double far = 1e4;
+    px[n] = 0.5 - 2 * far, py[n] = 0.5 - far;
+    px[n + 1] = 0.5 + 2 * far, py[n + 1] = 0.5 - far;
+    px[n + 2] = 0.5, py[n + 2] = 0.5 + 2 * far;
+
+    std::vector<uint64_t> curve(n);
+    for (int i : unique)
+        curve[i] = hilbertIndex((uint32_t)(px[i] * 65535), (uint32_t)(py[i] * 65535));
+    std::sort(unique.begin(), unique.end(), [&](int a, int b) { return curve[a] < curve[b]; });
+
+    Triangulation triangulation(px, py);
+    triangulation.start(n, n + 1, n + 2);
+    for (int i : unique)
+        triangulation.insert(i);
+    auto edges = triangulation.edges(n);
+    result.insert(result.end(), edges.begin(), edges.end());
+    return result;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file Delaunay.h
+ * @brief This file contains the Delaunay triangulation of points in the plane, used as a sparse candidate graph.
+ */
+
+#ifndef DAPROJECT2_DELAUNAY_H
+#define DAPROJECT2_DELAUNAY_H
+
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Computes the edges of the Delaunay triangulation of a set of points.
+ *
+ * The Euclidean minimum spanning tree is a subgraph of the Delaunay triangulation, which has at most 3 * V edges, so a
+ * spanning tree computed over these edges is the minimum one without measuring every pair of points.
+ *
+ * The points are inserted one by one (Lawson's algorithm) in the order of a Hilbert curve, so the walk that locates
+ * every new point in the current triangulation is short, inside a large triangle that contains all of them. Edges that
+ * are not locally Delaunay are flipped after every insertion. Equal points are inserted once; the others get an edge to
+ * it. Because the enclosing triangle is finite, a few edges of the convex hull can be missing, but the edges returned
+ * always connect all the points.
+ *
+ * Time complexity: O(V * log(V)) expected
+ *
+ * @param x First coordinate of every point.
+ * @param y Second coordinate of every point.
+ * @return The edges, as pairs of point indexes (the smaller index first).
+ */
+std::vector<std::pair<int, int>> delaunayEdges(const std::vector<double> &x, const std::vector<double> &y);
+
+#endif // DAPROJECT2_DELAUNAY_H
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <limits>
+#include "DynamicTour.h"
+
+DynamicTour::DynamicTour(Graph &graph, const std::vector<Vertex *> &path)
+    : graph(graph), tour(path)
+{
+    refresh();
+    updatePositions(0);
+}
+
+void DynamicTour::refresh()
+{
+    int n = (int)tour.size();
+    this->cost = 0;
+    for (int i = 0; i < n; i++)
+        this->cost += distance(tour[i], tour[(i + 1) % n]);
+}
+
+int DynamicTour::size() const
+{
+    return (int)this->tour.size();
+}
+
+double DynamicTour::getCost() const
+{
+    return this->cost;
+}
+
+bool DynamicTour::contains(int id) const
+{
+    return this->position.find(id) != this->position.end();
+}
+
+const std::vector<Vertex *> &DynamicTour::getPath() const
+{
+    return this->tour;
+}
+
+double DynamicTour::distance(Vertex *a, Vertex *b)
+{
+    if (a == b)
+        return 0;
+    double d = graph.getDistance(a, b);
+    return d < 0 ? INF : d;
+}
+
+void DynamicTour::updatePositions(int first)
+{
+    for (int i = first; i < (int)tour.size(); i++)
+        position[tour[i]->getId()] = i;
+}
+
+bool DynamicTour::isTourEdge(int a, int b) const
+{
+    auto pa = position.find(a), pb = position.find(b);
+    if (pa == position.end() || pb == position.end())
+        return false;
+    int n = (int)tour.size();
+    int gap = (pa->second - pb->second + n) % n;
+    return gap == 1 || gap == n - 1;
+}
+
+void DynamicTour::reverse(int first, int last)
+{
+    std::reverse(tour.begin() + first, tour.begin() + last + 1);
+    for (int i = first; i <= last; i++)
+        position[tour[i]->getId()] = i;
+}
+
+void DynamicTour::connect(int a, int b)
+{
+    int n = (int)tour.size();
+    if (n < 4 || isTourEdge(a, b))
+        return;
+    int p = std::min(position[a], position[b]), q = std::max(position[a], position[b]);
+    Vertex *vp = tour[p], *vq = tour[q];
+
+    // replacing the edges after p and after q, or the edges before p and before q, makes p-q a tour edge
+    double after = distance(vp, vq) + distance(tour[p + 1], tour[(q + 1) % n]) - distance(vp, tour[p + 1]) - distance(vq, tour[(q + 1) % n]);
+    double before = distance(vp, vq) + distance(tour[(p + n - 1) % n], tour[q - 1]) - distance(tour[(p + n - 1) % n], vp) - distance(tour[q - 1], vq);
+    if (std::min(after, before) >= -1e-9)
+        return;
+    if (after <= before)
+        reverse(p + 1, q);
+    else
+        reverse(p, q - 1);
+    cost += std::min(after, before);
+}
+
+void DynamicTour::repair(int center)
+{
+    int n = (int)tour.size();
+    if (n < 5)
+        return;
+
+    // copy the window as an open path; its two end vertexes stay in place, so the edges leaving it do not change
+    int length = std::min(n, 2 * WINDOW + 2);
+    int first = ((center - length / 2) % n + n) % n;
+    std::vector<Vertex *> window(length);
+    for (int x = 0; x < length; x++)
+        window[x] = tour[(first + x) % n];
+
+    bool improved = true;
+    while (improved)
+    {
+        improved = false;
+        for (int i = 0; i + 3 < length; i++)
+        {
+            for (int j = i + 2; j + 1 < length; j++)
+            {
+                double delta = distance(window[i], window[j]) + distance(window[i + 1], window[j + 1])
+                             - distance(window[i], window[i + 1]) - distance(window[j], window[j + 1]);
+                if (delta < -1e-9)
+                {
+                    std::reverse(window.begin() + i + 1, window.begin() + j + 1);
+                    cost += delta;
+                    improved = true;
+                }
+            }
+        }
+    }
+
+    for (int x = 0; x < length; x++)
+    {
+        int p = (first + x) % n;
+        tour[p] = window[x];
+        position[window[x]->getId()] = p;
+    }
+}
+
+bool DynamicTour::insertVertex(Vertex *vertex)
+{
+    if (vertex == nullptr || contains(vertex->getId()))
+        return false;
+
+    int n = (int)tour.size();
+    int best = n - 1;
+    double bestDelta = 0;
+    if (n > 0)
+    {
+        bestDelta = std::numeric_limits<double>::max();
+        for (int i = 0; i < n; i++)
+        {
+            Vertex *a = tour[i], *b = tour[(i + 1) % n];
+            double delta = distance(a, vertex) + distance(vertex, b) - distance(a, b);
+            if (delta < bestDelta)
+            {
+                bestDelta = delta;
+                best = i;
+            }
+        }
+    }
+
+    tour.insert(tour.begin() + best + 1, vertex);
+    cost += bestDelta;
+    updatePositions(best + 1);
+    repair(best + 1);
+    return true;
+}
+
+int DynamicTour::updateWeights(const std::vector<EdgeWeightUpdate> &updates)
+{
+    if (graph.getDistanceOracle() != nullptr)
+    {
+        // the shortest paths of the oracle go stale with the new weights
+        graph.setDistanceOracle(nullptr);
+        refresh();
+    }
+
+    int applied = 0;
+    std::vector<int> seeds;
+    for (const auto &u : updates)
+    {
+        Vertex *a = graph.findVertex(u.orig), *b = graph.findVertex(u.dest);
+        if (a == nullptr || b == nullptr || a == b)
+            continue;
+        bool inTour = isTourEdge(u.orig, u.dest);
+        double old = inTour ? distance(a, b) : 0;
+        graph.updateEdgeWeight(u.orig, u.dest, u.weight);
+        if (inTour)
+            cost += distance(a, b) - old;
+        if (contains(u.orig) && contains(u.dest))
+        {
+            seeds.push_back(u.orig);
+            seeds.push_back(u.dest);
+        }
+        applied++;
+    }
+
+    // only once every weight is set, so that the moves see the new distances
+    for (size_t s = 0; s < seeds.size(); s += 2)
+        connect(seeds[s], seeds[s + 1]);
+    for (int id : seeds)
+        repair(position[id]);
+    return applied;
+}
+
+bool DynamicTour::removeVertex(int id)
+{
+    auto it = position.find(id);
+    if (it == position.end())
+        return false;
+
+    int p = it->second, n = (int)tour.size();
+    Vertex *prev = tour[(p + n - 1) % n], *next = tour[(p + 1) % n];
+    cost -= distance(prev, tour[p]) + distance(tour[p], next) - distance(prev, next);
+    position.erase(it);
+    tour.erase(tour.begin() + p);
+    updatePositions(p);
+    if (!tour.empty())
+        repair(p % (int)tour.size());
+    return true;
+}
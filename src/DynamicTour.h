@@ -0,0 +1,145 @@
+/**
+ * @file DynamicTour.h
+ * @brief This file contains a solved tour that is kept up to date while vertexes are inserted and removed.
+ */
+
+#ifndef DAPROJECT2_DYNAMICTOUR_H
+#define DAPROJECT2_DYNAMICTOUR_H
+
+#include <unordered_map>
+#include <vector>
+#include "Graph.h"
+
+/**
+ * @struct EdgeWeightUpdate
+ * @brief A new weight for the bidirectional edge between two vertexes.
+ */
+struct EdgeWeightUpdate
+{
+    int orig;      /**< ID of one end of the edge. */
+    int dest;      /**< ID of the other end of the edge. */
+    double weight; /**< The new weight. */
+};
+
+/**
+ * @class DynamicTour
+ * @brief A solved tour over the vertexes of a graph that supports inserting and removing single vertexes.
+ *
+ * An inserted vertex goes to the position where it increases the cost the least and a removed vertex is spliced out.
+ * Afterwards only a window of WINDOW positions on each side of the change is re-optimized with 2-opt; the vertexes
+ * outside the window keep their order. An update costs O(V) instead of a full re-solve.
+ * Edge weights can also change: only the tour positions touching a changed edge are re-optimized.
+ * Distances come from Graph::getDistance, so a new vertex must have its edges (or, in a real-world graph, its
+ * coordinates) in the graph before it is inserted, and a vertex must be removed from the tour before it is removed from the graph.
+ */
+class DynamicTour
+{
+public:
+    static const int WINDOW = 10; /**< Positions on each side of a change that are re-optimized. */
+
+    /**
+     * @brief Keeps a solved tour.
+     *
+     * Time complexity: O(V)
+     *
+     * @param graph The graph the vertexes belong to.
+     * @param path The tour (without the return to the first vertex).
+     */
+    DynamicTour(Graph &graph, const std::vector<Vertex *> &path);
+
+    /**
+     * @brief Returns the number of vertexes in the tour.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of vertexes.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns the total distance of the tour.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The total distance.
+     */
+    double getCost() const;
+
+    /**
+     * @brief Checks whether a vertex is in the tour.
+     *
+     * Time complexity: O(1)
+     *
+     * @param id The ID of the vertex.
+     * @return True if the vertex is in the tour.
+     */
+    bool contains(int id) const;
+
+    /**
+     * @brief Returns the tour.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The vertexes in tour order (without the return to the first vertex).
+     */
+    const std::vector<Vertex *> &getPath() const;
+
+    /**
+     * @brief Computes the cost of the tour again from the graph, after its distances changed outside the tour (for
+     * example when its distance oracle was dropped).
+     *
+     * Time complexity: O(V)
+     */
+    void refresh();
+
+    /**
+     * @brief Inserts a vertex at its cheapest position and re-optimizes the window around it.
+     *
+     * Time complexity: O(V + P * WINDOW^2) being P the number of 2-opt passes over the window
+     *
+     * @param vertex The vertex to insert.
+     * @return True if it was inserted, false if it is null or already in the tour.
+     */
+    bool insertVertex(Vertex *vertex);
+
+    /**
+     * @brief Splices a vertex out of the tour and re-optimizes the window around the gap.
+     *
+     * Time complexity: O(V + P * WINDOW^2) being P the number of 2-opt passes over the window
+     *
+     * @param id The ID of the vertex to remove.
+     * @return True if it was removed, false if it is not in the tour.
+     */
+    bool removeVertex(int id);
+
+    /**
+     * @brief Changes a batch of edge weights in the graph and re-optimizes the tour around the changed edges.
+     *
+     * The distance oracle of the graph, if any, holds the shortest paths of the old weights, so it is dropped first and
+     * the cost is computed again without it; the moves then only see the new weights.
+     * The cost is corrected for the changed edges that are in the tour. Then, for every changed edge, the better of the
+     * two 2-opt moves that make it a tour edge is applied if it improves the tour, and the windows around both of its
+     * ends are re-optimized. The rest of the tour is not looked at.
+     *
+     * Time complexity: O(V + U * (V + P * WINDOW^2)) being U the number of updates and P the number of 2-opt passes over a window
+     *
+     * @param updates The new edge weights.
+     * @return The number of updates applied (updates naming a vertex that does not exist are skipped).
+     */
+    int updateWeights(const std::vector<EdgeWeightUpdate> &updates);
+
+private:
+    Graph &graph;
+    std::vector<Vertex *> tour;
+    std::unordered_map<int, int> position; /**< Position of every vertex ID in the tour. */
+    double cost = 0;
+
+    double distance(Vertex *a, Vertex *b);
+    void updatePositions(int first);
+    bool isTourEdge(int a, int b) const;
+    void reverse(int first, int last);
+    void connect(int a, int b);
+    void repair(int center);
+};
+
+#endif // DAPROJECT2_DYNAMICTOUR_H
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <thread>
+#include "GeneticAlgorithm.h"
+
+GeneticAlgorithm::GeneticAlgorithm(const TSPInstance &instance, const GeneticParameters &params)
+    : instance(instance), params(params)
+{
+    this->params.islands = std::max(1, params.islands);
+    this->params.populationSize = std::max(2, params.populationSize);
+    this->params.migrationInterval = std::max(1, params.migrationInterval);
+    this->neighbours = instance.nearestNeighbours(params.neighbours);
+    this->k = std::min(params.neighbours, instance.size() - 1);
+}
+
+int GeneticAlgorithm::getGenerations() const
+{
+    return this->generations;
+}
+
+void GeneticAlgorithm::initIsland(Island &island, const std::vector<int> &seedTour, bool keepSeed)
+{
+    int p = params.populationSize;
+    int n = (int)seedTour.size();
+    island.population.assign(p, seedTour);
+    island.offspring.assign(p, std::vector<int>(n));
+    island.cost.assign(p, 0);
+    island.offspringCost.assign(p, 0);
+    island.used.assign(instance.size(), 0);
+
+    for (int i = 0; i < p; i++)
+    {
+        if (i > 0 || !keepSeed)
+        {
+            doubleBridge(island.population[i], island.rng);
+            doubleBridge(island.population[i], island.rng);
+        }
+        twoOptNeighbours(instance, island.population[i], neighbours, k, island.workspace);
+        island.cost[i] = instance.tourCost(island.population[i]);
+    }
+}
+
+int GeneticAlgorithm::tournament(Island &island)
+{
+    std::uniform_int_distribution<int> pick(0, params.populationSize - 1);
+    int winner = pick(island.rng);
+    for (int t = 1; t < params.tournamentSize; t++)
+    {
+        int other = pick(island.rng);
+        if (island.cost[other] < island.cost[winner])
+            winner = other;
+    }
+    return winner;
+}
+
+void GeneticAlgorithm::orderCrossover(Island &island, const std::vector<int> &p1, const std::vector<int> &p2, std::vector<int> &child)
+{
+    int n = (int)p1.size();
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    int a = pick(island.rng), b = pick(island.rng);
+    if (a > b)
+        std::swap(a, b);
+
+    // keep p1[a..b] in place and fill the remaining positions with the other vertices in the order of p2
+    for (int i = a; i <= b; i++)
+    {
+        child[i] = p1[i];
+        island.used[p1[i]] = 1;
+    }
+    int out = (b + 1) % n;
+    for (int s = 0; s < n; s++)
+    {
+        int v = p2[(b + 1 + s) % n];
+        if (island.used[v])
+            continue;
+        child[out] = v;
+        out = (out + 1) % n;
+    }
+    for (int i = a; i <= b; i++)
+        island.used[p1[i]] = 0;
+}
+
+int GeneticAlgorithm::best(const Island &island) const
+{
+    return (int)(std::min_element(island.cost.begin(), island.cost.end()) - island.cost.begin());
+}
+
+int GeneticAlgorithm::worst(const Island &island) const
+{
+    return (int)(std::max_element(island.cost.begin(), island.cost.end()) - island.cost.begin());
+}
+
+std::vector<int> GeneticAlgorithm::run(const std::vector<int> &seedTour, SolverControl &control)
+{
+    int islandsCount = params.islands;
+    int p = params.populationSize;
+
+    std::vector<Island> islands(islandsCount);
+    std::vector<std::vector<int>> migrants(islandsCount, seedTour);
+    std::vector<double> migrantCost(islandsCount, 0);
+    for (int i = 0; i < islandsCount; i++)
+        islands[i].rng.seed(params.seed + 7919 * i);
+
+    this->generations = 0;
+    std::atomic<bool> stop(seedTour.size() < 8);
+    auto onGeneration = [&stop, &control]() noexcept
+    {
+        if (control.shouldStop())
+            stop = true;
+    };
+    std::barrier sync(islandsCount, onGeneration);
+
+    auto evolve = [&](int id)
+    {
+        Island &island = islands[id];
+        initIsland(island, seedTour, id == 0);
+        control.report(island.cost[best(island)], p);
+        sync.arrive_and_wait();
+
+        std::uniform_real_distribution<double> chance(0, 1);
+        int generation = 0;
+        while (!stop && generation < params.generations)
+        {
+            // elitism: the best individual survives unchanged
+            int elite = best(island);
+            island.offspring[0] = island.population[elite];
+            island.offspringCost[0] = island.cost[elite];
+
+            for (int c = 1; c < p; c++)
+            {
+                int p1 = tournament(island), p2 = tournament(island);
+                std::vector<int> &child = island.offspring[c];
+                orderCrossover(island, island.population[p1], island.population[p2], child);
+                if (chance(island.rng) < 0.1)
+                    doubleBridge(child, island.rng);
+                twoOptNeighbours(instance, child, neighbours, k, island.workspace);
+                double cost = instance.tourCost(child);
+                if (cost == island.cost[p1] || cost == island.cost[p2])
+                {
+                    // clone of a parent: mutate it to keep the population diverse
+                    doubleBridge(child, island.rng);
+                    twoOptNeighbours(instance, child, neighbours, k, island.workspace);
+                    cost = instance.tourCost(child);
+                }
+                island.offspringCost[c] = cost;
+            }
+            island.population.swap(island.offspring);
+            island.cost.swap(island.offspringCost);
+            generation++;
+            control.report(island.cost[best(island)], p - 1);
+
+            if (islandsCount > 1 && generation % params.migrationInterval == 0)
+            {
+                int b = best(island);
+                migrants[id] = island.population[b];
+                migrantCost[id] = island.cost[b];
+                sync.arrive_and_wait();
+                int from = (id + islandsCount - 1) % islandsCount;
+                int w = worst(island);
+                island.population[w] = migrants[from];
+                island.cost[w] = migrantCost[from];
+            }
+            sync.arrive_and_wait();
+        }
+        if (id == 0)
+            this->generations = generation;
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < islandsCount; i++)
+        threads.emplace_back(evolve, i);
+    evolve(0);
+    for (auto &t : threads)
+        t.join();
+
+    std::vector<int> bestTour = seedTour;
+    double bestCost = instance.tourCost(seedTour);
+    for (auto &island : islands)
+    {
+        if (island.population.empty())
+            continue;
+        int b = best(island);
+        if (island.cost[b] < bestCost)
+        {
+            bestCost = island.cost[b];
+            bestTour = island.population[b];
+        }
+    }
+    return bestTour;
+}
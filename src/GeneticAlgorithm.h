@@ -0,0 +1,99 @@
+/**
+ * @file GeneticAlgorithm.h
+ * @brief This file contains the implementation of the island-model genetic algorithm.
+ */
+
+#ifndef DAPROJECT2_GENETICALGORITHM_H
+#define DAPROJECT2_GENETICALGORITHM_H
+
+#include <random>
+#include <vector>
+#include "LocalSearch.h"
+
+/**
+ * @struct GeneticParameters
+ * @brief Parameters of the genetic algorithm.
+ */
+struct GeneticParameters
+{
+    int islands = 4;            /**< Number of islands, each one evolved by its own thread. */
+    int populationSize = 24;    /**< Individuals per island. */
+    int generations = 200;      /**< Maximum number of generations. */
+    int migrationInterval = 10; /**< Generations between migrations. */
+    int tournamentSize = 3;     /**< Individuals compared in each tournament selection. */
+    int neighbours = 10;        /**< Size of the neighbour lists used by 2-opt. */
+    unsigned seed = 42;         /**< Seed of the random number generators. */
+};
+
+/**
+ * @class GeneticAlgorithm
+ * @brief Island-model genetic algorithm with order crossover (OX) and 2-opt polished offspring.
+ *
+ * Every island evolves on a separate thread and, every migrationInterval generations, sends a copy of its best
+ * individual to the next island of the ring, where it replaces the worst individual.
+ * Populations live in buffers allocated once per island, so generations do not allocate.
+ */
+class GeneticAlgorithm
+{
+public:
+    /**
+     * @brief Constructs the genetic algorithm for an instance.
+     *
+     * @param instance The instance to solve.
+     * @param params The parameters.
+     */
+    GeneticAlgorithm(const TSPInstance &instance, const GeneticParameters &params);
+
+    /**
+     * @brief Runs the genetic algorithm.
+     *
+     * Each island starts from perturbed and 2-opt polished copies of the seed tour. The islands stop after the
+     * maximum number of generations or at the first generation boundary after the control asks them to stop.
+     *
+     * Time complexity: O(G * P * (V * k + V)) being G the number of generations and P the total population
+     *
+     * @param seedTour The tour used to seed the populations (for example the triangular approximation tour).
+     * @param control Deadline, cancellation and progress reporting.
+     * @return The best tour found.
+     */
+    std::vector<int> run(const std::vector<int> &seedTour, SolverControl &control);
+
+    /**
+     * @brief Returns the number of generations run by the last call to run().
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of generations.
+     */
+    int getGenerations() const;
+
+private:
+    /**
+     * @struct Island
+     * @brief Population and scratch buffers of one island.
+     */
+    struct Island
+    {
+        std::vector<std::vector<int>> population; /**< Current individuals. */
+        std::vector<std::vector<int>> offspring;  /**< Next generation, swapped with population. */
+        std::vector<double> cost;                 /**< Cost of each current individual. */
+        std::vector<double> offspringCost;        /**< Cost of each offspring. */
+        std::vector<char> used;                   /**< Crossover scratch: whether a vertex was copied. */
+        LocalSearchWorkspace workspace;           /**< 2-opt scratch. */
+        std::mt19937 rng;                         /**< Random number generator of the island. */
+    };
+
+    const TSPInstance &instance;
+    GeneticParameters params;
+    std::vector<int> neighbours;
+    int k = 0;
+    int generations = 0;
+
+    void initIsland(Island &island, const std::vector<int> &seedTour, bool keepSeed);
+    int tournament(Island &island);
+    void orderCrossover(Island &island, const std::vector<int> &p1, const std::vector<int> &p2, std::vector<int> &child);
+    int best(const Island &island) const;
+    int worst(const Island &island) const;
+};
+
+#endif // DAPROJECT2_GENETICALGORITHM_H
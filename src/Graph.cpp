@@ -1,5 +1,13 @@
 // By: Gonçalo Leão
 
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#include "ContractionHierarchy.h"
+#include "Delaunay.h"
 #include "Graph.h"
 
 double haversine(double lat1, double lon1, double lat2, double lon2)
@@ -17,19 +25,108 @@ double haversine(double lat1, double lon1, double lat2, double lon2)
     return 6371000 * c;
 }
 
+/*
+ * Converts a TSPLIB GEO coordinate (DDD.MM, degrees and minutes) to radians, with the constants of the TSPLIB specification.
+ */
+static double geoRadians(double coordinate)
+{
+    double degrees = (int)coordinate;
+    double minutes = coordinate - degrees;
+    return 3.141592 * (degrees + 5.0 * minutes / 3.0) / 180.0;
+}
+
+double coordinateDistance(Metric metric, double lat1, double lon1, double lat2, double lon2)
+{
+    switch (metric)
+    {
+    case Metric::Euclidean:
+        return (int)(sqrt((lat1 - lat2) * (lat1 - lat2) + (lon1 - lon2) * (lon1 - lon2)) + 0.5);
+    case Metric::Att:
+    {
+        double r = sqrt(((lat1 - lat2) * (lat1 - lat2) + (lon1 - lon2) * (lon1 - lon2)) / 10.0);
+        double t = (int)(r + 0.5);
+        return t < r ? t + 1 : t;
+    }
+    case Metric::Geo:
+    {
+        double q1 = cos(geoRadians(lon1) - geoRadians(lon2));
+        double q2 = cos(geoRadians(lat1) - geoRadians(lat2));
+        double q3 = cos(geoRadians(lat1) + geoRadians(lat2));
+        return (int)(6378.388 * acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+    }
+    default:
+        return haversine(lat1, lon1, lat2, lon2);
+    }
+}
+
+void projectCoordinates(Metric metric, double lat, double lon, double refLat, double &x, double &y)
+{
+    switch (metric)
+    {
+    case Metric::Euclidean:
+    case Metric::Att:
+        x = lat;
+        y = lon;
+        break;
+    case Metric::Geo:
+        x = 6378.388 * geoRadians(lon) * cos(geoRadians(refLat));
+        y = 6378.388 * geoRadians(lat);
+        break;
+    default:
+        // same conversions as haversine(), which converts the latitude difference to radians twice
+        x = 6371000 * (lon * M_PI / 180.0) * cos(refLat * M_PI / 180.0);
+        y = 6371000 * (lat * M_PI / 180.0) * (M_PI / 180.0);
+        break;
+    }
+}
+
 int Graph::getNumVertex() const
 {
     return vertexMap.size();
 }
 
-std::unordered_map<int, Vertex *> Graph::getVertexMap() const
+const std::unordered_map<int, Vertex *> &Graph::getVertexMap() const
 {
     return this->vertexMap;
 }
 
+const std::vector<Vertex *> &Graph::getVertices() const
+{
+    return this->vertices;
+}
+
+Graph::~Graph()
+{
+    this->resetGraph();
+}
+
 void Graph::resetGraph()
 {
-    this->vertexMap.erase(this->vertexMap.begin(), this->vertexMap.end());
+    // every vertex owns its outgoing edges
+    for (Vertex *v : this->vertices)
+    {
+        v->removeOutgoingEdges();
+        delete v;
+    }
+    this->vertexMap.clear();
+    this->vertices.clear();
+    this->oracle.reset();
+    this->tablePosition.clear();
+    this->table.clear();
+    this->tableSize = 0;
+}
+
+size_t Graph::memoryUsage() const
+{
+    // a hash table node holds the next pointer and the key-value pair (and, in libstdc++, no cached hash for ints)
+    const size_t node = sizeof(void *) + sizeof(std::pair<const int, void *>);
+    size_t bytes = sizeof(Graph) + this->vertices.capacity() * sizeof(Vertex *) +
+                   this->vertexMap.bucket_count() * sizeof(void *) + this->vertexMap.size() * node;
+    for (const Vertex *v : this->vertices)
+        bytes += sizeof(Vertex) + v->getAdj().bucket_count() * sizeof(void *) + v->getAdj().size() * (node + sizeof(Edge));
+    bytes += this->table.capacity() * sizeof(double) + this->tablePosition.bucket_count() * sizeof(void *) +
+             this->tablePosition.size() * (sizeof(void *) + sizeof(std::pair<const int, int>));
+    return bytes;
 }
 
 
@@ -48,7 +145,34 @@ bool Graph::addVertex(const int &id)
     {
         return false;
     }
-    vertexMap[id] = new Vertex(id);
+    Vertex *v = new Vertex(id);
+    v->index = (int)vertices.size();
+    vertexMap[id] = v;
+    vertices.push_back(v);
+    return true;
+}
+
+bool Graph::removeVertex(const int &id)
+{
+    Vertex *v = findVertex(id);
+    if (v == nullptr)
+        return false;
+    for (auto a : vertexMap)
+    {
+        Edge *e = a.second->findEdge(v);
+        if (e != nullptr)
+        {
+            a.second->removeEdge(id);
+            delete e;
+        }
+    }
+    v->removeOutgoingEdges();
+    vertexMap.erase(id);
+    tablePosition.erase(id);
+    vertices[v->index] = vertices.back();
+    vertices[v->index]->index = v->index;
+    vertices.pop_back();
+    delete v;
     return true;
 }
 
@@ -75,20 +199,148 @@ bool Graph::addBidirectionalEdge(const int &sourc, const int &dest, double w)
     return true;
 }
 
-double Graph::getDistance(Vertex *v1, Vertex *v2)
+bool Graph::updateEdgeWeight(const int &sourc, const int &dest, double w)
+{
+    auto v1 = findVertex(sourc);
+    auto v2 = findVertex(dest);
+    if (v1 == nullptr || v2 == nullptr)
+        return false;
+    Edge *e = v1->findEdge(v2);
+    if (e == nullptr)
+        return addBidirectionalEdge(sourc, dest, w);
+    e->setWeight(w);
+    if (e->getReverse() != nullptr)
+        e->getReverse()->setWeight(w);
+    return true;
+}
+
+double Graph::getDistance(const Vertex *v1, const Vertex *v2) const
 {
-    double d = v1->getDistTo(v2);
-    if (this->real && d == -1)
+    Edge *e = v1->findEdge(v2);
+    if (e != nullptr)
+        return e->getWeight();
+    if (!this->table.empty())
     {
-        d = haversine(v1->getLatitude(), v1->getLongitude(), v2->getLatitude(), v2->getLongitude());
-        this->addBidirectionalEdge(v1->getId(), v2->getId(), d);
+        int p = getTablePosition(v1->getId()), q = getTablePosition(v2->getId());
+        if (p != -1 && q != -1 && getTableDistance(p, q) < INF)
+            return getTableDistance(p, q);
     }
-    return d;
+    if (this->oracle != nullptr)
+    {
+        double d = this->oracle->distance(v1->getId(), v2->getId());
+        if (d < INF)
+            return d;
+    }
+    if (this->metric == Metric::None)
+        return -1;
+    return coordinateDistance(this->metric, v1->getLatitude(), v1->getLongitude(), v2->getLatitude(), v2->getLongitude());
+}
+
+void Graph::setDistanceOracle(std::shared_ptr<const ContractionHierarchy> oracle)
+{
+    this->oracle = std::move(oracle);
+}
+
+const std::shared_ptr<const ContractionHierarchy> &Graph::getDistanceOracle() const
+{
+    return this->oracle;
+}
+
+void Graph::setDistanceTable(const std::vector<int> &ids, std::vector<double> distances)
+{
+    this->tablePosition.clear();
+    for (int p = 0; p < (int)ids.size(); p++)
+        this->tablePosition[ids[p]] = p;
+    this->tableSize = (int)ids.size();
+    this->table = std::move(distances);
+}
+
+bool Graph::hasDistanceTable() const
+{
+    return !this->table.empty();
+}
+
+int Graph::getTablePosition(int id) const
+{
+    auto it = this->tablePosition.find(id);
+    return it == this->tablePosition.end() ? -1 : it->second;
+}
+
+double Graph::getTableDistance(int p, int q) const
+{
+    if (p == q)
+        return 0;
+    return p < q ? this->table[getTableIndex(this->tableSize, p, q)] : this->table[getTableIndex(this->tableSize, q, p)];
 }
 
 void Graph::setReal(bool real)
 {
-    this->real = real;
+    this->metric = real ? Metric::Haversine : Metric::None;
+}
+
+bool Graph::isReal() const
+{
+    return this->metric != Metric::None;
+}
+
+void Graph::setMetric(Metric metric)
+{
+    this->metric = metric;
+}
+
+Metric Graph::getMetric() const
+{
+    return this->metric;
+}
+
+uint64_t Graph::fingerprint() const
+{
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](const void *data, size_t size)
+    {
+        auto bytes = (const unsigned char *)data;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    std::vector<int> ids;
+    ids.reserve(vertexMap.size());
+    for (auto a : vertexMap)
+        ids.push_back(a.first);
+    std::sort(ids.begin(), ids.end());
+
+    add(&this->metric, sizeof(this->metric));
+    std::vector<std::pair<int, double>> edges;
+    for (int id : ids)
+    {
+        Vertex *v = vertexMap.at(id);
+        add(&id, sizeof(id));
+        if (this->metric != Metric::None)
+        {
+            double latitude = v->getLatitude(), longitude = v->getLongitude();
+            add(&latitude, sizeof(latitude));
+            add(&longitude, sizeof(longitude));
+        }
+        edges.clear();
+        int p = getTablePosition(id);
+        for (auto e : v->getAdj())
+            if (p == -1 || getTablePosition(e.first) == -1)
+                edges.emplace_back(e.first, e.second->getWeight());
+        if (p != -1)
+            for (auto &a : this->tablePosition)
+                if (a.second != p && getTableDistance(p, a.second) < INF)
+                    edges.emplace_back(a.first, getTableDistance(p, a.second));
+        std::sort(edges.begin(), edges.end());
+        for (auto &e : edges)
+        {
+            add(&e.first, sizeof(e.first));
+            add(&e.second, sizeof(e.second));
+        }
+    }
+    return hash;
 }
 
 void deleteMatrix(int **m, int n)
@@ -114,65 +366,386 @@ void deleteMatrix(double **m, int n)
 }
 // algoritms
 
-void Graph::prim()
+void GraphScratch::reset(int n)
 {
-    for (auto a : vertexMap)
+    parent.assign(n, -1);
+    dist.assign(n, INF);
+    visited.assign(n, 0);
+}
+
+bool Graph::coordinatesOnly() const
+{
+    size_t edges = 0;
+    for (Vertex *v : vertices)
+        edges += v->getAdj().size();
+    return this->metric != Metric::None && edges / 2 + 1 < vertices.size();
+}
+
+void Graph::prim(GraphScratch &scratch) const
+{
+    int n = (int)vertices.size();
+    scratch.reset(n);
+    Vertex *start = findVertex(0);
+    if (start == nullptr)
+        return;
+    int root = start->getIndex();
+    scratch.dist[root] = 0;
+
+    size_t edges = 0;
+    for (Vertex *v : vertices)
+        edges += v->getAdj().size();
+    if (coordinatesOnly())
+        coordinatePrim(root, scratch);
+    else if (n > 1 && edges * 2 >= (size_t)n * (n - 1))
+        densePrim(root, scratch);
+    else
+        heapPrim(root, scratch);
+}
+
+void Graph::densePrim(int root, GraphScratch &scratch) const
+{
+    int n = (int)vertices.size();
+    std::vector<int> &remaining = scratch.remaining, &slot = scratch.slot;
+    std::vector<double> &key = scratch.key;
+    remaining.resize(n);
+    slot.resize(n);
+    key.resize(n);
+    for (int i = 0; i < n; i++)
     {
-        a.second->setVisited(false);
-        a.second->setDist(INF);
-        a.second->setPath(nullptr);
+        remaining[i] = slot[i] = i;
+        key[i] = scratch.dist[i];
     }
+    // the scan starts from the root, like heapPrim, whatever the keys the caller left in scratch.dist
+    key[root] = scratch.dist[root] = 0;
 
-    Vertex *start = findVertex(0);
-    start->setDist(0);
+    while (!remaining.empty())
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < key.size(); i++)
+            if (key[i] < key[best] || (key[i] == key[best] && remaining[i] < remaining[best]))
+                best = i;
+        if (key[best] == INF)
+            break;
+
+        int v = remaining[best];
+        remaining[best] = remaining.back();
+        key[best] = key.back();
+        slot[remaining[best]] = (int)best;
+        remaining.pop_back();
+        key.pop_back();
 
-    MutablePriorityQueue<Vertex> queue;
-    queue.insert(start);
+        scratch.visited[v] = 1;
+        for (auto &e : vertices[v]->getAdj())
+        {
+            int w = e.second->getDest()->getIndex();
+            if (!scratch.visited[w] && e.second->getWeight() < key[slot[w]])
+            {
+                key[slot[w]] = e.second->getWeight();
+                scratch.dist[w] = e.second->getWeight();
+                scratch.parent[w] = v;
+            }
+        }
+    }
+}
+
+void Graph::heapPrim(int root, GraphScratch &scratch) const
+{
+    IndexedHeap<4> &queue = scratch.queue;
+    queue.reset((int)vertices.size());
+    queue.push(root, 0);
 
     while (!queue.empty())
     {
-        Vertex *v = queue.extractMin();
-        v->setVisited(true);
-        for (auto e : v->getAdj())
+        int v = queue.pop();
+        scratch.visited[v] = 1;
+        for (auto &e : vertices[v]->getAdj())
         {
-            Vertex *w = e.second->getDest();
-            if (!w->isVisited())
+            int w = e.second->getDest()->getIndex();
+            if (!scratch.visited[w] && e.second->getWeight() < scratch.dist[w])
             {
-                double prevDist = w->getDist();
-                if (e.second->getWeight() < prevDist)
-                {
-                    w->setDist(e.second->getWeight());
-                    w->setPath(e.second);
-                    if (prevDist == INF)
-                    {
-                        queue.insert(w);
-                    }
-                    else
-                    {
-                        queue.decreaseKey(w);
-                    }
-                }
+                scratch.dist[w] = e.second->getWeight();
+                scratch.parent[w] = v;
+                queue.pushOrDecrease(w, e.second->getWeight());
             }
         }
     }
 }
 
-double Graph::dfs(Vertex *vertex, Vertex **lastVertex, std::vector<Vertex *> &path)
+void Graph::coordinatePrim(int root, GraphScratch &scratch) const
 {
-    path.push_back(vertex);
+    std::vector<Vertex *> sorted = vertices;
+    std::sort(sorted.begin(), sorted.end(), [](Vertex *a, Vertex *b) { return a->getId() < b->getId(); });
+    int n = (int)sorted.size();
 
-    double total = 0;
+    double refLat = 0;
+    for (Vertex *v : sorted)
+        refLat += v->getLatitude() / n;
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; i++)
+        projectCoordinates(this->metric, sorted[i]->getLatitude(), sorted[i]->getLongitude(), refLat, x[i], y[i]);
 
-    if (*lastVertex != nullptr)
-        total = this->getDistance(*lastVertex, vertex);
-    *lastVertex = vertex;
+    std::vector<std::tuple<double, int, int>> candidates;
+    for (auto [i, j] : delaunayEdges(x, y))
+        candidates.emplace_back(getDistance(sorted[i], sorted[j]), sorted[i]->getIndex(), sorted[j]->getIndex());
+    std::sort(candidates.begin(), candidates.end(), [&](auto &a, auto &b)
+    {
+        if (std::get<0>(a) != std::get<0>(b))
+            return std::get<0>(a) < std::get<0>(b);
+        return std::make_pair(vertices[std::get<1>(a)]->getId(), vertices[std::get<2>(a)]->getId()) <
+               std::make_pair(vertices[std::get<1>(b)]->getId(), vertices[std::get<2>(b)]->getId());
+    });
 
-    for (auto e : vertex->getAdj())
+    // Kruskal's algorithm, with a union-find with path halving
+    std::vector<int> set(n);
+    std::iota(set.begin(), set.end(), 0);
+    auto find = [&](int i)
     {
-        if (e.second->getDest()->getPath() != e.second)
+        while (set[i] != i)
+            i = set[i] = set[set[i]];
+        return i;
+    };
+    std::vector<std::vector<std::pair<int, double>>> tree(n);
+    for (auto [d, i, j] : candidates)
+    {
+        int a = find(i), b = find(j);
+        if (a == b)
             continue;
-        total += dfs(e.second->getDest(), lastVertex, path);
+        set[a] = b;
+        tree[i].emplace_back(j, d);
+        tree[j].emplace_back(i, d);
+    }
+    orientTree(tree, root, scratch);
+}
+
+void Graph::orientTree(const std::vector<std::vector<std::pair<int, double>>> &tree, int root, GraphScratch &scratch) const
+{
+    std::vector<int> &stack = scratch.stack;
+    stack.assign(1, root);
+    scratch.visited[root] = 1;
+    while (!stack.empty())
+    {
+        int i = stack.back();
+        stack.pop_back();
+        for (auto [j, d] : tree[i])
+        {
+            if (scratch.visited[j])
+                continue;
+            scratch.visited[j] = 1;
+            scratch.dist[j] = d;
+            scratch.parent[j] = i;
+            stack.push_back(j);
+        }
     }
+}
 
+void Graph::boruvka(int threads, GraphScratch &scratch) const
+{
+    int n = (int)vertices.size();
+    if (n == 0 || coordinatesOnly())
+    {
+        prim(scratch);
+        return;
+    }
+    threads = std::max(1, std::min(threads, n));
+    scratch.reset(n);
+    Vertex *start = findVertex(0);
+    if (start == nullptr)
+        return;
+    scratch.dist[start->getIndex()] = 0;
+
+    // the edges in CSR form: the arcs of vertex i are first[i] to first[i + 1] - 1
+    std::vector<size_t> first(n + 1, 0);
+    for (int i = 0; i < n; i++)
+        first[i + 1] = first[i] + vertices[i]->getAdj().size();
+    std::vector<int> target(first[n]);
+    std::vector<double> weight(first[n]);
+    // the order of the edges: by weight, then by the smaller and the larger ID of their ends
+    auto lighter = [&](int u, int v, double w, int x, int y, double z)
+    {
+        if (w != z)
+            return w < z;
+        int a = std::min(vertices[u]->getId(), vertices[v]->getId()), b = std::max(vertices[u]->getId(), vertices[v]->getId());
+        int c = std::min(vertices[x]->getId(), vertices[y]->getId()), d = std::max(vertices[x]->getId(), vertices[y]->getId());
+        return a < c || (a == c && b < d);
+    };
+
+    std::vector<std::atomic<int>> set(n);
+    for (int i = 0; i < n; i++)
+        set[i].store(i, std::memory_order_relaxed);
+    auto find = [&](int i)
+    {
+        while (true)
+        {
+            int up = set[i].load(std::memory_order_relaxed);
+            if (up == i)
+                return i;
+            int upper = set[up].load(std::memory_order_relaxed);
+            if (upper != up)
+                set[i].compare_exchange_weak(up, upper, std::memory_order_relaxed);
+            i = upper;
+        }
+    };
+    // links the root with the larger index under the other one; fails if the vertices are in the same component
+    auto unite = [&](int a, int b)
+    {
+        while (true)
+        {
+            a = find(a);
+            b = find(b);
+            if (a == b)
+                return false;
+            if (a < b)
+                std::swap(a, b);
+            int expected = a;
+            if (set[a].compare_exchange_strong(expected, b, std::memory_order_relaxed))
+                return true;
+        }
+    };
+
+    std::vector<int> component(n), vertexArc(n);
+    std::vector<std::atomic<int>> best(n);     // vertex whose cheapest arc is the cheapest of every component (-1 if none)
+    std::vector<std::pair<int, int>> chosen(n); // the tree edges, as a vertex index and its arc
+    std::atomic<int> size(0);
+    int before = 0;
+    bool merged = true;
+    // the workers live for the whole run; the steps of a round are separated by the barriers, and the last one of the
+    // round checks whether any component was joined
+    std::barrier step(threads);
+    std::barrier round(threads, [&]() noexcept
+    {
+        merged = size > before;
+        before = size;
+    });
+
+    auto work = [&](int t)
+    {
+        int begin = (int)((long long)n * t / threads), end = (int)((long long)n * (t + 1) / threads);
+        for (int i = begin; i < end; i++)
+        {
+            size_t a = first[i];
+            for (auto &e : vertices[i]->getAdj())
+            {
+                target[a] = e.second->getDest()->getIndex();
+                weight[a++] = e.second->getWeight();
+            }
+        }
+        step.arrive_and_wait();
+
+        while (merged)
+        {
+            for (int i = begin; i < end; i++)
+            {
+                component[i] = find(i);
+                best[i].store(-1, std::memory_order_relaxed);
+            }
+            step.arrive_and_wait();
+
+            for (int i = begin; i < end; i++)
+            {
+                int own = component[i], arc = -1;
+                for (size_t a = first[i]; a < first[i + 1]; a++)
+                    if (component[target[a]] != own &&
+                        (arc == -1 || lighter(i, target[a], weight[a], i, target[arc], weight[arc])))
+                        arc = (int)a;
+                vertexArc[i] = arc;
+                if (arc == -1)
+                    continue;
+                // release and acquire: the vertexArc of the vertex in best is read by the other threads
+                int current = best[own].load(std::memory_order_acquire);
+                while ((current == -1 || lighter(i, target[arc], weight[arc], current, target[vertexArc[current]],
+                                                 weight[vertexArc[current]])) &&
+                       !best[own].compare_exchange_weak(current, i, std::memory_order_acq_rel, std::memory_order_acquire))
+                    ;
+            }
+            step.arrive_and_wait();
+
+            for (int c = begin; c < end; c++)
+            {
+                int i = best[c].load(std::memory_order_relaxed);
+                if (i != -1 && unite(i, target[vertexArc[i]]))
+                    chosen[size++] = {i, vertexArc[i]};
+            }
+            round.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(work, t);
+    work(0);
+    for (auto &th : pool)
+        th.join();
+
+    // the arc is kept with the edge: vertexArc changes in the later rounds
+    std::vector<std::vector<std::pair<int, double>>> tree(n);
+    for (int e = 0; e < size; e++)
+    {
+        auto [i, arc] = chosen[e];
+        tree[i].emplace_back(target[arc], weight[arc]);
+        tree[target[arc]].emplace_back(i, weight[arc]);
+    }
+    orientTree(tree, start->getIndex(), scratch);
+}
+
+double Graph::dfs(Vertex *vertex, Vertex **lastVertex, std::vector<Vertex *> &path, GraphScratch &scratch) const
+{
+    int n = (int)vertices.size();
+    std::vector<int> &order = scratch.order, &first = scratch.first, &children = scratch.children;
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return vertices[a]->getId() < vertices[b]->getId(); });
+
+    // the children of vertex i are children[first[i]] to children[first[i + 1] - 1], by increasing ID
+    first.assign(n + 1, 0);
+    for (int i = 0; i < n; i++)
+        if (scratch.parent[i] != -1)
+            first[scratch.parent[i] + 1]++;
+    for (int i = 0; i < n; i++)
+        first[i + 1] += first[i];
+    children.resize(first[n]);
+    std::vector<int> &fill = scratch.slot;
+    fill.assign(first.begin(), first.end() - 1);
+    for (int i : order)
+        if (scratch.parent[i] != -1)
+            children[fill[scratch.parent[i]]++] = i;
+
+    size_t begin = path.size();
+    std::vector<int> &stack = scratch.stack;
+    stack.assign(1, vertex->getIndex());
+    while (!stack.empty())
+    {
+        int v = stack.back();
+        stack.pop_back();
+        path.push_back(vertices[v]);
+        for (int c = first[v + 1] - 1; c >= first[v]; c--)
+            stack.push_back(children[c]);
+    }
+
+    // the distance, in one pass over the finished path (-1 once an edge is missing)
+    double total = 0;
+    Vertex *previous = *lastVertex;
+    for (size_t i = begin; i < path.size(); i++)
+    {
+        if (previous != nullptr && total >= 0)
+        {
+            double d = getDistance(previous, path[i]);
+            total = d < 0 ? -1 : total + d;
+        }
+        previous = path[i];
+    }
+    *lastVertex = previous;
+    return total;
+}
+
+double Graph::pathCost(const std::vector<Vertex *> &path) const
+{
+    double total = 0;
+    for (size_t i = 1; i < path.size(); i++)
+    {
+        double d = getDistance(path[i - 1], path[i]);
+        if (d < 0)
+            return -1;
+        total += d;
+    }
     return total;
 }
@@ -7,25 +7,158 @@
 #define GRAPH_H
 
 #include <cmath>
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <vector>
+#include "IndexedHeap.h"
 #include "VertexEdge.h"
-#include "MutablePriorityQueue.h"
 
 #define M_PI 3.14159265358979323846
 #define INF INT32_MAX
 
+class ContractionHierarchy;
+
+/**
+ * @enum Metric
+ * @brief How the distance between two vertices without an edge is computed from their coordinates.
+ *
+ * Vertices keep their coordinates in the latitude and longitude fields; for the TSPLIB metrics these hold the
+ * first and second coordinates of the NODE_COORD_SECTION.
+ */
+enum class Metric
+{
+    None,      /**< No coordinates: only the edges give distances (the CSV edge lists and TSPLIB EXPLICIT instances). */
+    Haversine, /**< Latitude and longitude in degrees, distance given by haversine() (the real-world graphs). */
+    Euclidean, /**< TSPLIB EUC_2D: Euclidean distance rounded to the nearest integer. */
+    Att,       /**< TSPLIB ATT: pseudo-Euclidean distance. */
+    Geo        /**< TSPLIB GEO: geodesic distance in km, with coordinates in DDD.MM format. */
+};
+
+/**
+ * @struct GraphScratch
+ * @brief Per-query state of the spanning tree algorithms and of the tree traversal, in arrays indexed by the dense
+ * index of the vertices (Vertex::getIndex).
+ *
+ * These algorithms only read the graph and keep all their state here, so any number of threads can run them on the
+ * same graph at once, each with its own scratch. Every query resizes the arrays to the number of vertices without
+ * releasing their memory, so a scratch reused across queries stops allocating once it has grown to the graph size.
+ */
+struct GraphScratch
+{
+    std::vector<int> parent;    /**< Index of the parent of every vertex in the tree (-1 for the root and the vertices not reached). */
+    std::vector<double> dist;   /**< Weight of the tree edge from the parent of every vertex (INF if not reached). */
+    std::vector<char> visited;  /**< Whether every vertex is in the tree. */
+    std::vector<int> slot;      /**< Position of every vertex in the key array of the dense Prim. */
+    std::vector<int> remaining; /**< Vertices not in the tree yet, in the dense Prim. */
+    std::vector<double> key;    /**< Keys of the remaining vertices, in the dense Prim. */
+    IndexedHeap<4> queue;       /**< Priority queue of the sparse Prim. */
+    std::vector<int> order;     /**< Vertices sorted by ID, in the traversal. */
+    std::vector<int> first;     /**< Children of every vertex, in CSR form: children[first[i]] to children[first[i + 1] - 1]. */
+    std::vector<int> children;
+    std::vector<int> stack;     /**< Stack of the traversal. */
+
+    /**
+     * @brief Prepares the tree arrays for a graph with n vertices: no parent, distance INF, nothing visited.
+     *
+     * Time complexity: O(n)
+     *
+     * @param n The number of vertices.
+     */
+    void reset(int n);
+};
+
 /**
  * @class Graph
  * @brief Represents a graph data structure.
+ *
+ * Besides the map from IDs, the vertices are kept in an array, where each one is at its dense index
+ * (Vertex::getIndex). The algorithms keep their state in a GraphScratch indexed by it and do not change the graph.
  */
 class Graph
 {
 private:
     std::unordered_map<int, Vertex *> vertexMap; /**< Map of vertex IDs to Vertex pointers. */
-    bool real;                                   /**< Flag indicating whether the graph represents real-world locations. */
+    std::vector<Vertex *> vertices;              /**< The vertices, each at its dense index. */
+    Metric metric = Metric::None;                /**< How distances are computed from the vertex coordinates. */
+    std::shared_ptr<const ContractionHierarchy> oracle; /**< Shortest path distances for vertices without an edge (or null). */
+    std::unordered_map<int, int> tablePosition;  /**< Position of every vertex in the distance table. */
+    std::vector<double> table;                   /**< Distance table: upper triangle of the pairs of positions, row by row (empty if none). */
+    int tableSize = 0;                           /**< Number of positions of the distance table. */
+
+    /**
+     * @brief Prim's algorithm with a priority queue (a 4-ary IndexedHeap), for sparse graphs.
+     *
+     * Time complexity: O(E * log(V))
+     *
+     * @param root The index of the root of the tree.
+     * @param scratch The state of the query, already reset.
+     */
+    void heapPrim(int root, GraphScratch &scratch) const;
+
+    /**
+     * @brief Prim's algorithm with an array scan instead of a priority queue, for dense graphs.
+     *
+     * The keys of the vertices not in the tree yet are kept in a contiguous array that is scanned for the minimum;
+     * scratch.slot holds the position of every vertex in that array.
+     *
+     * Time complexity: O(V^2 + E)
+     *
+     * @param root The index of the root of the tree.
+     * @param scratch The state of the query, already reset.
+     */
+    void densePrim(int root, GraphScratch &scratch) const;
+
+    /**
+     * @brief Minimum spanning tree of a graph given only by coordinates, without measuring every pair of vertices.
+     *
+     * The vertices are projected onto a plane (projectCoordinates) and Kruskal's algorithm runs on the edges of the
+     * Delaunay triangulation of the projected points (delaunayEdges), which contain the Euclidean minimum spanning tree,
+     * weighted with the distances of the graph metric. The tree is then oriented from the root like the other versions;
+     * its edges are not added to the graph.
+     *
+     * Time complexity: O(V * log(V))
+     *
+     * @param root The index of the root of the tree.
+     * @param scratch The state of the query, already reset.
+     */
+    void coordinatePrim(int root, GraphScratch &scratch) const;
+
+    /**
+     * @brief Stores a spanning tree in the scratch, oriented from the root: every other vertex reached gets its parent
+     * and the weight of the edge from it, and is marked visited.
+     *
+     * Time complexity: O(V)
+     *
+     * @param tree The neighbours of every vertex in the tree (dense indexes) with the weights of the edges.
+     * @param root The index of the root.
+     * @param scratch The state of the query, already reset.
+     */
+    void orientTree(const std::vector<std::vector<std::pair<int, double>>> &tree, int root, GraphScratch &scratch) const;
+
+    /**
+     * @brief Checks whether the graph only has coordinates: a metric and too few edges to span its vertices (a nodes
+     * file without edges, or a TSPLIB coordinate instance).
+     *
+     * Time complexity: O(V)
+     *
+     * @return True if the spanning tree must be built from the coordinates.
+     */
+    bool coordinatesOnly() const;
 
 public:
+    Graph() = default;
+
+    /**
+     * @brief Destroys the graph, deleting its vertices and edges.
+     *
+     * Time complexity: O(V + E)
+     */
+    ~Graph();
+
+    Graph(const Graph &) = delete;
+    Graph &operator=(const Graph &) = delete;
+
     /**
      * @brief Gets the number of vertices in the graph.
      *
@@ -42,15 +175,35 @@ public:
      *
      * @return The vertex map.
      */
-    std::unordered_map<int, Vertex *> getVertexMap() const;
+    const std::unordered_map<int, Vertex *> &getVertexMap() const;
 
     /**
-     * @brief Resets the graph by removing all vertices.
+     * @brief Gets the vertices, each at its dense index (Vertex::getIndex).
+     *
+     * Removing a vertex moves the last vertex to its index.
      *
      * Time complexity: O(1)
+     *
+     * @return The vertices.
+     */
+    const std::vector<Vertex *> &getVertices() const;
+
+    /**
+     * @brief Resets the graph by removing and deleting all vertices and their edges.
+     *
+     * Time complexity: O(V + E)
      */
     void resetGraph();
 
+    /**
+     * @brief Estimates the memory used by the graph: its vertices, edges and the hash tables that index them.
+     *
+     * Time complexity: O(V)
+     *
+     * @return The estimate, in bytes.
+     */
+    size_t memoryUsage() const;
+
     /**
      * @brief Finds a vertex with a given ID.
      *
@@ -71,6 +224,16 @@ public:
      */
     bool addVertex(const int &id);
 
+    /**
+     * @brief Removes a vertex from the graph, together with its outgoing and incoming edges.
+     *
+     * Time complexity: O(V + E(v)) being V the number of vertexes and E(v) the number of edges of the vertex
+     *
+     * @param id The ID of the vertex to remove.
+     * @return True if the vertex was removed, false if it does not exist.
+     */
+    bool removeVertex(const int &id);
+
     /**
      * @brief Adds an edge to the graph.
      *
@@ -96,46 +259,225 @@ public:
     bool addBidirectionalEdge(const int &sourc, const int &dest, double w);
 
     /**
-     * @brief Calculates the distance between two vertices.
-     * And adds a new edge between them if there is none with the weight returned by haversine function
+     * @brief Changes the weight of a bidirectional edge in place, keeping the reverse edge in sync.
+     *
+     * If the edge does not exist it is added (in a real-world graph it then overrides the haversine distance).
      *
      * Time complexity: O(1)
      *
+     * @param sourc The ID of one end of the edge.
+     * @param dest The ID of the other end of the edge.
+     * @param w The new weight.
+     * @return True if the weight was set, false if either vertex does not exist.
+     */
+    bool updateEdgeWeight(const int &sourc, const int &dest, double w);
+
+    /**
+     * @brief Calculates the distance between two vertices: the weight of the edge between them or, if there is none,
+     * their distance in the distance table, or the shortest path distance given by the distance oracle, if the graph
+     * has them and they know one, or else the distance given by their coordinates (see coordinateDistance). The graph
+     * is not changed.
+     *
+     * Time complexity: O(1) without an oracle; the one of ContractionHierarchy::distance with it
+     *
      * @param v1 Pointer to the first vertex.
      * @param v2 Pointer to the second vertex.
-     * @return The distance between the two vertices.
+     * @return The distance between the two vertices, or -1 if no edge, table, oracle or coordinates give one.
+     */
+    double getDistance(const Vertex *v1, const Vertex *v2) const;
+
+    /**
+     * @brief Sets the distance oracle that getDistance uses for vertices without an edge between them.
+     *
+     * The oracle is not updated with the graph: it should be built from the graph as it is (see
+     * ContractionHierarchy::getFingerprint), and dropped once the graph changes.
+     *
+     * Time complexity: O(1)
+     *
+     * @param oracle The oracle, or null to use the coordinates only.
+     */
+    void setDistanceOracle(std::shared_ptr<const ContractionHierarchy> oracle);
+
+    /**
+     * @brief Returns the distance oracle of the graph.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The oracle, or null if it has none.
+     */
+    const std::shared_ptr<const ContractionHierarchy> &getDistanceOracle() const;
+
+    /**
+     * @brief Sets the distance table of the graph: the distances between vertices that may have no edge, kept apart
+     * from the adjacency (see readGraphFile, which keeps only the nearest neighbours in it). getDistance uses it for
+     * the vertices without an edge between them.
+     *
+     * Time complexity: O(n)
+     *
+     * @param ids The IDs of the vertices of the table; the vertex ids[p] is at position p.
+     * @param distances The distance between the vertices at every pair of positions p < q, at getTableIndex(p, q)
+     *                  (INF if they have none).
+     */
+    void setDistanceTable(const std::vector<int> &ids, std::vector<double> distances);
+
+    /**
+     * @brief Checks whether the graph has a distance table.
+     *
+     * Time complexity: O(1)
+     *
+     * @return True if it has one.
+     */
+    bool hasDistanceTable() const;
+
+    /**
+     * @brief Returns the position of a vertex in the distance table.
+     *
+     * Time complexity: O(1)
+     *
+     * @param id The ID of the vertex.
+     * @return The position, or -1 if the vertex is not in the table.
      */
-    double getDistance(Vertex *v1, Vertex *v2);
+    int getTablePosition(int id) const;
+
+    /**
+     * @brief Returns the distance between two positions of the distance table.
+     *
+     * Time complexity: O(1)
+     *
+     * @param p The first position.
+     * @param q The second position.
+     * @return The distance (0 if p == q, INF if the pair has none).
+     */
+    double getTableDistance(int p, int q) const;
+
+    /**
+     * @brief Returns the index of the pair of positions p < q in a distance table of n vertices.
+     *
+     * Time complexity: O(1)
+     *
+     * @param n The number of vertices of the table.
+     * @param p The first position.
+     * @param q The second position, greater than p.
+     * @return The index.
+     */
+    static size_t getTableIndex(int n, int p, int q)
+    {
+        return (size_t)p * (2 * (size_t)n - p - 1) / 2 + (q - p - 1);
+    }
 
     /**
      * @brief Sets the graph to represent real-world locations or not.
      *
      * Time complexity: O(1)
      *
-     * @param real Flag indicating whether the graph represents real-world locations.
+     * @param real Flag indicating whether the graph represents real-world locations (Metric::Haversine) or not (Metric::None).
      */
     void setReal(bool real);
 
+    /**
+     * @brief Checks whether the vertices have coordinates that give the distances (real-world graphs and TSPLIB coordinate instances).
+     *
+     * Time complexity: O(1)
+     *
+     * @return True if the metric is not Metric::None.
+     */
+    bool isReal() const;
+
+    /**
+     * @brief Sets how distances are computed from the vertex coordinates.
+     *
+     * Time complexity: O(1)
+     *
+     * @param metric The metric.
+     */
+    void setMetric(Metric metric);
+
+    /**
+     * @brief Returns how distances are computed from the vertex coordinates.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The metric.
+     */
+    Metric getMetric() const;
+
+    /**
+     * @brief Computes a 64-bit FNV-1a hash of the graph contents: the metric, the vertex IDs, their coordinates (if any)
+     * and the weights of their edges, taken in increasing ID order so it does not depend on the order of the input files.
+     * The pairs of the distance table count as edges, so a complete graph read with only the nearest neighbours of every
+     * vertex in its adjacency has the fingerprint of the whole graph.
+     *
+     * Time complexity: O(V * log(V) + E * log(E)), with E at least V^2 with a distance table
+     *
+     * @return The fingerprint.
+     */
+    uint64_t fingerprint() const;
+
     // Algorithms
 
     /**
      * @brief Applies the Prim's algorithm to find the minimum spanning tree of the graph.
      *
-     * Time complexity: O(E * log(V)) being E the number of edges and V the number of vertexes
+     * The tree is stored in the scratch (the parent of every vertex and the weight of the edge from it), rooted at the
+     * vertex with ID 0. Graphs with at least half of all possible edges use the array-scan version (densePrim), the
+     * others the priority queue version (heapPrim). Both extract the vertices in the same order (by distance, then by
+     * index), so they build the same tree. Coordinate graphs with too few edges to span their vertices (only a nodes
+     * file) use coordinatePrim, which builds the tree over the Delaunay triangulation.
+     *
+     * Time complexity: O(V^2) for dense graphs, O(V * log(V)) for coordinate-only graphs, O(E * log(V)) otherwise,
+     * being E the number of edges and V the number of vertexes
+     *
+     * @param scratch Receives the tree.
      */
-    void prim();
+    void prim(GraphScratch &scratch) const;
 
     /**
-     * @brief Performs a depth-first search (DFS) on the graph, calculating the total distance and storing the path.
+     * @brief Finds a minimum spanning tree with Borůvka's algorithm, run by several threads.
      *
-     * Time complexity: O(V) being V the number of vertexes
+     * The threads are started once and keep one range of vertices each for the whole run, with the steps of every round
+     * separated by std::barrier, as in ParallelTwoOpt. They first copy the edges to adjacency arrays (CSR). Every round,
+     * each thread finds the cheapest edge leaving every vertex of its range to another component, and keeps the cheapest one of
+     * every component with a compare-and-swap. The components are then joined by these edges through a concurrent
+     * union-find (lock-free linking and path halving), so the number of components at least halves every round. Edges
+     * are ordered by weight, then by the IDs of their ends, so the tree is unique and the same for any number of threads.
      *
-     * @param vertex Pointer to the current vertex being visited.
-     * @param lastVertex Pointer to the last visited vertex.
+     * The tree is stored like prim() stores it, so dfs can walk it. It is a minimum spanning tree as well, but between
+     * edges of equal weight it can choose differently from prim(). Coordinate graphs without the edges to span their
+     * vertices use prim().
+     *
+     * Time complexity: O(E * log(V) / T) being T the number of threads
+     *
+     * @param threads The number of threads.
+     * @param scratch Receives the tree.
+     */
+    void boruvka(int threads, GraphScratch &scratch) const;
+
+    /**
+     * @brief Lists the vertices of the minimum spanning tree (stored in the scratch by prim or boruvka) in preorder,
+     * and calculates the total distance of that path.
+     *
+     * The children of every vertex are gathered once from the parents, ordered by ID, and the tree is walked with an
+     * explicit stack, so deep trees cannot overflow the call stack. The distance is computed afterwards by pathCost.
+     *
+     * Time complexity: O(V * log(V)) being V the number of vertexes
+     *
+     * @param vertex The root of the tree.
+     * @param lastVertex The vertex visited before the root (nullptr if none); receives the last vertex of the path.
      * @param path Vector to store the path.
-     * @return The total distance of the path.
+     * @param scratch The tree, and the state of the traversal.
+     * @return The total distance of the path, from lastVertex if it was given.
+     */
+    double dfs(Vertex *vertex, Vertex **lastVertex, std::vector<Vertex *> &path, GraphScratch &scratch) const;
+
+    /**
+     * @brief Calculates the distance of a path, vertex after vertex (not returning to the first one), with getDistance.
+     *
+     * Time complexity: O(V) being V the number of vertexes in the path
+     *
+     * @param path The path.
+     * @return The distance, or -1 if two consecutive vertices have no edge and the graph has no coordinates.
      */
-    double dfs(Vertex *vertex, Vertex **lastVertex, std::vector<Vertex *> &path);
+    double pathCost(const std::vector<Vertex *> &path) const;
 };
 
 /**
@@ -151,6 +493,34 @@ public:
  */
 double haversine(double lat1, double lon1, double lat2, double lon2);
 
+/**
+ * @brief Calculates the distance between two points with a coordinate metric.
+ *
+ * Time complexity: O(1)
+ *
+ * @param metric The metric (not Metric::None).
+ * @param lat1 The latitude (first coordinate) of the first point.
+ * @param lon1 The longitude (second coordinate) of the first point.
+ * @param lat2 The latitude (first coordinate) of the second point.
+ * @param lon2 The longitude (second coordinate) of the second point.
+ * @return The distance between the two points.
+ */
+double coordinateDistance(Metric metric, double lat1, double lon1, double lat2, double lon2);
+
+/**
+ * @brief Projects a point onto a plane where Euclidean distances approximate the metric around a reference latitude.
+ *
+ * Time complexity: O(1)
+ *
+ * @param metric The metric (not Metric::None).
+ * @param lat The latitude (first coordinate) of the point.
+ * @param lon The longitude (second coordinate) of the point.
+ * @param refLat The reference latitude (for example the mean latitude of the points being projected).
+ * @param x Receives the first planar coordinate.
+ * @param y Receives the second planar coordinate.
+ */
+void projectCoordinates(Metric metric, double lat, double lon, double refLat, double &x, double &y);
+
 /**
  * @brief Deletes a dynamically allocated 2D integer matrix.
  *
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <fstream>
+#include "GraphReader.h"
+#include "TSPLib.h"
+
+std::string getField(std::istringstream &line, char delim)
+{
+    std::string string1, string2;
+    getline(line, string1, delim);
+    if (string1.front() == '"' && string1.back() != '"')
+    {
+        getline(line, string2, '"');
+        string1 += string2;
+        getline(line, string2, ',');
+        return string1.substr(1);
+    }
+    else
+        return string1;
+}
+
+/*
+ * Reads a CSV edge list keeping only the nearest neighbours and a minimum spanning tree in the adjacency, and every
+ * distance in the distance table (see readGraphFile).
+ */
+static bool readNearestGraph(const std::string &path, int nearest, Graph &graph, std::string &error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    // first pass: only the vertices, so the table is allocated once
+    std::string line;
+    getline(file, line);
+    while (getline(file, line))
+    {
+        std::istringstream s(line);
+        graph.addVertex(stoi(getField(s, ',')));
+        graph.addVertex(stoi(getField(s, ',')));
+    }
+    int n = graph.getNumVertex();
+    std::vector<int> ids(n);
+    for (Vertex *v : graph.getVertices())
+        ids[v->getIndex()] = v->getId();
+    std::vector<double> table((size_t)n * (n - 1) / 2, INF);
+
+    // second pass: the distances, and the nearest neighbours of every vertex so far in a max-heap of (distance, index)
+    std::vector<std::vector<std::pair<double, int>>> heaps(n);
+    auto offer = [&heaps, nearest](int p, int q, double w)
+    {
+        std::vector<std::pair<double, int>> &heap = heaps[p];
+        if ((int)heap.size() < nearest)
+        {
+            heap.emplace_back(w, q);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (w < heap.front().first)
+        {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = {w, q};
+            std::push_heap(heap.begin(), heap.end());
+        }
+    };
+    file.clear();
+    file.seekg(0);
+    getline(file, line);
+    while (getline(file, line))
+    {
+        std::istringstream s(line);
+        int p = graph.findVertex(stoi(getField(s, ',')))->getIndex();
+        int q = graph.findVertex(stoi(getField(s, ',')))->getIndex();
+        double w = stod(getField(s, ','));
+        if (p == q)
+            continue;
+        table[Graph::getTableIndex(n, std::min(p, q), std::max(p, q))] = w;
+        offer(p, q, w);
+        offer(q, p, w);
+    }
+
+    auto distance = [&table, n](int p, int q)
+    {
+        return table[Graph::getTableIndex(n, std::min(p, q), std::max(p, q))];
+    };
+    for (int p = 0; p < n; p++)
+    {
+        for (auto &neighbour : heaps[p])
+            graph.updateEdgeWeight(ids[p], ids[neighbour.second], distance(p, neighbour.second));
+        std::vector<std::pair<double, int>>().swap(heaps[p]);
+    }
+
+    // the edges of a minimum spanning tree (of every component), by Prim's algorithm over the table
+    std::vector<double> key(n, INF);
+    std::vector<int> parent(n, -1);
+    std::vector<char> done(n, 0);
+    for (int step = 0; step < n; step++)
+    {
+        int u = -1;
+        for (int v = 0; v < n; v++)
+            if (!done[v] && (u == -1 || key[v] < key[u]))
+                u = v;
+        done[u] = 1;
+        if (parent[u] != -1)
+            graph.updateEdgeWeight(ids[u], ids[parent[u]], key[u]);
+        for (int v = 0; v < n; v++)
+            if (!done[v] && distance(u, v) < key[v])
+            {
+                key[v] = distance(u, v);
+                parent[v] = u;
+            }
+    }
+    graph.setDistanceTable(ids, std::move(table));
+    return true;
+}
+
+bool readGraphFile(const std::string &path, bool real, Graph &graph, std::string &error, int nearest)
+{
+    if (path.size() > 4 && path.compare(path.size() - 4, 4, ".tsp") == 0)
+    {
+        if (readTSPLib(path, graph, error))
+            return true;
+        error = "Invalid TSPLIB file: " + error;
+        graph.resetGraph();
+        graph.setReal(false);
+        return false;
+    }
+
+    graph.setReal(real);
+    if (!real && nearest > 0)
+        return readNearestGraph(path, nearest, graph, error);
+    bool f = true;
+    if (!real)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            error = "cannot open " + path;
+            return false;
+        }
+        std::string line;
+        while (getline(file, line))
+        {
+            if (f)
+            {
+                f = false;
+            }
+            else
+            {
+                std::string start, end, distancia;
+                std::istringstream s(line);
+
+                start = getField(s, ',');
+                end = getField(s, ',');
+                distancia = getField(s, ',');
+
+                graph.addVertex(stoi(start));
+                graph.addVertex(stoi(end));
+
+                graph.addBidirectionalEdge(stoi(start), stoi(end), stod(distancia));
+            }
+        }
+        return true;
+    }
+
+    std::ifstream file(path + "nodes.csv");
+    if (!file)
+    {
+        error = "cannot open " + path + "nodes.csv";
+        return false;
+    }
+    std::string line;
+    while (getline(file, line))
+    {
+        if (f)
+        {
+            f = false;
+        }
+        else
+        {
+            std::string start, longi, lati;
+            std::istringstream s(line);
+
+            start = getField(s, ',');
+            longi = getField(s, ',');
+            lati = getField(s, ',');
+
+            graph.addVertex(stoi(start));
+
+            graph.findVertex(stoi(start))->setLatitude(stod(lati));
+            graph.findVertex(stoi(start))->setLongitude(stod(longi));
+        }
+    }
+    f = true;
+    file = std::ifstream(path + "edges.csv");
+    while (getline(file, line))
+    {
+        if (f)
+        {
+            f = false;
+        }
+        else
+        {
+            std::string orig, dest, dist;
+            std::istringstream s(line);
+
+            orig = getField(s, ',');
+            dest = getField(s, ',');
+            dist = getField(s, ',');
+
+            graph.addBidirectionalEdge(stoi(orig), stoi(dest), stod(dist));
+        }
+    }
+    return true;
+}
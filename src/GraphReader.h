@@ -0,0 +1,50 @@
+/**
+ * @file GraphReader.h
+ * @brief This file contains the reader of the graph files: the CSV edge lists, the real-world graph directories and TSPLIB instances.
+ */
+
+#ifndef DAPROJECT2_GRAPHREADER_H
+#define DAPROJECT2_GRAPHREADER_H
+
+#include <sstream>
+#include <string>
+#include "Graph.h"
+
+/**
+ * @brief Reads a graph into an empty graph.
+ *
+ * - A path ending with .tsp is read as a TSPLIB instance (see readTSPLib).
+ * - Otherwise, if real is false, the path is a CSV file with one edge per line (origin, destination, distance).
+ * - Otherwise the path is a directory with a nodes.csv file (ID, longitude, latitude) and an optional edges.csv file;
+ *   the graph gets the Haversine metric.
+ * The first line of every CSV file is a header.
+ *
+ * With nearest > 0, a CSV edge list (usually a complete graph) is read keeping in the adjacency only the edges to the
+ * nearest neighbours of every vertex, and the edges of a minimum spanning tree, so Graph::prim finds the same tree over
+ * far fewer edges. The file is read twice: first for the vertices, then for the distances, every one of which goes to
+ * the distance table of the graph (Graph::setDistanceTable) while a bounded max-heap per vertex keeps its nearest
+ * neighbours so far. Edge objects are only created for the kept edges.
+ *
+ * Time complexity: O(V + E) being V the number of vertexes and E the number of edges; O(V^2 + E * log(k)) with nearest
+ * neighbours
+ *
+ * @param path The path of the file or directory.
+ * @param real Whether the path is a real-world graph directory (ignored for .tsp files).
+ * @param graph The graph that receives the vertices and edges (it must be empty).
+ * @param error Receives the reason when the graph cannot be read.
+ * @param nearest Number of nearest neighbours of every vertex kept in the adjacency of a CSV edge list (0 keeps every edge).
+ * @return True if the graph was read.
+ */
+bool readGraphFile(const std::string &path, bool real, Graph &graph, std::string &error, int nearest = 0);
+
+/**
+ * Reads a field from a cvs file
+ *
+ * Time complexity: O(1)
+ * 
+ * @param line istringstream variable
+ * @param delim until which character should the line be read
+ */
+std::string getField(std::istringstream &line, char delim);
+
+#endif // DAPROJECT2_GRAPHREADER_H
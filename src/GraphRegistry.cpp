@@ -0,0 +1,124 @@
+#include "GraphRegistry.h"
+#include "GraphReader.h"
+
+GraphRegistry::GraphRegistry(const std::string &baseDir, size_t budget) : baseDir(baseDir), budget(budget) {}
+
+ResidentGraph GraphRegistry::acquire(const std::string &path, bool real, bool withInstance, std::string &error, bool *read,
+                                     int nearest)
+{
+    Key key(path, real, nearest);
+    std::shared_ptr<Slot> slot;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        std::shared_ptr<Slot> &entry = this->slots[key];
+        if (entry == nullptr)
+            entry = std::make_shared<Slot>();
+        slot = entry;
+        if (slot->listed)
+            this->recent.splice(this->recent.begin(), this->recent, slot->position);
+    }
+
+    std::lock_guard<std::mutex> loading(slot->loading);
+    if (read != nullptr)
+        *read = false;
+    if (slot->resident.graph == nullptr)
+    {
+        auto graph = std::make_shared<Graph>();
+        if (!readGraphFile(this->baseDir + path, real, *graph, error, nearest) || graph->getNumVertex() == 0)
+        {
+            if (error.empty())
+                error = "the graph " + path + " has no vertexes";
+            std::lock_guard<std::mutex> lock(this->mutex);
+            auto it = this->slots.find(key);
+            if (it != this->slots.end() && it->second == slot)
+                this->slots.erase(it);
+            return {};
+        }
+        slot->resident.fingerprint = graph->fingerprint();
+        slot->resident.graph = graph;
+        slot->vertices = graph->getNumVertex();
+        if (read != nullptr)
+            *read = true;
+        charge(key, slot, graph->memoryUsage());
+    }
+    if (withInstance && slot->resident.instance == nullptr)
+    {
+        auto instance = std::make_shared<const TSPInstance>(TSPInstance::fromGraph(*slot->resident.graph));
+        slot->resident.instance = instance;
+        charge(key, slot, instance->memoryUsage());
+    }
+    return slot->resident;
+}
+
+void GraphRegistry::charge(const Key &key, const std::shared_ptr<Slot> &slot, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    // the slot was released or evicted while it was being built: whoever holds it keeps it, the registry does not
+    auto it = this->slots.find(key);
+    if (it == this->slots.end() || it->second != slot)
+        return;
+    slot->bytes += bytes;
+    this->usage += bytes;
+    if (slot->listed)
+        this->recent.splice(this->recent.begin(), this->recent, slot->position);
+    else
+    {
+        this->recent.push_front(key);
+        slot->position = this->recent.begin();
+        slot->listed = true;
+    }
+    evict();
+}
+
+void GraphRegistry::evict()
+{
+    // the front of recent is the graph being acquired, which is kept even if it alone is over the budget
+    while (this->budget > 0 && this->usage > this->budget && this->recent.size() > 1)
+    {
+        auto it = this->slots.find(this->recent.back());
+        this->usage -= it->second->bytes;
+        it->second->listed = false;
+        this->slots.erase(it);
+        this->recent.pop_back();
+    }
+}
+
+void GraphRegistry::release(const std::string &path, bool real, int nearest)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->slots.find(Key(path, real, nearest));
+    if (it == this->slots.end())
+        return;
+    if (it->second->listed)
+    {
+        this->usage -= it->second->bytes;
+        this->recent.erase(it->second->position);
+        it->second->listed = false;
+    }
+    this->slots.erase(it);
+}
+
+void GraphRegistry::setBudget(size_t budget)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->budget = budget;
+    evict();
+}
+
+size_t GraphRegistry::getMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->usage;
+}
+
+std::vector<RegistryEntry> GraphRegistry::list() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    std::vector<RegistryEntry> result;
+    for (const Key &key : this->recent)
+    {
+        const Slot &slot = *this->slots.at(key);
+        result.push_back({std::get<0>(key), std::get<1>(key), std::get<2>(key), slot.vertices, slot.bytes});
+    }
+    return result;
+}
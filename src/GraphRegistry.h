@@ -0,0 +1,151 @@
+/**
+ * @file GraphRegistry.h
+ * @brief This file contains the registry of the graphs kept in memory, with least-recently-used eviction.
+ */
+
+#ifndef DAPROJECT2_GRAPHREGISTRY_H
+#define DAPROJECT2_GRAPHREGISTRY_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Graph.h"
+#include "TSPInstance.h"
+
+/**
+ * @struct ResidentGraph
+ * @brief A graph held by the registry, with what is computed once per graph.
+ */
+struct ResidentGraph
+{
+    std::shared_ptr<Graph> graph;                 /**< The graph (null if it could not be read). */
+    std::shared_ptr<const TSPInstance> instance;  /**< Its instance, if it was asked for. */
+    uint64_t fingerprint = 0;                     /**< Graph::fingerprint of the graph as read. */
+};
+
+/**
+ * @struct RegistryEntry
+ * @brief Description of a graph in the registry, for listings.
+ */
+struct RegistryEntry
+{
+    std::string path;   /**< Path of the graph, as given to acquire. */
+    bool real = false;  /**< Whether it was read as a real-world graph. */
+    int nearest = 0;    /**< Nearest neighbours kept per vertex when it was read (0 for every edge). */
+    int vertices = 0;   /**< Number of vertices. */
+    size_t bytes = 0;   /**< Estimated memory of the graph and its instance. */
+};
+
+/**
+ * @class GraphRegistry
+ * @brief Keeps several graphs in memory by path, so selecting a graph read before does not read its files again. The
+ * same file read keeping a different number of nearest neighbours (see readGraphFile) is a different graph.
+ *
+ * Every graph is charged its estimated memory (Graph::memoryUsage, plus TSPInstance::memoryUsage once its instance is
+ * built). When the total goes over the budget, the least recently acquired graphs are dropped until it fits, except the
+ * one just acquired. Graphs are shared: a dropped graph stays alive while someone still holds it, and is deleted with
+ * the last holder.
+ *
+ * The registry can be used from several threads. A graph is read by the first thread that acquires it, outside of the
+ * registry lock, so other graphs can be acquired meanwhile; threads acquiring the same graph wait for that read.
+ */
+class GraphRegistry
+{
+public:
+    /**
+     * @brief Constructs an empty registry.
+     *
+     * @param baseDir Directory prepended to the paths of the graphs.
+     * @param budget Memory budget in bytes (0 for no limit).
+     */
+    explicit GraphRegistry(const std::string &baseDir, size_t budget = 0);
+
+    /**
+     * @brief Returns a graph, reading it (see readGraphFile) if it is not in the registry, and marks it as the most
+     * recently used.
+     *
+     * Time complexity: O(V + E) (plus building the instance) if the graph is read, O(log(G)) otherwise, being G the number
+     * of graphs in the registry
+     *
+     * @param path Path of the graph, relative to the base directory.
+     * @param real Whether it is a real-world graph directory.
+     * @param withInstance Whether to build the TSPInstance of the graph too, if it does not have one yet.
+     * @param error Receives the reason when the graph cannot be read.
+     * @param read If not null, set to whether the files were read by this call.
+     * @param nearest Nearest neighbours kept per vertex of a CSV edge list (0 keeps every edge).
+     * @return The graph (with a null graph on error).
+     */
+    ResidentGraph acquire(const std::string &path, bool real, bool withInstance, std::string &error, bool *read = nullptr,
+                          int nearest = 0);
+
+    /**
+     * @brief Drops a graph from the registry (for example because it was modified), so the next acquire reads it again.
+     *
+     * Time complexity: O(log(G))
+     *
+     * @param path Path of the graph.
+     * @param real Whether it was read as a real-world graph.
+     * @param nearest Nearest neighbours kept per vertex when it was read.
+     */
+    void release(const std::string &path, bool real, int nearest = 0);
+
+    /**
+     * @brief Changes the memory budget, dropping graphs if they no longer fit.
+     *
+     * Time complexity: O(G)
+     *
+     * @param budget Memory budget in bytes (0 for no limit).
+     */
+    void setBudget(size_t budget);
+
+    /**
+     * @brief Returns the estimated memory of the graphs in the registry.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The memory, in bytes.
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Lists the graphs in the registry, from the most to the least recently used.
+     *
+     * Time complexity: O(G)
+     *
+     * @return The graphs.
+     */
+    std::vector<RegistryEntry> list() const;
+
+private:
+    using Key = std::tuple<std::string, bool, int>;
+
+    /**
+     * @struct Slot
+     * @brief A graph of the registry, or one being read.
+     */
+    struct Slot
+    {
+        std::mutex loading;                  /**< Held while the graph or its instance are built. */
+        ResidentGraph resident;
+        int vertices = 0;                    /**< Number of vertices of the graph as read. */
+        size_t bytes = 0;                    /**< Memory charged to the registry. */
+        bool listed = false;                 /**< Whether it is in recent (false while it is first read). */
+        std::list<Key>::iterator position;   /**< Position in recent. */
+    };
+
+    std::string baseDir;
+    size_t budget;
+    size_t usage = 0;
+    mutable std::mutex mutex;
+    std::map<Key, std::shared_ptr<Slot>> slots;
+    std::list<Key> recent; /**< Graphs read, the most recently used first. */
+
+    void charge(const Key &key, const std::shared_ptr<Slot> &slot, size_t bytes);
+    void evict();
+};
+
+#endif // DAPROJECT2_GRAPHREGISTRY_H
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "HeapBenchmark.h"
+#include "IndexedHeap.h"
+#include "MutablePriorityQueue.h"
+
+namespace
+{
+    /*
+     * Graph edges in CSR form, with the weights rounded to integers.
+     */
+    struct Adjacency
+    {
+        int n = 0;
+        std::vector<int> start;
+        std::vector<int> target;
+        std::vector<uint64_t> weight;
+    };
+
+    /*
+     * The element type MutablePriorityQueue needs: a queueIndex field and operator< (with the same order as IndexedHeap).
+     */
+    struct QueueNode
+    {
+        int id = 0;
+        double dist = 0;
+        int queueIndex = 0;
+
+        bool operator<(QueueNode &node) const
+        {
+            return dist < node.dist || (dist == node.dist && id < node.id);
+        }
+    };
+
+    double mutableQueueDijkstra(const Adjacency &graph, int source, std::vector<QueueNode> &nodes)
+    {
+        for (int v = 0; v < graph.n; v++)
+            nodes[v] = {v, INF, 0};
+        std::vector<char> done(graph.n, 0), queued(graph.n, 0);
+        MutablePriorityQueue<QueueNode> queue;
+        nodes[source].dist = 0;
+        queued[source] = 1;
+        queue.insert(&nodes[source]);
+
+        double total = 0;
+        while (!queue.empty())
+        {
+            QueueNode *u = queue.extractMin();
+            done[u->id] = 1;
+            total += u->dist;
+            for (int a = graph.start[u->id]; a < graph.start[u->id + 1]; a++)
+            {
+                QueueNode &w = nodes[graph.target[a]];
+                double d = u->dist + (double)graph.weight[a];
+                if (done[w.id] || (queued[w.id] && d >= w.dist))
+                    continue;
+                w.dist = d;
+                if (queued[w.id])
+                    queue.decreaseKey(&w);
+                else
+                {
+                    queued[w.id] = 1;
+                    queue.insert(&w);
+                }
+            }
+        }
+        return total;
+    }
+
+    template <class Queue, class Key>
+    double indexedDijkstra(const Adjacency &graph, int source)
+    {
+        Queue queue(graph.n);
+        std::vector<char> done(graph.n, 0);
+        queue.pushOrDecrease(source, 0);
+
+        double total = 0;
+        while (!queue.empty())
+        {
+            int u = queue.pop();
+            done[u] = 1;
+            Key du = queue.key(u);
+            total += (double)du;
+            for (int a = graph.start[u]; a < graph.start[u + 1]; a++)
+                if (!done[graph.target[a]])
+                    queue.pushOrDecrease(graph.target[a], du + (Key)graph.weight[a]);
+        }
+        return total;
+    }
+}
+
+std::vector<HeapBenchmarkResult> benchmarkHeaps(const Graph &graph, int sources)
+{
+    std::vector<int> ids;
+    for (auto &a : graph.getVertexMap())
+        ids.push_back(a.first);
+    std::sort(ids.begin(), ids.end());
+    std::unordered_map<int, int> indexOf;
+    for (int i = 0; i < (int)ids.size(); i++)
+        indexOf[ids[i]] = i;
+
+    Adjacency adjacency;
+    adjacency.n = (int)ids.size();
+    adjacency.start.assign(adjacency.n + 1, 0);
+    for (int i = 0; i < adjacency.n; i++)
+    {
+        for (auto &e : graph.findVertex(ids[i])->getAdj())
+        {
+            adjacency.target.push_back(indexOf.at(e.first));
+            adjacency.weight.push_back((uint64_t)std::llround(std::max(0.0, e.second->getWeight())));
+        }
+        adjacency.start[i + 1] = (int)adjacency.target.size();
+    }
+    sources = std::max(1, std::min(sources, adjacency.n));
+
+    std::vector<HeapBenchmarkResult> results;
+    auto measure = [&](const std::string &name, auto query)
+    {
+        auto begin = std::chrono::high_resolution_clock::now();
+        double checksum = 0;
+        for (int s = 0; s < sources; s++)
+            checksum += query(s);
+        auto end = std::chrono::high_resolution_clock::now();
+        results.push_back({name, std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count(), checksum});
+    };
+
+    if (adjacency.n == 0)
+        return results;
+    std::vector<QueueNode> nodes(adjacency.n);
+    measure("MutablePriorityQueue (binary)", [&](int s) { return mutableQueueDijkstra(adjacency, s, nodes); });
+    measure("IndexedHeap<2>", [&](int s) { return indexedDijkstra<IndexedHeap<2>, double>(adjacency, s); });
+    measure("IndexedHeap<4>", [&](int s) { return indexedDijkstra<IndexedHeap<4>, double>(adjacency, s); });
+    measure("IndexedHeap<8>", [&](int s) { return indexedDijkstra<IndexedHeap<8>, double>(adjacency, s); });
+    measure("RadixHeap", [&](int s) { return indexedDijkstra<RadixHeap, uint64_t>(adjacency, s); });
+    return results;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file HeapBenchmark.h
+ * @brief This file contains the benchmark of the priority queues on Dijkstra queries over the graph.
+ */
+
+#ifndef DAPROJECT2_HEAPBENCHMARK_H
+#define DAPROJECT2_HEAPBENCHMARK_H
+
+#include <string>
+#include <vector>
+#include "Graph.h"
+
+/**
+ * @struct HeapBenchmarkResult
+ * @brief Time taken by one priority queue to run the benchmark queries.
+ */
+struct HeapBenchmarkResult
+{
+    std::string name;          /**< The priority queue. */
+    long long microseconds;    /**< Time of all the queries. */
+    double checksum;           /**< Sum of all shortest distances found, equal for every queue. */
+};
+
+/**
+ * @brief Runs Dijkstra's algorithm from several sources over the edges of the graph with every priority queue:
+ * MutablePriorityQueue, IndexedHeap with arity 2, 4 and 8, and RadixHeap.
+ *
+ * The edge weights are rounded to integers so the radix heap can run the same queries. The graph is first copied to
+ * adjacency arrays indexed by dense vertex indexes, so only the priority queues differ between the runs.
+ *
+ * Time complexity: O(S * E * log(V)) being S the number of sources
+ *
+ * @param graph The graph.
+ * @param sources The number of sources (the vertices with the smallest IDs).
+ * @return One result per priority queue.
+ */
+std::vector<HeapBenchmarkResult> benchmarkHeaps(const Graph &graph, int sources);
+
+#endif // DAPROJECT2_HEAPBENCHMARK_H
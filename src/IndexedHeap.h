@@ -0,0 +1,374 @@
+/**
+ * @file IndexedHeap.h
+ * @brief This file contains the indexed priority queues keyed by dense integer IDs (d-ary heap and radix heap).
+ */
+
+#ifndef DAPROJECT2_INDEXEDHEAP_H
+#define DAPROJECT2_INDEXEDHEAP_H
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @class IndexedHeap
+ * @brief Mutable priority queue of dense integer IDs (0 to capacity - 1), with a compile-time arity.
+ *
+ * Unlike MutablePriorityQueue, the keys and the positions in the heap are stored in arrays owned by the queue and
+ * indexed by ID, so the elements need no queueIndex field and any number of queues can run on the same vertices at once
+ * (for example one Prim or Dijkstra query per thread). Ties between equal keys are broken by ID, the same order as
+ * Vertex::operator<. Wider heaps (4 or 8) are shallower, so decreaseKey does fewer moves and pop reads children that
+ * share cache lines.
+ *
+ * @tparam Arity Number of children per node (2, 4 or 8).
+ * @tparam Key Type of the keys.
+ */
+template <int Arity = 4, class Key = double>
+class IndexedHeap
+{
+    static_assert(Arity == 2 || Arity == 4 || Arity == 8, "IndexedHeap supports arity 2, 4 or 8");
+
+public:
+    /**
+     * @brief Constructs an empty queue for the IDs 0 to capacity - 1.
+     *
+     * Time complexity: O(capacity)
+     *
+     * @param capacity The number of IDs.
+     */
+    explicit IndexedHeap(int capacity = 0) : keys(capacity), position(capacity, -1) {}
+
+    /**
+     * @brief Empties the queue and sets the IDs it accepts to 0 to capacity - 1, keeping the memory it already has.
+     *
+     * Time complexity: O(capacity)
+     *
+     * @param capacity The number of IDs.
+     */
+    void reset(int capacity)
+    {
+        keys.resize(capacity);
+        position.assign(capacity, -1);
+        heap.clear();
+    }
+
+    /**
+     * @brief Checks whether the queue is empty.
+     *
+     * Time complexity: O(1)
+     *
+     * @return True if the queue is empty.
+     */
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    /**
+     * @brief Returns the number of IDs in the queue.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The size of the queue.
+     */
+    int size() const
+    {
+        return (int)heap.size();
+    }
+
+    /**
+     * @brief Checks whether an ID is in the queue.
+     *
+     * Time complexity: O(1)
+     *
+     * @param id The ID.
+     * @return True if the ID is in the queue.
+     */
+    bool contains(int id) const
+    {
+        return position[id] != -1;
+    }
+
+    /**
+     * @brief Returns the key of an ID (the last key it had, if it is not in the queue anymore).
+     *
+     * Time complexity: O(1)
+     *
+     * @param id The ID.
+     * @return The key.
+     */
+    Key key(int id) const
+    {
+        return keys[id];
+    }
+
+    /**
+     * @brief Inserts an ID that is not in the queue.
+     *
+     * Time complexity: O(log(V) / log(Arity))
+     *
+     * @param id The ID.
+     * @param key Its key.
+     */
+    void push(int id, Key key)
+    {
+        keys[id] = key;
+        position[id] = (int)heap.size();
+        heap.push_back(id);
+        siftUp(position[id]);
+    }
+
+    /**
+     * @brief Lowers the key of an ID in the queue.
+     *
+     * Time complexity: O(log(V) / log(Arity))
+     *
+     * @param id The ID.
+     * @param key The new key, not greater than the current one.
+     */
+    void decreaseKey(int id, Key key)
+    {
+        keys[id] = key;
+        siftUp(position[id]);
+    }
+
+    /**
+     * @brief Inserts an ID, or lowers its key if it is in the queue with a greater key.
+     *
+     * Time complexity: O(log(V) / log(Arity))
+     *
+     * @param id The ID.
+     * @param key The key.
+     * @return True if the queue changed.
+     */
+    bool pushOrDecrease(int id, Key key)
+    {
+        if (position[id] == -1)
+        {
+            push(id, key);
+            return true;
+        }
+        if (!(key < keys[id]))
+            return false;
+        decreaseKey(id, key);
+        return true;
+    }
+
+    /**
+     * @brief Returns the ID with the smallest key, without removing it.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The ID.
+     */
+    int top() const
+    {
+        return heap.front();
+    }
+
+    /**
+     * @brief Removes and returns the ID with the smallest key.
+     *
+     * Time complexity: O(Arity * log(V) / log(Arity))
+     *
+     * @return The ID.
+     */
+    int pop()
+    {
+        int id = heap.front();
+        position[id] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+        {
+            heap[0] = last;
+            position[last] = 0;
+            siftDown(0);
+        }
+        return id;
+    }
+
+    /**
+     * @brief Removes every ID from the queue.
+     *
+     * Time complexity: O(size())
+     */
+    void clear()
+    {
+        for (int id : heap)
+            position[id] = -1;
+        heap.clear();
+    }
+
+private:
+    std::vector<Key> keys;     /**< Key of every ID. */
+    std::vector<int> position; /**< Position of every ID in the heap (-1 if it is not in the queue). */
+    std::vector<int> heap;     /**< The heap, rooted at position 0. */
+
+    bool less(int a, int b) const
+    {
+        return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+    }
+
+    void place(int i, int id)
+    {
+        heap[i] = id;
+        position[id] = i;
+    }
+
+    void siftUp(int i)
+    {
+        int id = heap[i];
+        while (i > 0)
+        {
+            int up = (i - 1) / Arity;
+            if (!less(id, heap[up]))
+                break;
+            place(i, heap[up]);
+            i = up;
+        }
+        place(i, id);
+    }
+
+    void siftDown(int i)
+    {
+        int id = heap[i], n = (int)heap.size();
+        while (true)
+        {
+            int first = i * Arity + 1;
+            if (first >= n)
+                break;
+            int best = first, last = first + Arity < n ? first + Arity : n;
+            for (int c = first + 1; c < last; c++)
+                if (less(heap[c], heap[best]))
+                    best = c;
+            if (!less(heap[best], id))
+                break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, id);
+    }
+};
+
+/**
+ * @class RadixHeap
+ * @brief Indexed priority queue of dense integer IDs for monotone unsigned integer keys (Dijkstra with integer weights).
+ *
+ * Keys must never be smaller than the last key popped. Entries are kept in 65 buckets by the highest bit in which their
+ * key differs from the last key popped; popping empties the lowest non-empty bucket and redistributes its entries into
+ * lower buckets, so every entry moves at most 64 times. Lowering a key adds a new entry, and entries whose key is not
+ * the current key of their ID are skipped when popped.
+ */
+class RadixHeap
+{
+public:
+    /**
+     * @brief Constructs an empty queue for the IDs 0 to capacity - 1.
+     *
+     * Time complexity: O(capacity)
+     *
+     * @param capacity The number of IDs.
+     */
+    explicit RadixHeap(int capacity = 0) : keys(capacity, NONE), done(capacity, 0) {}
+
+    /**
+     * @brief Checks whether the queue is empty.
+     *
+     * Time complexity: O(1)
+     *
+     * @return True if the queue is empty.
+     */
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * @brief Returns the key of an ID (NONE if it was never inserted).
+     *
+     * Time complexity: O(1)
+     *
+     * @param id The ID.
+     * @return The key.
+     */
+    uint64_t key(int id) const
+    {
+        return keys[id];
+    }
+
+    /**
+     * @brief Inserts an ID, or lowers its key if it is in the queue with a greater key. IDs already popped are ignored.
+     *
+     * Time complexity: O(1)
+     *
+     * @param id The ID.
+     * @param key The key, not smaller than the last key popped.
+     * @return True if the queue changed.
+     */
+    bool pushOrDecrease(int id, uint64_t key)
+    {
+        if (done[id] || key >= keys[id])
+            return false;
+        if (keys[id] == NONE)
+            count++;
+        keys[id] = key;
+        buckets[bucket(key)].emplace_back(key, id);
+        return true;
+    }
+
+    /**
+     * @brief Removes and returns the ID with the smallest key.
+     *
+     * Time complexity: O(log(C)) amortized being C the largest key
+     *
+     * @return The ID.
+     */
+    int pop()
+    {
+        while (true)
+        {
+            if (buckets[0].empty())
+            {
+                int b = 1;
+                while (buckets[b].empty())
+                    b++;
+                uint64_t smallest = NONE;
+                for (auto &entry : buckets[b])
+                    if (!done[entry.second] && entry.first == keys[entry.second] && entry.first < smallest)
+                        smallest = entry.first;
+                if (smallest != NONE)
+                    last = smallest;
+                for (auto &entry : buckets[b])
+                    if (!done[entry.second] && entry.first == keys[entry.second])
+                        buckets[bucket(entry.first)].push_back(entry);
+                buckets[b].clear();
+                continue;
+            }
+            auto entry = buckets[0].back();
+            buckets[0].pop_back();
+            if (done[entry.second] || entry.first != keys[entry.second])
+                continue;
+            done[entry.second] = 1;
+            count--;
+            return entry.second;
+        }
+    }
+
+    static constexpr uint64_t NONE = std::numeric_limits<uint64_t>::max(); /**< Key of the IDs never inserted. */
+
+private:
+    std::vector<uint64_t> keys;                                /**< Current key of every ID. */
+    std::vector<char> done;                                    /**< Whether every ID was popped. */
+    std::vector<std::pair<uint64_t, int>> buckets[65];
+    uint64_t last = 0;                                         /**< The last key popped. */
+    int count = 0;                                             /**< IDs in the queue. */
+
+    int bucket(uint64_t key) const
+    {
+        return key == last ? 0 : 64 - std::countl_zero(key ^ last);
+    }
+};
+
+#endif // DAPROJECT2_INDEXEDHEAP_H
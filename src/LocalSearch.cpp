@@ -0,0 +1,250 @@
+#include <algorithm>
+#include "LocalSearch.h"
+
+void reverseSegment(std::vector<int> &tour, std::vector<int> &pos, int i, int j)
+{
+    int n = (int)tour.size();
+    int len = ((j - i + n) % n) + 1;
+    if (2 * len > n)
+    {
+        // reversing the complement gives the same cycle and touches fewer positions
+        int ni = (j + 1) % n;
+        j = (i - 1 + n) % n;
+        i = ni;
+        len = n - len;
+    }
+    for (int s = 0; s < len / 2; s++)
+    {
+        int a = (i + s) % n;
+        int b = (j - s + n) % n;
+        std::swap(tour[a], tour[b]);
+        pos[tour[a]] = a;
+        pos[tour[b]] = b;
+    }
+}
+
+/*
+ * Processes the don't-look-bit queue of the workspace until it is empty, or until the control (when given) asks to stop;
+ * the vertices still queued then get their bits back, so the workspace stays valid for twoOptFrom.
+ * Every applied reversal is appended to the journal (when given), so that it can be undone.
+ */
+static double processQueue(const TSPInstance &instance, std::vector<int> &tour, const std::vector<int> &neighbours, int k,
+                           LocalSearchWorkspace &workspace, int count, std::vector<std::pair<int, int>> *journal,
+                           SolverControl *control = nullptr)
+{
+    int n = (int)tour.size();
+    std::vector<int> &pos = workspace.pos;
+    std::vector<int> &queue = workspace.queue;
+    std::vector<char> &inQueue = workspace.inQueue;
+    int head = 0;
+
+    double total = 0;
+    double epsilon = 1e-9;
+    auto push = [&](int v)
+    {
+        if (!inQueue[v])
+        {
+            inQueue[v] = 1;
+            queue[(head + count) % n] = v;
+            count++;
+        }
+    };
+    auto apply = [&](int i, int j)
+    {
+        reverseSegment(tour, pos, i, j);
+        if (journal != nullptr)
+            journal->emplace_back(i, j);
+    };
+
+    long long popped = 0;
+    while (count > 0)
+    {
+        // the clock is only read every 256 vertices
+        if (control != nullptr && (++popped & 255) == 0 && control->shouldStop())
+        {
+            for (int q = 0; q < count; q++)
+                inQueue[queue[(head + q) % n]] = 0;
+            break;
+        }
+        int a = queue[head];
+        head = (head + 1) % n;
+        count--;
+        inQueue[a] = 0;
+
+        bool improved = false;
+        for (int dir = 0; dir < 2 && !improved; dir++)
+        {
+            int pa = pos[a];
+            int b = dir == 0 ? tour[(pa + 1) % n] : tour[(pa - 1 + n) % n];
+            double dab = instance.dist(a, b);
+            for (int x = 0; x < k; x++)
+            {
+                int c = neighbours[(size_t)a * k + x];
+                double dac = instance.dist(a, c);
+                if (dac >= dab)
+                    break;
+                int pc = pos[c];
+                int d = dir == 0 ? tour[(pc + 1) % n] : tour[(pc - 1 + n) % n];
+                if (c == b || d == a)
+                    continue;
+                double delta = dac + instance.dist(b, d) - dab - instance.dist(c, d);
+                if (delta < -epsilon)
+                {
+                    if (dir == 0)
+                        apply(pos[b], pos[c]);
+                    else
+                        apply(pos[a], pos[d]);
+                    total += delta;
+                    push(a);
+                    push(b);
+                    push(c);
+                    push(d);
+                    improved = true;
+                    break;
+                }
+            }
+        }
+    }
+    return total;
+}
+
+double twoOptNeighbours(const TSPInstance &instance, std::vector<int> &tour, const std::vector<int> &neighbours, int k,
+                        LocalSearchWorkspace &workspace, SolverControl *control)
+{
+    int n = (int)tour.size();
+    if (n < 4)
+        return 0;
+
+    workspace.pos.resize(instance.size());
+    workspace.queue.resize(n);
+    workspace.inQueue.assign(instance.size(), 1);
+    for (int i = 0; i < n; i++)
+    {
+        workspace.pos[tour[i]] = i;
+        workspace.queue[i] = tour[i];
+    }
+    return processQueue(instance, tour, neighbours, k, workspace, n, nullptr, control);
+}
+
+double twoOptFrom(const TSPInstance &instance, std::vector<int> &tour, const std::vector<int> &neighbours, int k,
+                  const std::vector<int> &seeds, LocalSearchWorkspace &workspace, std::vector<std::pair<int, int>> *journal)
+{
+    int n = (int)tour.size();
+    if (n < 4)
+        return 0;
+
+    int count = 0;
+    for (int v : seeds)
+    {
+        if (workspace.inQueue[v])
+            continue;
+        workspace.inQueue[v] = 1;
+        workspace.queue[count++] = v;
+    }
+    return processQueue(instance, tour, neighbours, k, workspace, count, journal);
+}
+
+double twoOptNeighbours(const TSPInstance &instance, std::vector<int> &tour, const std::vector<int> &neighbours, int k,
+                        SolverControl *control)
+{
+    LocalSearchWorkspace workspace;
+    return twoOptNeighbours(instance, tour, neighbours, k, workspace, control);
+}
+
+void doubleBridge(std::vector<int> &tour, std::mt19937 &rng)
+{
+    int n = (int)tour.size();
+    if (n < 8)
+        return;
+    std::uniform_int_distribution<int> pick(1, n - 1);
+    int cuts[3];
+    do
+    {
+        for (int &c : cuts)
+            c = pick(rng);
+        std::sort(cuts, cuts + 3);
+    } while (cuts[0] == cuts[1] || cuts[1] == cuts[2]);
+
+    static thread_local std::vector<int> result;
+    result.clear();
+    result.insert(result.end(), tour.begin(), tour.begin() + cuts[0]);
+    result.insert(result.end(), tour.begin() + cuts[1], tour.begin() + cuts[2]);
+    result.insert(result.end(), tour.begin() + cuts[0], tour.begin() + cuts[1]);
+    result.insert(result.end(), tour.begin() + cuts[2], tour.end());
+    std::copy(result.begin(), result.end(), tour.begin());
+}
+
+/*
+ * Swaps the two consecutive segments [i, i+l1) and [i+l1, i+l1+l2) (positions taken cyclically)
+ * with three reversals, recording them in the journal. Requires 2 * (l1 + l2) <= n.
+ */
+static void swapSegments(std::vector<int> &tour, std::vector<int> &pos, int i, int l1, int l2,
+                         std::vector<std::pair<int, int>> &journal)
+{
+    int n = (int)tour.size();
+    int last = (i + l1 + l2 - 1) % n;
+    journal.emplace_back(i, last);
+    reverseSegment(tour, pos, i, last);
+    journal.emplace_back(i, (i + l2 - 1) % n);
+    reverseSegment(tour, pos, i, (i + l2 - 1) % n);
+    journal.emplace_back((i + l2) % n, last);
+    reverseSegment(tour, pos, (i + l2) % n, last);
+}
+
+double iteratedLocalSearch(const TSPInstance &instance, std::vector<int> &tour, const std::vector<int> &neighbours, int k,
+                           SolverControl &control, unsigned seed, long long *kicks)
+{
+    int n = (int)tour.size();
+    if (kicks != nullptr)
+        *kicks = 0;
+    if (n < 8)
+        return 0;
+
+    std::mt19937 rng(seed);
+    LocalSearchWorkspace workspace;
+    double total = twoOptNeighbours(instance, tour, neighbours, k, workspace, &control);
+    // cost of the tour before the search, so that cost + total is always the cost of the current tour
+    double cost = instance.tourCost(tour) - total;
+    control.report(cost + total);
+
+    // segments of the double bridge are short, so a kick only touches a small window of the tour;
+    // at most half of the tour, so swapSegments never reverses a complement
+    int maxSegment = std::min(50, n / 4);
+    std::uniform_int_distribution<int> pickStart(0, n - 1);
+    std::uniform_int_distribution<int> pickLength(1, maxSegment);
+    std::vector<std::pair<int, int>> journal;
+    std::vector<int> touched;
+    long long count = 0;
+
+    while (!control.shouldStop())
+    {
+        double batchStart = total;
+        for (int batch = 0; batch < 64; batch++)
+        {
+            // tour = A x B y C z D with x = [p, p+l1), y = [p+l1, p+l1+l2): becomes A y x D
+            int p = pickStart(rng), l1 = pickLength(rng), l2 = pickLength(rng);
+            int before = tour[(p - 1 + n) % n];
+            int firstX = tour[p], lastX = tour[(p + l1 - 1) % n];
+            int firstY = tour[(p + l1) % n], lastY = tour[(p + l1 + l2 - 1) % n];
+            int after = tour[(p + l1 + l2) % n];
+            double delta = instance.dist(before, firstY) + instance.dist(lastY, firstX) + instance.dist(lastX, after) -
+                           instance.dist(before, firstX) - instance.dist(lastX, firstY) - instance.dist(lastY, after);
+
+            journal.clear();
+            swapSegments(tour, workspace.pos, p, l1, l2, journal);
+            touched = {before, firstX, lastX, firstY, lastY, after};
+            delta += twoOptFrom(instance, tour, neighbours, k, touched, workspace, &journal);
+            count++;
+
+            if (delta < -1e-9)
+                total += delta;
+            else
+                for (auto it = journal.rbegin(); it != journal.rend(); it++)
+                    reverseSegment(tour, workspace.pos, it->first, it->second);
+        }
+        control.report(total < batchStart ? cost + total : INF, 64);
+    }
+    if (kicks != nullptr)
+        *kicks = count;
+    return total;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file LocalSearch.h
+ * @brief This file contains the tour improvement heuristics shared by the solvers.
+ */
+
+#ifndef DAPROJECT2_LOCALSEARCH_H
+#define DAPROJECT2_LOCALSEARCH_H
+
+#include <random>
+#include <vector>
+#include "SolverControl.h"
+#include "TSPInstance.h"
+
+/**
+ * @struct LocalSearchWorkspace
+ * @brief Scratch buffers reused across local search calls, so repeated calls do not allocate.
+ */
+struct LocalSearchWorkspace
+{
+    std::vector<int> pos;      /**< Position of each vertex in the tour. */
+    std::vector<int> queue;    /**< Ring buffer with the vertices whose don't-look bit is off. */
+    std::vector<char> inQueue; /**< Whether each vertex is in the queue. */
+};
+
+/**
+ * @brief Reverses the tour between two positions, keeping the position array in sync.
+ *
+ * The segment goes forward from position i to position j (wrapping around the end of the tour).
+ * If the segment is longer than half of the tour its complement is reversed instead, which gives the same cycle.
+ *
+ * Time complexity: O(V)
+ *
+ * @param tour The tour.
+ * @param pos Position of each vertex in the tour.
+ * @param i First position of the segment.
+ * @param j Last position of the segment.
+ */
+void reverseSegment(std::vector<int> &tour, std::vector<int> &pos, int i, int j);
+
+/**
+ * @brief Improves a tour with 2-opt moves restricted to the k nearest neighbours of each vertex.
+ *
+ * Vertices are processed from a don't-look-bit queue: a vertex is only looked at again after one of its tour
+ * edges changes. The search stops at a local optimum (or when the control, if any, asks it to).
+ *
+ * Time complexity: O(V * k) per sweep of the queue, plus O(V) per applied move
+ *
+ * @param instance The instance.
+ * @param tour The tour to improve.
+ * @param neighbours The neighbour lists, as returned by TSPInstance::nearestNeighbours.
+ * @param k The number of neighbours per vertex.
+ * @param workspace Scratch buffers.
+ * @param control If not null, the search also stops, with the moves applied so far, when the control asks it to.
+ * @return The change in the tour cost (zero or negative).
+ */
+double twoOptNeighbours(const TSPInstance &instance, std::vector<int> &tour, const std::vector<int> &neighbours, int k,
+                        LocalSearchWorkspace &workspace, SolverControl *control = nullptr);
+
+/**
+ * @brief Same as the overload above, with temporary scratch buffers.
+ */
+double twoOptNeighbours(const TSPInstance &instance, std::vector<int> &tour, const std::vector<int> &neighbours, int k,
+                        SolverControl *control = nullptr);
+
+/**
+ * @brief Runs 2-opt only from the given vertices, on a tour whose positions are already in the workspace.
+ *
+ * The workspace must come from a previous call on the same tour (twoOptNeighbours or twoOptFrom), so the position
+ * array is valid and every don't-look bit is set. Only the seeds, and the vertices touched by applied moves, are examined.
+ *
+ * Time complexity: O(S * k) being S the number of examined vertices, plus O(V) per applied move
+ *
+ * @param instance The instance.
+ * @param tour The tour to improve.
+ * @param neighbours The neighbour lists, as returned by TSPInstance::nearestNeighbours.
+ * @param k The number of neighbours per vertex.
+ * @param seeds The vertices whose don't-look bits are reset.
+ * @param workspace Scratch buffers.
+ * @param journal If not null, receives the (i, j) arguments of every reverseSegment call, so the moves can be undone
+ *                by calling reverseSegment with the same arguments in reverse order.
+ * @return The change in the tour cost (zero or negative).
+ */
+double twoOptFrom(const TSPInstance &instance, std::vector<int> &tour, const std::vector<int> &neighbours, int k,
+                  const std::vector<int> &seeds, LocalSearchWorkspace &workspace, std::vector<std::pair<int, int>> *journal);
+
+/**
+ * @brief Improves a tour with iterated local search until the control stops it.
+ *
+ * The tour is first taken to a 2-opt local optimum. Then, repeatedly, a double-bridge kick swaps two short
+ * neighbouring segments and 2-opt is re-run only from the six vertices whose edges changed. The result is kept only if
+ * it is shorter; otherwise the kick and the 2-opt moves are undone in reverse order.
+ * The control is polled every 64 kicks; improvements and kicks are reported to it.
+ *
+ * Time complexity: O(k + L) per kick being L the length of the touched segments, plus O(V) per applied move
+ *
+ * @param instance The instance.
+ * @param tour The tour to improve; on return it is the best tour found.
+ * @param neighbours The neighbour lists, as returned by TSPInstance::nearestNeighbours.
+ * @param k The number of neighbours per vertex.
+ * @param control Deadline and cancellation of the search (it must have one of them, or the search never ends).
+ * @param seed Seed of the random number generator.
+ * @param kicks If not null, receives the number of kicks tried.
+ * @return The change in the tour cost (zero or negative).
+ */
+double iteratedLocalSearch(const TSPInstance &instance, std::vector<int> &tour, const std::vector<int> &neighbours, int k,
+                           SolverControl &control, unsigned seed, long long *kicks = nullptr);
+
+/**
+ * @brief Applies a random double-bridge move, splitting the tour in four segments A B C D and reconnecting them as A C B D.
+ *
+ * Time complexity: O(V)
+ *
+ * @param tour The tour to perturb.
+ * @param rng The random number generator.
+ */
+void doubleBridge(std::vector<int> &tour, std::mt19937 &rng);
+
+#endif // DAPROJECT2_LOCALSEARCH_H
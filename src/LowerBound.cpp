@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <cmath>
+#include "Constructors.h"
+#include "IndexedHeap.h"
+#include "LowerBound.h"
+#include "Partition.h"
+
+HeldKarpBound::HeldKarpBound(const TSPInstance &instance, const LowerBoundParameters &params)
+    : instance(instance), params(params), n(instance.size())
+{
+    this->k = std::max(0, std::min(params.neighbours, n - 1));
+    this->neighbours = candidateNeighbours(instance, k);
+
+    std::vector<int> tour;
+    if (k > 0)
+    {
+        tour = greedyEdgeTour(instance, neighbours, k);
+        twoOptNeighbours(instance, tour, neighbours, k);
+        this->tourCost = instance.tourCost(tour);
+    }
+
+    if (!instance.isDense() && k > 0)
+    {
+        // the neighbour relation made symmetric, plus the edges of the quick tour, which keep the graph connected
+        std::vector<std::pair<int, int>> edges;
+        edges.reserve((size_t)n * (k + 1));
+        for (int i = 0; i < n; i++)
+            for (int a = 0; a < k; a++)
+                edges.emplace_back(i, neighbours[(size_t)i * k + a]);
+        for (int i = 0; i < n; i++)
+            edges.emplace_back(tour[i], tour[(i + 1) % n]);
+
+        start.assign(n + 1, 0);
+        for (auto [i, j] : edges)
+        {
+            start[i + 1]++;
+            start[j + 1]++;
+        }
+        for (int i = 0; i < n; i++)
+            start[i + 1] += start[i];
+        adjacent.resize(start[n]);
+        weight.resize(start[n]);
+        std::vector<int> fill(start.begin(), start.end() - 1);
+        for (auto [i, j] : edges)
+        {
+            double d = instance.dist(i, j);
+            adjacent[fill[i]] = j;
+            weight[fill[i]++] = d;
+            adjacent[fill[j]] = i;
+            weight[fill[j]++] = d;
+        }
+    }
+}
+
+bool HeldKarpBound::isExact() const
+{
+    return instance.isDense();
+}
+
+int HeldKarpBound::getIterations() const
+{
+    return this->iterations;
+}
+
+const std::vector<double> &HeldKarpBound::getPenalties() const
+{
+    return this->bestPi;
+}
+
+double HeldKarpBound::denseTree(std::vector<int> &parentOf)
+{
+    const std::vector<double> &matrix = instance.getMatrix();
+    std::vector<double> key(n, INF);
+    std::vector<char> inTree(n, 0);
+    inTree[0] = 1;
+    key[1] = 0;
+    double total = 0;
+
+    for (int step = 1; step < n; step++)
+    {
+        int u = -1;
+        for (int v = 1; v < n; v++)
+            if (!inTree[v] && (u == -1 || key[v] < key[u]))
+                u = v;
+        inTree[u] = 1;
+        total += key[u];
+        const double *row = matrix.data() + (size_t)u * n;
+        for (int v = 1; v < n; v++)
+        {
+            if (inTree[v])
+                continue;
+            double d = row[v] + pi[u] + pi[v];
+            if (d < key[v])
+            {
+                key[v] = d;
+                parentOf[v] = u;
+            }
+        }
+    }
+    return total;
+}
+
+double HeldKarpBound::sparseTree(std::vector<int> &parentOf)
+{
+    std::vector<char> inTree(n, 0);
+    inTree[0] = 1;
+    double total = 0;
+    int reached = 1;
+
+    IndexedHeap<4> queue(n);
+    queue.push(1, 0);
+    while (!queue.empty())
+    {
+        int u = queue.pop();
+        inTree[u] = 1;
+        total += queue.key(u);
+        reached++;
+        for (int a = start[u]; a < start[u + 1]; a++)
+        {
+            int v = adjacent[a];
+            if (!inTree[v] && queue.pushOrDecrease(v, weight[a] + pi[u] + pi[v]))
+                parentOf[v] = u;
+        }
+    }
+    return reached == n ? total : INF;
+}
+
+double HeldKarpBound::oneTree()
+{
+    std::vector<int> parentOf(n, -1);
+    double total = instance.isDense() ? denseTree(parentOf) : sparseTree(parentOf);
+    if (total >= INF)
+        return INF;
+
+    degree.assign(n, 0);
+    for (int v = 2; v < n; v++)
+        if (parentOf[v] != -1)
+        {
+            degree[v]++;
+            degree[parentOf[v]]++;
+        }
+
+    // the two cheapest edges of vertex 0
+    double first = INF, second = INF;
+    int firstV = -1, secondV = -1;
+    auto consider = [&](int v, double d)
+    {
+        d += pi[0] + pi[v];
+        if (d < first)
+        {
+            second = first;
+            secondV = firstV;
+            first = d;
+            firstV = v;
+        }
+        else if (d < second && v != firstV)
+        {
+            second = d;
+            secondV = v;
+        }
+    };
+    if (instance.isDense())
+        for (int v = 1; v < n; v++)
+            consider(v, instance.dist(0, v));
+    else
+        for (int a = start[0]; a < start[1]; a++)
+            consider(adjacent[a], weight[a]);
+    if (secondV == -1)
+        return INF;
+
+    degree[0] = 2;
+    degree[firstV]++;
+    degree[secondV]++;
+    return total + first + second;
+}
+
+double HeldKarpBound::trivialBound() const
+{
+    if (n < 3)
+        return 0;
+
+    // every vertex has two tour edges, each at least as long as its two nearest neighbours
+    double half = 0;
+    if (k >= 2)
+        for (int v = 0; v < n; v++)
+            half += instance.dist(v, neighbours[(size_t)v * k]) + instance.dist(v, neighbours[(size_t)v * k + 1]);
+    double bound = half / 2;
+
+    // coordinate distances keep the triangle inequality, so the tour is at least twice as long as any of its chords;
+    // two sweeps for the farthest vertex find a long one
+    if (instance.hasCoordinates())
+    {
+        int a = 0;
+        for (int sweep = 0; sweep < 2; sweep++)
+        {
+            int farthest = a;
+            double longest = 0;
+            for (int v = 0; v < n; v++)
+            {
+                double d = instance.dist(a, v);
+                if (d > longest && d < INF)
+                {
+                    longest = d;
+                    farthest = v;
+                }
+            }
+            bound = std::max(bound, 2 * longest);
+            a = farthest;
+        }
+    }
+    return bound;
+}
+
+double HeldKarpBound::run(SolverControl &control, double upperBound)
+{
+    iterations = 0;
+    pi.assign(n, 0);
+    bestPi = pi;
+    if (n < 3)
+        return 0;
+
+    // Held-Karp step schedule: the step is lambda * (UB - L) / |g|^2, and lambda is halved after every period of
+    // iterations that did not improve the bound
+    upperBound = std::min(upperBound, this->tourCost);
+    int period = params.period > 0 ? params.period : std::max(n / 16, 20);
+    double best = 0, lambda = 2;
+    int inPeriod = 0;
+    bool improved = false;
+    std::vector<double> previous(n, 0);
+    while ((params.iterations <= 0 || iterations < params.iterations) && !control.shouldStop())
+    {
+        iterations++;
+        double treeCost = oneTree();
+        if (treeCost >= INF)
+            break;
+        double bound = treeCost;
+        for (int v = 0; v < n; v++)
+            bound -= 2 * pi[v];
+
+        if (bound > best + 1e-9)
+        {
+            best = bound;
+            bestPi = pi;
+            improved = true;
+        }
+        if (++inPeriod >= period)
+        {
+            if (!improved)
+                lambda /= 2;
+            inPeriod = 0;
+            improved = false;
+        }
+
+        // every vertex has degree two: the 1-tree is a tour, so it is optimal
+        double norm = 0;
+        for (int v = 0; v < n; v++)
+            norm += (double)(degree[v] - 2) * (degree[v] - 2);
+        if (norm == 0 || best >= upperBound - 1e-9 || lambda < params.minLambda)
+            break;
+
+        // the direction mixes the current and the previous subgradients, which damps the zig-zagging of the penalties
+        double step = lambda * (upperBound - bound) / norm;
+        for (int v = 0; v < n; v++)
+        {
+            double direction = 0.7 * (degree[v] - 2) + 0.3 * previous[v];
+            pi[v] += step * direction;
+            previous[v] = degree[v] - 2;
+        }
+    }
+    return std::min(best, upperBound);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file LowerBound.h
+ * @brief This file contains the Held-Karp lower bound (1-trees with subgradient optimization).
+ */
+
+#ifndef DAPROJECT2_LOWERBOUND_H
+#define DAPROJECT2_LOWERBOUND_H
+
+#include <vector>
+#include "LocalSearch.h"
+
+/**
+ * @struct LowerBoundParameters
+ * @brief Parameters of the Held-Karp lower bound.
+ */
+struct LowerBoundParameters
+{
+    int iterations = 0;       /**< Maximum number of subgradient iterations (0 for no limit but the step size and the control). */
+    int period = 0;           /**< Iterations without improvement before the step size is halved (0 for max(V / 16, 20)). */
+    double minLambda = 1e-3;  /**< Step size factor at which the optimization stops. */
+    int neighbours = 10;      /**< Size of the neighbour lists of the candidate graph of large instances. */
+};
+
+/**
+ * @class HeldKarpBound
+ * @brief Lower bound on the length of the optimal tour, from 1-trees with node penalties (Held and Karp).
+ *
+ * A 1-tree is a minimum spanning tree of the vertices other than vertex 0, plus the two cheapest edges of vertex 0.
+ * Every tour is a 1-tree, so for any penalties pi the cost of the minimum 1-tree with edge costs
+ * d(i, j) + pi[i] + pi[j], minus 2 * sum(pi), is a lower bound. The penalties are improved by subgradient optimization:
+ * vertices of degree above two in the 1-tree get more expensive and leaves get cheaper. The step follows the Held-Karp
+ * schedule, lambda * (UB - L) / |g|^2 being UB the length of a known tour, L the current bound and g the degrees minus
+ * two; lambda starts at 2 and is halved after every period (which grows with V) without a better bound.
+ *
+ * Dense instances build the 1-trees over the whole graph with the array-scan version of Prim's algorithm (O(V^2)).
+ * Large instances build them over a candidate graph with the k nearest neighbours of every vertex and the edges of a
+ * quick tour (so the graph is connected), with a 4-ary IndexedHeap.
+ * On the candidate graph the bound is an estimate: the minimum spanning tree of the candidate graph can be longer than
+ * the one of the whole graph (see isExact()).
+ */
+class HeldKarpBound
+{
+public:
+    /**
+     * @brief Constructs the bound for an instance: builds a quick tour (greedy edge and 2-opt), which gives the upper
+     * bound of the subgradient steps, and the candidate graph if the instance is not dense.
+     *
+     * @param instance The instance.
+     * @param params The parameters.
+     */
+    HeldKarpBound(const TSPInstance &instance, const LowerBoundParameters &params);
+
+    /**
+     * @brief Runs the subgradient optimization until the iteration limit, convergence, or until the control asks it to stop.
+     *
+     * Time complexity: O(I * V^2) for dense instances, O(I * V * k * log(V)) otherwise, being I the number of iterations
+     *
+     * @param control Deadline and cancellation.
+     * @param upperBound Length of a known tour (INF if none). The shorter of it and the quick tour is used.
+     * @return The best lower bound found.
+     */
+    double run(SolverControl &control, double upperBound = INF);
+
+    /**
+     * @brief Computes a quick lower bound to check the Held-Karp bound against: half the sum of the two shortest edges
+     * of every vertex and, for coordinate instances (which keep the triangle inequality), twice the length of a long
+     * chord found by two sweeps for the farthest vertex.
+     *
+     * Time complexity: O(V)
+     *
+     * @return The bound (an estimate, like the Held-Karp one, when the neighbour lists come from the grid).
+     */
+    double trivialBound() const;
+
+    /**
+     * @brief Checks whether the 1-trees were built over the whole graph, which makes the bound a true lower bound.
+     *
+     * Time complexity: O(1)
+     *
+     * @return True for dense instances.
+     */
+    bool isExact() const;
+
+    /**
+     * @brief Returns the number of iterations run by the last call to run().
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of iterations.
+     */
+    int getIterations() const;
+
+    /**
+     * @brief Returns the penalties that gave the best bound.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The penalty of every vertex.
+     */
+    const std::vector<double> &getPenalties() const;
+
+private:
+    const TSPInstance &instance;
+    LowerBoundParameters params;
+    int n;
+    int k;
+    std::vector<int> neighbours;  /**< Neighbour lists, k per vertex (quick tour and candidate graph). */
+    double tourCost = INF;        /**< Length of the quick tour. */
+    std::vector<int> start;       /**< Candidate graph in CSR form: neighbour lists and quick tour edges (empty for dense instances). */
+    std::vector<int> adjacent;
+    std::vector<double> weight;   /**< Distance of every candidate edge. */
+    std::vector<double> pi;       /**< Current penalties. */
+    std::vector<double> bestPi;   /**< Penalties of the best bound. */
+    std::vector<int> degree;      /**< Degree of every vertex in the last 1-tree. */
+    int iterations = 0;
+
+    double oneTree();
+    double denseTree(std::vector<int> &parentOf);
+    double sparseTree(std::vector<int> &parentOf);
+};
+
+#endif // DAPROJECT2_LOWERBOUND_H
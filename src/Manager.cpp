@@ -1,8 +1,21 @@
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
+#include <limits>
+#include <thread>
 #include <sstream>
 #include <chrono>
 #include "Manager.h"
+#include "Constructors.h"
+#include "ContractionHierarchy.h"
+#include "ParallelTwoOpt.h"
+#include "HeapBenchmark.h"
+#include "LowerBound.h"
+#include "Partition.h"
+#include "SolverService.h"
+#include "TSPLib.h"
+#include "TwoOptKernel.h"
 
 #ifdef _WIN32
 const std::string file_path = "";
@@ -12,120 +25,279 @@ const std::string file_path = "src/";
 
 using namespace std;
 
-Manager::Manager() = default;
+Manager::Manager()
+    : registry(file_path, DEFAULT_MEMORY_BUDGET), graph(make_shared<Graph>()), cache(file_path + "cache/") {}
 
-std::string getField(std::istringstream &line, char delim)
+void Manager::readGraph(const string &filePath, bool real)
 {
-    std::string string1, string2;
-    getline(line, string1, delim);
-    if (string1.front() == '"' && string1.back() != '"')
+    // the dynamic tour and the closure refer to the current graph, which the registry may delete once it is replaced
+    this->dynamicTour.reset();
+    this->closure.reset();
+    string error;
+    bool read;
+    ResidentGraph resident = this->registry.acquire(filePath, real, false, error, &read, this->nearest);
+    this->graphPath = filePath;
+    this->graphReal = real;
+    if (resident.graph == nullptr)
     {
-        getline(line, string2, '"');
-        string1 += string2;
-        getline(line, string2, ',');
-        return string1.substr(1);
+        cout << error << endl;
+        this->graph = make_shared<Graph>();
+        this->fingerprint = this->graph->fingerprint();
+        return;
     }
-    else
-        return string1;
+    if (!read)
+        cout << "The graph was already in memory" << endl;
+    this->graph = resident.graph;
+    this->fingerprint = resident.fingerprint;
+    this->attachOracle();
 }
 
-void Manager::readGraph(const string &filePath, bool real)
+void Manager::graphModified()
+{
+    this->fingerprint = 0;
+    this->closure.reset();
+    // the hierarchy has the shortest paths of the graph as read
+    this->graph->setDistanceOracle(nullptr);
+    this->registry.release(this->graphPath, this->graphReal, this->nearest);
+}
+
+void Manager::attachOracle()
 {
-    if (this->graph.getNumVertex() > 0)
-        this->graph.resetGraph();
-    this->graph.setReal(real);
-    bool f = true;
-    string path = file_path + filePath;
-    if (!real)
+    if (!this->oracleEnabled || this->graph->getNumVertex() == 0 || this->graph->getDistanceOracle() != nullptr)
+        return;
+    auto start = chrono::high_resolution_clock::now();
+    auto oracle = make_shared<ContractionHierarchy>();
+    string error;
+    if (!this->oracleIndex.empty() && oracle->load(file_path + this->oracleIndex, error))
     {
-        ifstream file(path);
-        string line;
-        while (getline(file, line))
+        if (oracle->getFingerprint() == this->fingerprint)
         {
-            if (f)
-            {
-                f = false;
-            }
-            else
-            {
-                string start, end, distancia;
-                istringstream s(line);
+            auto end = chrono::high_resolution_clock::now();
+            cout << "The contraction hierarchy was read from " << this->oracleIndex << " in "
+                 << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds" << endl;
+            this->graph->setDistanceOracle(oracle);
+            return;
+        }
+        cout << "The contraction hierarchy in " << this->oracleIndex << " is of another graph" << endl;
+    }
+    else if (!this->oracleIndex.empty() && filesystem::exists(file_path + this->oracleIndex))
+        cout << error << endl;
 
-                start = getField(s, ',');
-                end = getField(s, ',');
-                distancia = getField(s, ',');
+    oracle = make_shared<ContractionHierarchy>(*this->graph);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "The contraction hierarchy took: " << chrono::duration_cast<chrono::microseconds>(end - start).count()
+         << " microseconds (" << oracle->getShortcuts() << " shortcuts)" << endl;
+    this->graph->setDistanceOracle(oracle);
+    if (!this->oracleIndex.empty())
+    {
+        if (oracle->save(file_path + this->oracleIndex, error))
+            cout << "The contraction hierarchy was written to " << this->oracleIndex << endl;
+        else
+            cout << error << endl;
+    }
+}
 
-                this->graph.addVertex(stoi(start));
-                this->graph.addVertex(stoi(end));
+int Manager::commandLine(const vector<string> &args)
+{
+    string graphPath, algorithm = "2opt", servePath;
+    bool real = false;
+    double timeLimit = 30;
+    unsigned seed = 42;
+    int threads = (int)max(1u, thread::hardware_concurrency());
+    int runs = 8;
+    int clusterSize = 500;
+    int sources = 10;
+    size_t memoryBudget = DEFAULT_MEMORY_BUDGET;
+    vector<int> vertices;
 
-                this->graph.addBidirectionalEdge(stoi(start), stoi(end), stod(distancia));
-            }
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        bool hasValue = i + 1 < args.size();
+        if (args[i] == "--real")
+            real = true;
+        else if (args[i] == "--no-cache")
+            this->cacheEnabled = false;
+        else if (args[i] == "--graph" && hasValue)
+            graphPath = args[++i];
+        else if (args[i] == "--algorithm" && hasValue)
+            algorithm = args[++i];
+        else if (args[i] == "--time" && hasValue)
+            timeLimit = stod(args[++i]);
+        else if (args[i] == "--seed" && hasValue)
+            seed = (unsigned)stoul(args[++i]);
+        else if (args[i] == "--threads" && hasValue)
+            threads = stoi(args[++i]);
+        else if (args[i] == "--runs" && hasValue)
+            runs = stoi(args[++i]);
+        else if (args[i] == "--cluster-size" && hasValue)
+            clusterSize = stoi(args[++i]);
+        else if (args[i] == "--tour-output" && hasValue)
+            this->tourOutput = args[++i];
+        else if (args[i] == "--optimum" && hasValue)
+            this->optimum = stod(args[++i]);
+        else if (args[i] == "--gap" && hasValue)
+            this->gapTarget = stod(args[++i]);
+        else if (args[i] == "--no-bound")
+            this->boundEnabled = false;
+        else if (args[i] == "--bound-time" && hasValue)
+            this->boundTimeLimit = stod(args[++i]);
+        else if (args[i] == "--sources" && hasValue)
+            sources = stoi(args[++i]);
+        else if (args[i] == "--mst-threads" && hasValue)
+            this->mstThreads = max(1, stoi(args[++i]));
+        else if (args[i] == "--serve" && hasValue)
+            servePath = args[++i];
+        else if (args[i] == "--vertices" && hasValue)
+        {
+            istringstream list(args[++i]);
+            string id;
+            while (getline(list, id, ','))
+                vertices.push_back(stoi(id));
+        }
+        else if (args[i] == "--closure")
+            this->closureEnabled = true;
+        else if (args[i] == "--nearest" && hasValue)
+            this->nearest = max(0, stoi(args[++i]));
+        else if (args[i] == "--ch")
+            this->oracleEnabled = true;
+        else if (args[i] == "--ch-index" && hasValue)
+        {
+            this->oracleEnabled = true;
+            this->oracleIndex = args[++i];
+        }
+        else if (args[i] == "--memory-budget" && hasValue)
+            memoryBudget = (size_t)(stod(args[++i]) * (1 << 20));
+        else
+        {
+            cerr << "Unknown option: " << args[i] << endl;
+            return 1;
         }
     }
-    else
+
+    if (!servePath.empty())
     {
-        ifstream file(path + "nodes.csv");
-        string line;
-        while (getline(file, line))
+        // the service keeps its own graphs; --graph only loads one before the first request
+        SolverService service(file_path, threads, memoryBudget);
+        string error;
+        if (!graphPath.empty() && !service.preload(graphPath, real, error, this->nearest))
         {
-            if (f)
-            {
-                f = false;
-            }
-            else
-            {
-                string start, longi, lati;
-                istringstream s(line);
-
-                start = getField(s, ',');
-                longi = getField(s, ',');
-                lati = getField(s, ',');
-
-                this->graph.addVertex(stoi(start));
-
-                graph.findVertex(stoi(start))->setLatitude(stod(lati));
-                graph.findVertex(stoi(start))->setLongitude(stod(longi));
-            }
+            cerr << "Could not read the graph " << graphPath << ": " << error << endl;
+            return 1;
         }
-        f = true;
-        file = ifstream(path + "edges.csv");
-        while (getline(file, line))
+        if (servePath == "-")
+            service.serveStream(cin, cout);
+        else if (!service.serveSocket(servePath, error))
         {
-            if (f)
-            {
-                f = false;
-            }
-            else
-            {
-                string orig, dest, dist;
-                istringstream s(line);
+            cerr << error << endl;
+            return 1;
+        }
+        return 0;
+    }
 
-                orig = getField(s, ',');
-                dest = getField(s, ',');
-                dist = getField(s, ',');
+    if (graphPath.empty())
+    {
+        cerr << "Usage: DAProject2 --graph <path> [--real] [--algorithm backtracking|triangular|2opt|2opt-parallel|ils|ga|aco|portfolio|partition|heap-benchmark] "
+                "[--time <seconds>] [--seed <number>] [--threads <number>] [--runs <number>] [--cluster-size <number>] [--no-cache] "
+                "[--tour-output <path>] [--optimum <distance>] [--gap <percent>] [--no-bound] [--bound-time <seconds>] [--sources <number>] [--mst-threads <number>] [--closure] [--ch] [--ch-index <path>] [--nearest <k>]\n"
+                "       DAProject2 --serve <socket path>|- [--graph <path> [--real] [--nearest <k>]] [--threads <number>] [--memory-budget <megabytes>]\n"
+                "       DAProject2 --graph <path> [--real] --vertices <id,id,...> [--algorithm triangular|2opt|ils|ga|aco|portfolio|partition] "
+                "[--time <seconds>] [--seed <number>] [--threads <number>] [--closure]" << endl;
+        return 1;
+    }
+    this->registry.setBudget(memoryBudget);
+    this->closureThreads = max(1, threads);
+    if (this->closureEnabled)
+        this->cacheEnabled = false;
+    this->readGraph(graphPath, real);
+    if (this->graph->getNumVertex() == 0)
+    {
+        cerr << "Could not read the graph " << graphPath << endl;
+        return 1;
+    }
 
-                this->graph.addBidirectionalEdge(stoi(orig), stoi(dest), stod(dist));
-            }
-        }
+    if (!vertices.empty())
+    {
+        SolveOptions options;
+        options.algorithm = algorithm;
+        options.seed = seed;
+        options.threads = threads;
+        options.closure = this->closureEnabled;
+        this->runSubset(vertices, options, timeLimit);
     }
+    else if (algorithm == "backtracking")
+        this->runBacktracking(timeLimit);
+    else if (algorithm == "triangular")
+        this->TSPTriangularApproximation();
+    else if (algorithm == "2opt")
+        this->runTwoOpt(timeLimit);
+    else if (algorithm == "2opt-parallel")
+        this->runParallelTwoOpt(threads, timeLimit);
+    else if (algorithm == "ils")
+        this->runIteratedLocalSearch(timeLimit, seed);
+    else if (algorithm == "ga")
+    {
+        GeneticParameters params;
+        params.seed = seed;
+        params.islands = threads;
+        this->runGeneticAlgorithm(params, timeLimit);
+    }
+    else if (algorithm == "aco")
+    {
+        AntColonyParameters params;
+        params.seed = seed;
+        params.threads = threads;
+        this->runAntColony(params, timeLimit);
+    }
+    else if (algorithm == "portfolio")
+    {
+        PortfolioParameters params;
+        params.seed = seed;
+        params.threads = threads;
+        params.runs = runs;
+        this->runPortfolio(params, timeLimit);
+    }
+    else if (algorithm == "partition")
+    {
+        PartitionParameters params;
+        params.threads = threads;
+        params.clusterSize = clusterSize;
+        this->runPartition(params, timeLimit);
+    }
+    else if (algorithm == "heap-benchmark")
+        this->runHeapBenchmark(sources);
+    else
+    {
+        cerr << "Unknown algorithm: " << algorithm << endl;
+        return 1;
+    }
+    return 0;
 }
 
 void Manager::mainMenu()
 {
     int i = 0, n;
-    while (i != 5)
+    while (i != 14)
     {
         cout << "------------MENU PRINCIPAL----------" << endl;
         cout << "Selecione uma opcao: \n";
         cout << "1: Escolher grafo\n";
-        if (this->graph.getNumVertex() > 0)
+        if (this->graph->getNumVertex() > 0)
         {
             cout << "2: Calcular TSP usando Backtracking \n";
             cout << "3: Calcular TSP usando aproximação triangular \n";
             cout << "4: Calcular TSP usando aproximação triangular e otimizado por 2-opt\n";
+            cout << "5: Calcular TSP usando algoritmo genetico paralelo\n";
+            cout << "6: Calcular TSP usando colonia de formigas (MMAS)\n";
+            cout << "7: Calcular TSP usando 2-opt seguido de pesquisa local iterada\n";
+            cout << "8: Calcular TSP usando portfolio de execucoes paralelas\n";
+            cout << "9: Calcular TSP usando aproximação triangular e 2-opt paralelo (melhor melhoria)\n";
+            cout << "10: Inserir e remover cidades num percurso resolvido\n";
+            cout << "11: Calcular TSP por particao espacial (grafos do mundo real grandes)\n";
+            cout << "12: Comparar filas de prioridade (Dijkstra)\n";
+            cout << "13: Calcular TSP num subconjunto de vertices\n";
         }
-        cout << "5: Sair \n";
-        n = (int)this->graph.getNumVertex();
+        cout << "14: Sair \n";
+        n = (int)this->graph->getNumVertex();
         cout << "Numero de vertices carregados: " << n << endl;
         cout << "opcao: ";
         cin >> i;
@@ -135,18 +307,54 @@ void Manager::mainMenu()
             this->readGraphMenu();
             break;
         case 2:
-            if(this->graph.getNumVertex() > 0)
+            if(this->graph->getNumVertex() > 0)
                 this->TSPBacktracking();
             break;
         case 3:
-            if(this->graph.getNumVertex() > 0)
+            if(this->graph->getNumVertex() > 0)
                 this->TSPTriangularApproximation();
             break;
         case 4:
-            if(this->graph.getNumVertex() > 0)
+            if(this->graph->getNumVertex() > 0)
                 this->twoOpt();
             break;
         case 5:
+            if(this->graph->getNumVertex() > 0)
+                this->geneticAlgorithm();
+            break;
+        case 6:
+            if(this->graph->getNumVertex() > 0)
+                this->antColony();
+            break;
+        case 7:
+            if(this->graph->getNumVertex() > 0)
+                this->TSPIteratedLocalSearch();
+            break;
+        case 8:
+            if(this->graph->getNumVertex() > 0)
+                this->portfolio();
+            break;
+        case 9:
+            if(this->graph->getNumVertex() > 0)
+                this->parallelTwoOpt();
+            break;
+        case 10:
+            if(this->graph->getNumVertex() > 0)
+                this->dynamicTourMenu();
+            break;
+        case 11:
+            if(this->graph->getNumVertex() > 0)
+                this->partition();
+            break;
+        case 12:
+            if(this->graph->getNumVertex() > 0)
+                this->heapBenchmark();
+            break;
+        case 13:
+            if(this->graph->getNumVertex() > 0)
+                this->subsetTour();
+            break;
+        case 14:
             cout << "A sair..." << endl;
             break;
         default:
@@ -169,7 +377,7 @@ Vertex *Manager::inputNode(const string &message)
         {
             return nullptr;
         }
-        temp = this->graph.findVertex(i);
+        temp = this->graph->findVertex(i);
         if (temp != nullptr)
         {
             return temp;
@@ -182,15 +390,18 @@ Vertex *Manager::inputNode(const string &message)
 void Manager::readGraphMenu()
 {
     int i = 0, n;
-    while (i != 4)
+    string tspPath;
+    while (i != 6)
     {
         cout << "------------MENU ESCOLHA DE GRAFO----------" << endl;
         cout << "Selecione uma opcao: \n";
         cout << "1: Grafos de brinquedo\n";
         cout << "2: Grafos totalmente conectados\n";
         cout << "3: Grafos do mundo real\n";
-        cout << "4: Sair \n";
-        n = (int)this->graph.getNumVertex();
+        cout << "4: Ficheiro TSPLIB (.tsp)\n";
+        cout << "5: Grafos em memoria\n";
+        cout << "6: Sair \n";
+        n = (int)this->graph->getNumVertex();
         cout << "Numero de vertices carregados: " << n << endl;
         cout << "opcao: ";
         cin >> i;
@@ -198,17 +409,27 @@ void Manager::readGraphMenu()
         {
         case 1:
             toyGraphMenu();
-            i = 4;
+            i = 6;
             break;
         case 2:
             fullyConnectedGraphMenu();
-            i = 4;
+            i = 6;
             break;
         case 3:
             realWorldGraphMenu();
-            i = 4;
+            i = 6;
             break;
         case 4:
+            cout << "Caminho do ficheiro (relativo a " << file_path << "): ";
+            cin >> tspPath;
+            this->readGraph(tspPath, false);
+            i = 6;
+            break;
+        case 5:
+            residentGraphMenu();
+            i = 6;
+            break;
+        case 6:
             cout << "A sair..." << endl;
             break;
         default:
@@ -217,6 +438,27 @@ void Manager::readGraphMenu()
     }
 }
 
+void Manager::residentGraphMenu()
+{
+    vector<RegistryEntry> entries = this->registry.list();
+    if (entries.empty())
+    {
+        cout << "Nenhum grafo em memoria" << endl;
+        return;
+    }
+    cout << "------------GRAFOS EM MEMORIA----------" << endl;
+    for (int e = 0; e < (int)entries.size(); e++)
+        cout << e + 1 << ": " << entries[e].path << " (" << entries[e].vertices << " vertices, "
+             << (entries[e].nearest > 0 ? to_string(entries[e].nearest) + " vizinhos mais proximos, " : "")
+             << entries[e].bytes / 1024 << " KiB)" << endl;
+    cout << "Memoria usada: " << this->registry.getMemoryUsage() / 1024 << " KiB" << endl;
+    int i;
+    cout << "Numero do grafo ('0' para cancelar): ";
+    cin >> i;
+    if (i >= 1 && i <= (int)entries.size())
+        this->readGraph(entries[i - 1].path, entries[i - 1].real);
+}
+
 void Manager::toyGraphMenu()
 {
     int i = 0, n;
@@ -228,7 +470,7 @@ void Manager::toyGraphMenu()
         cout << "2: Grafo de estadios\n";
         cout << "3: Grafo de turismo\n";
         cout << "4: Sair \n";
-        n = (int)this->graph.getNumVertex();
+        n = (int)this->graph->getNumVertex();
         cout << "Numero de vertices carregados: " << n << endl;
         cout << "opcao: ";
         cin >> i;
@@ -275,7 +517,7 @@ void Manager::fullyConnectedGraphMenu()
         cout << "11: Grafo de 800 vertices\n";
         cout << "12: Grafo de 900 vertices\n";
         cout << "13: Sair \n";
-        n = (int)this->graph.getNumVertex();
+        n = (int)this->graph->getNumVertex();
         cout << "Numero de vertices carregados: " << n << endl;
         cout << "opcao: ";
         cin >> i;
@@ -349,7 +591,7 @@ void Manager::realWorldGraphMenu()
         cout << "2: Grafo 2\n";
         cout << "3: Grafo 3\n";
         cout << "4: Sair \n";
-        n = (int)this->graph.getNumVertex();
+        n = (int)this->graph->getNumVertex();
         cout << "Numero de vertices carregados: " << n << endl;
         cout << "opcao: ";
         cin >> i;
@@ -377,8 +619,18 @@ void Manager::realWorldGraphMenu()
     }
 }
 
-void Manager::TSPBacktracking() {
-    Vertex* startNode = graph.findVertex(0);
+void Manager::TSPBacktracking()
+{
+    double timeLimit;
+    cout << "Tempo limite (segundos, 0 = sem limite): ";
+    cin >> timeLimit;
+    cout << endl;
+    this->runBacktracking(timeLimit);
+}
+
+void Manager::runBacktracking(double timeLimit)
+{
+    Vertex* startNode = graph->findVertex(0);
     if (startNode == nullptr) {
         std::cout << "Node 0 does not exist." << std::endl;
         return;
@@ -389,10 +641,39 @@ void Manager::TSPBacktracking() {
     double minCost = std::numeric_limits<double>::max();
     std::vector<Vertex *> bestPath;
 
+    // a cached tour is an upper bound from the start, so only cheaper tours are explored
+    TSPInstance instance = this->graphInstance();
+    double target = gapTargetCost(instance);
+    vector<int> cached;
+    if (warmStart(instance, cached))
+    {
+        rotate(cached.begin(), find(cached.begin(), cached.end(), instance.getIndex(0)), cached.end());
+        minCost = instance.tourCost(cached);
+        for (int v : cached)
+            bestPath.push_back(this->graph->findVertex(instance.getId(v)));
+        bestPath.push_back(startNode);
+    }
+
+    SolverControl control(timeLimit);
+    InterruptGuard guard(control);
+    control.setTarget(target);
+    showProgress(control);
+    long long nodes = 0;
+
     auto start = chrono::high_resolution_clock::now();
-    TSPBacktrackingRecursive(startNode, visitedNodes, 0, minCost, bestPath);
+    TSPBacktrackingRecursive(startNode, visitedNodes, 0, minCost, bestPath, control, nodes);
     auto end = chrono::high_resolution_clock::now();
     auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
+    control.stopReporting();
+
+    if (control.isCancelled())
+        cout << "The search was stopped before it finished: the path is the best one found so far." << endl;
+    if (bestPath.empty())
+    {
+        cout << "No tour found" << endl;
+        cout << "The execution time was: " << duration.count() << " microseconds" << endl;
+        return;
+    }
 
     std::cout << "The TSP path is: ";
     for (int i = 0; i < bestPath.size() - 1; i++)
@@ -402,12 +683,25 @@ void Manager::TSPBacktracking() {
     std::cout << bestPath.front()->getId() << std::endl;
     std::cout << "The total distance is: " << minCost << std::endl;
     cout << "The execution time was: " << duration.count() << " microseconds" << endl;
+
+    bestPath.pop_back();
+    finishTour(instance, instance.toTour(bestPath));
 }
 
 void Manager::TSPBacktrackingRecursive(Vertex *currNode, std::vector<Vertex *> &visitedNodes, double currCost,
-                                       double &minCost, std::vector<Vertex *> &bestPath)
+                                       double &minCost, std::vector<Vertex *> &bestPath, SolverControl &control, long long &nodes)
 {
-    if (visitedNodes.size() == graph.getNumVertex())
+    // the clock is only read every 1024 nodes; once the deadline passed, cancelling makes every level return at once
+    if ((++nodes & 1023) == 0)
+    {
+        control.report(INF, 1024);
+        if (control.shouldStop())
+            control.cancel();
+    }
+    if (control.isCancelled())
+        return;
+
+    if (visitedNodes.size() == graph->getNumVertex())
     {
         double pathCost = currCost;
         Edge *edge = currNode->findEdge(visitedNodes.front());
@@ -422,6 +716,7 @@ void Manager::TSPBacktrackingRecursive(Vertex *currNode, std::vector<Vertex *> &
                 minCost = pathCost;
                 bestPath = visitedNodes;
                 bestPath.push_back(visitedNodes.front());
+                control.report(minCost);
             }
         }
         return;
@@ -436,7 +731,7 @@ void Manager::TSPBacktrackingRecursive(Vertex *currNode, std::vector<Vertex *> &
             }
             if (pathCost < minCost)
             {
-                TSPBacktrackingRecursive(nextNode, visitedNodes, pathCost, minCost, bestPath);
+                TSPBacktrackingRecursive(nextNode, visitedNodes, pathCost, minCost, bestPath, control, nodes);
             }
             visitedNodes.pop_back();
         }
@@ -447,18 +742,19 @@ void Manager::TSPTriangularApproximation()
 {
     Vertex *lastVertex = nullptr;
     auto start = chrono::high_resolution_clock::now();
-    graph.prim();
+    this->spanningTree();
 
     cout << "\nThe TSP path is: ";
     vector<Vertex *> path;
-    double total = graph.dfs(graph.findVertex(0), &lastVertex, path);
-    total += lastVertex->getDistTo(this->graph.findVertex(0));
+    double total = graph->dfs(graph->findVertex(0), &lastVertex, path, this->scratch);
+    double back = graph->pathCost({lastVertex, graph->findVertex(0)});
+    total = total < 0 || back < 0 ? -1 : total + back;
 
     auto end = chrono::high_resolution_clock::now();
     auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
 
     cout << "The TSP path is: ";
-    if (this->graph.getNumVertex() <= 100)
+    if (this->graph->getNumVertex() <= 100)
     {
         for (auto v : path)
         {
@@ -468,62 +764,843 @@ void Manager::TSPTriangularApproximation()
     }
     cout << "The total distance is: " << total << endl;
     cout << "The execution time was: " << duration.count() << " microseconds" << endl;
+
+    TSPInstance instance = this->graphInstance();
+    vector<int> tour = instance.toTour(path);
+    if ((int)tour.size() == instance.size())
+        finishTour(instance, tour);
 }
 
 void Manager::twoOpt()
+{
+    this->runTwoOpt(0);
+}
+
+void Manager::runTwoOpt(double timeLimit)
 {
     vector<Vertex *> path;
-    Vertex *lastVertex = nullptr;
+
+    TSPInstance instance = this->graphInstance();
+    double target = gapTargetCost(instance);
 
     auto start = chrono::high_resolution_clock::now();
 
-    graph.prim();
-    double total = graph.dfs(graph.findVertex(0), &lastVertex, path);
-    total += lastVertex->getDistTo(this->graph.findVertex(0));
+    triangularApproximationPath(path);
+    vector<int> tour = instance.toTour(path);
+    completeTour(instance, tour);
+    warmStart(instance, tour);
+    double total = instance.tourCost(tour);
     double oldTotal = total;
 
     auto middle = chrono::high_resolution_clock::now();
 
-    bool foundImprovement = true;
-    int n = path.size();
+    // closed tour (the first vertex repeated at the end) and the cached lengths of its edges
+    int n = tour.size();
+    tour.push_back(tour[0]);
+    vector<double> edges;
+    tourEdges(instance, tour, edges);
+
+    SolverControl control(timeLimit);
+    InterruptGuard guard(control);
+    control.setTarget(target);
+    showProgress(control);
+    control.report(total);
+
+    const int block = 64;
+    bool foundImprovement = n >= 4;
     double epsilon = 1e-9;
     while (foundImprovement)
     {
         foundImprovement = false;
-        for (int i = 0; i <= n - 2; i++)
+        for (int i = 0; i <= n - 3; i++)
         {
-            for (int j = i + 1; j <= n - 1; j++)
+            if (control.shouldStop())
+            {
+                foundImprovement = false;
+                break;
+            }
+            int lastJ = i == 0 ? n - 2 : n - 1;
+            for (int jBegin = i + 2; jBegin <= lastJ; jBegin += block)
             {
-                double lengthDelta =
-                    this->graph.getDistance(path[i], path[j]) + this->graph.getDistance(path[(i + 1) % n], path[(j + 1) % n]) - this->graph.getDistance(path[i], path[(i + 1) % n]) - this->graph.getDistance(path[j], path[(j + 1) % n]);
-                if (lengthDelta < -epsilon)
+                double lengthDelta = -epsilon;
+                int j = bestTwoOptMove(instance, tour, edges, i, jBegin, min(jBegin + block, lastJ + 1), lengthDelta);
+                if (j != -1)
                 {
-                    reverse(path.begin() + i + 1, path.begin() + j + 1);
+                    reverse(tour.begin() + i + 1, tour.begin() + j + 1);
+                    reverse(edges.begin() + i + 1, edges.begin() + j);
+                    edges[i] = instance.dist(tour[i], tour[i + 1]);
+                    edges[j] = instance.dist(tour[j], tour[j + 1]);
                     total += lengthDelta;
                     foundImprovement = true;
+                    control.report(total, 1);
                 }
             }
         }
     }
+    tour.pop_back();
+    control.stopReporting();
 
     auto end = chrono::high_resolution_clock::now();
     auto duration1 = chrono::duration_cast<chrono::microseconds>(middle - start);
     auto duration2 = chrono::duration_cast<chrono::microseconds>(end - middle);
 
-    if (this->graph.getNumVertex() <= 100)
+    if (this->graph->getNumVertex() <= 100)
     {
         cout << "The TSP path is: ";
-        for (auto v : path)
+        for (auto v : tour)
         {
-            cout << v->getId() << " -> ";
+            cout << instance.getId(v) << " -> ";
         }
-        cout << "0" << endl;
+        cout << instance.getId(tour.front()) << endl;
     }
 
     cout << "The total distance without 2-opt was: " << oldTotal << endl;
     cout << "The total distance with 2-opt is: " << total << endl;
     cout << "2-opt reduced the path cost in: " << oldTotal - total << endl;
+    if (control.shouldStop())
+        cout << "2-opt was stopped before reaching a local optimum." << endl;
 
     cout << "The path creation with triangular approximation took: " << duration1.count() << " microseconds" << endl;
     cout << "The path improvement took with 2-opt: " << duration2.count() << " microseconds" << endl;
+    finishTour(instance, tour);
+}
+
+void Manager::spanningTree()
+{
+    if (this->mstThreads > 1)
+        graph->boruvka(this->mstThreads, this->scratch);
+    else
+        graph->prim(this->scratch);
+}
+
+double Manager::triangularApproximationPath(vector<Vertex *> &path)
+{
+    Vertex *lastVertex = nullptr;
+    this->spanningTree();
+    double total = graph->dfs(graph->findVertex(0), &lastVertex, path, this->scratch);
+    double back = graph->pathCost({lastVertex, graph->findVertex(0)});
+    total = total < 0 || back < 0 ? -1 : total + back;
+    return total;
+}
+
+void Manager::printTour(const TSPInstance &instance, vector<int> tour)
+{
+    int first = instance.getIndex(0);
+    auto it = find(tour.begin(), tour.end(), first);
+    if (it != tour.end())
+        rotate(tour.begin(), it, tour.end());
+
+    if (instance.size() <= 100)
+    {
+        cout << "The TSP path is: ";
+        for (int v : tour)
+        {
+            cout << instance.getId(v) << " -> ";
+        }
+        cout << instance.getId(tour.front()) << endl;
+    }
+    cout << "The total distance is: " << instance.tourCost(tour) << endl;
+}
+
+uint64_t Manager::graphFingerprint()
+{
+    if (this->fingerprint == 0)
+        this->fingerprint = this->graph->fingerprint();
+    return this->fingerprint;
+}
+
+bool Manager::warmStart(const TSPInstance &instance, vector<int> &tour)
+{
+    vector<int> ids;
+    double cost;
+    if (!this->cacheEnabled || !this->cache.load(graphFingerprint(), ids, cost) || (int)ids.size() != instance.size())
+        return false;
+
+    vector<int> cached;
+    vector<char> seen(instance.size(), 0);
+    for (int id : ids)
+    {
+        int v = instance.getIndex(id);
+        if (v == -1 || seen[v])
+            return false;
+        seen[v] = 1;
+        cached.push_back(v);
+    }
+    double cachedTotal = instance.tourCost(cached);
+    if (!tour.empty() && cachedTotal >= instance.tourCost(tour))
+        return false;
+
+    tour = cached;
+    cout << "Warm start from the cached tour with distance " << cachedTotal << endl;
+    return true;
+}
+
+void Manager::updateCache(const TSPInstance &instance, const vector<int> &tour)
+{
+    double total = instance.tourCost(tour);
+    if (!this->cacheEnabled || tour.empty() || (int)tour.size() != instance.size() || total >= INF)
+        return;
+    vector<int> ids;
+    for (int v : tour)
+        ids.push_back(instance.getId(v));
+    if (this->cache.store(graphFingerprint(), ids, total))
+        cout << "The cached tour of this graph was improved" << endl;
+}
+
+double Manager::lowerBound(const TSPInstance &instance, double upperBound)
+{
+    if (!this->boundEnabled)
+        return 0;
+    if (this->boundFingerprint != graphFingerprint())
+    {
+        auto start = chrono::high_resolution_clock::now();
+        vector<int> ids;
+        double cached;
+        if (this->cacheEnabled && this->cache.load(graphFingerprint(), ids, cached))
+            upperBound = min(upperBound, cached);
+
+        // the bound has its own time limit, apart from the deadline of the solvers
+        SolverControl boundControl(this->boundTimeLimit);
+        HeldKarpBound heldKarp(instance, LowerBoundParameters());
+        double result = heldKarp.run(boundControl, upperBound);
+        double trivial = heldKarp.trivialBound();
+        auto end = chrono::high_resolution_clock::now();
+
+        this->bound = max(result < INF ? result : 0, trivial);
+        this->boundFingerprint = graphFingerprint();
+        cout << "The lower bound is: " << this->bound << (heldKarp.isExact() ? "" : " (estimate on the neighbour lists)")
+             << " | " << heldKarp.getIterations() << " iterations | "
+             << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds" << endl;
+        if (trivial > result)
+            cout << "The Held-Karp bound (" << result << ") did not reach the trivial bound, which is used instead" << endl;
+    }
+    return this->bound;
+}
+
+double Manager::gapTargetCost(const TSPInstance &instance)
+{
+    if (this->gapTarget <= 0)
+        return -1;
+    double lower = lowerBound(instance, INF);
+    return lower > 0 ? lower * (1 + this->gapTarget / 100) : -1;
+}
+
+TSPInstance Manager::graphInstance()
+{
+    if (!this->closureEnabled)
+        return TSPInstance::fromGraph(*this->graph);
+    if (this->graph->getNumVertex() > TSPInstance::DENSE_LIMIT)
+    {
+        // the closure is a dense matrix of every pair of vertices
+        cout << "The metric closure of the whole graph is limited to " << TSPInstance::DENSE_LIMIT
+             << " vertexes (a subset given with --vertices gets its own); using the graph edges" << endl;
+        return TSPInstance::fromGraph(*this->graph);
+    }
+    if (this->closure == nullptr)
+    {
+        auto start = chrono::high_resolution_clock::now();
+        vector<int> ids;
+        for (Vertex *v : this->graph->getVertices())
+            ids.push_back(v->getId());
+        sort(ids.begin(), ids.end());
+        this->closure = make_unique<MetricClosure>(*this->graph, ids, this->closureThreads);
+        auto end = chrono::high_resolution_clock::now();
+        cout << "The metric closure took: " << chrono::duration_cast<chrono::microseconds>(end - start).count()
+             << " microseconds" << endl;
+    }
+    return this->closure->toInstance();
+}
+
+void Manager::finishTour(const TSPInstance &instance, const vector<int> &tour)
+{
+    updateCache(instance, tour);
+    double total = instance.tourCost(tour);
+    if (tour.empty() || (int)tour.size() != instance.size() || total >= INF)
+        return;
+
+    // the closure has the vertices sorted by ID, like the instance, so their indexes match
+    if (this->closure != nullptr && this->closure->size() == instance.size())
+    {
+        vector<int> rotated = tour;
+        auto first = find(rotated.begin(), rotated.end(), instance.getIndex(0));
+        if (first != rotated.end())
+            rotate(rotated.begin(), first, rotated.end());
+        printWalk(this->closure->expandTour(rotated));
+    }
+
+    if (this->optimum > 0)
+        cout << "Optimality gap: " << (total - this->optimum) / this->optimum * 100 << "%" << endl;
+    double lower = lowerBound(instance, total);
+    if (lower > 0)
+    {
+        double gap = (total - lower) / lower * 100;
+        cout << "Gap to the lower bound: " << (gap < 1e-9 ? 0 : gap) << "%" << endl;
+    }
+
+    if (!this->tourOutput.empty())
+    {
+        vector<int> ids;
+        for (int v : tour)
+            ids.push_back(instance.getId(v));
+        string name = this->tourOutput.substr(this->tourOutput.find_last_of("/\\") + 1);
+        if (writeTSPLibTour(this->tourOutput, name, ids, total))
+            cout << "The tour was written to " << this->tourOutput << endl;
+        else
+            cout << "Could not write the tour to " << this->tourOutput << endl;
+    }
+}
+
+void Manager::printWalk(const vector<int> &walk)
+{
+    if (walk.size() <= 200)
+    {
+        cout << "The walk over the graph edges is: ";
+        for (size_t k = 0; k < walk.size(); k++)
+            cout << walk[k] << (k + 1 < walk.size() ? " -> " : "\n");
+    }
+    cout << "The walk uses " << walk.size() - 1 << " edges of the graph" << endl;
+}
+
+void Manager::showProgress(SolverControl &control)
+{
+    control.startReporting([](const ProgressSnapshot &progress)
+    {
+        cout << "Progress: best distance ";
+        if (progress.bestCost == INF)
+            cout << "-";
+        else
+            cout << progress.bestCost;
+        cout << " | " << (long long)progress.movesPerSecond << " moves/s | " << progress.elapsed << " s" << endl;
+    });
+}
+
+void Manager::geneticAlgorithm()
+{
+    GeneticParameters params;
+    double timeLimit;
+    cout << "Tempo limite (segundos): ";
+    cin >> timeLimit;
+    cout << "Numero de ilhas (threads): ";
+    cin >> params.islands;
+    cout << endl;
+    this->runGeneticAlgorithm(params, timeLimit);
+}
+
+void Manager::runGeneticAlgorithm(const GeneticParameters &params, double timeLimit)
+{
+    TSPInstance instance = this->graphInstance();
+    double target = gapTargetCost(instance);
+
+    auto start = chrono::high_resolution_clock::now();
+
+    vector<Vertex *> path;
+    double seedTotal = triangularApproximationPath(path);
+
+    auto middle = chrono::high_resolution_clock::now();
+
+    vector<int> seed = instance.toTour(path);
+    completeTour(instance, seed);
+    seedTotal = instance.tourCost(seed);
+    warmStart(instance, seed);
+
+    SolverControl control(timeLimit);
+    InterruptGuard guard(control);
+    control.setTarget(target);
+    showProgress(control);
+    GeneticAlgorithm ga(instance, params);
+    vector<int> tour = ga.run(seed, control);
+    control.stopReporting();
+
+    auto end = chrono::high_resolution_clock::now();
+    auto duration1 = chrono::duration_cast<chrono::microseconds>(middle - start);
+    auto duration2 = chrono::duration_cast<chrono::microseconds>(end - middle);
+
+    printTour(instance, tour);
+    cout << "The total distance of the triangular approximation seed was: " << seedTotal << endl;
+    cout << "Generations per island: " << ga.getGenerations() << endl;
+    cout << "The seeding with triangular approximation took: " << duration1.count() << " microseconds" << endl;
+    cout << "The genetic algorithm took: " << duration2.count() << " microseconds" << endl;
+    finishTour(instance, tour);
+}
+
+void Manager::antColony()
+{
+    AntColonyParameters params;
+    double timeLimit;
+    cout << "Tempo limite (segundos): ";
+    cin >> timeLimit;
+    cout << "Numero de threads: ";
+    cin >> params.threads;
+    cout << "Semente aleatoria: ";
+    cin >> params.seed;
+    cout << endl;
+    this->runAntColony(params, timeLimit);
+}
+
+void Manager::runAntColony(const AntColonyParameters &params, double timeLimit)
+{
+    if (this->graph->getNumVertex() > AntColony::MAX_VERTICES)
+    {
+        cout << "The graph is too large for the ant colony (at most " << AntColony::MAX_VERTICES << " vertexes)." << endl;
+        return;
+    }
+
+    TSPInstance instance = this->graphInstance();
+    double target = gapTargetCost(instance);
+
+    auto start = chrono::high_resolution_clock::now();
+
+    vector<Vertex *> path;
+    triangularApproximationPath(path);
+    vector<int> seed = instance.toTour(path);
+    completeTour(instance, seed);
+    double triangularTotal = instance.tourCost(seed);
+    warmStart(instance, seed);
+
+    auto middle = chrono::high_resolution_clock::now();
+
+    SolverControl control(timeLimit);
+    InterruptGuard guard(control);
+    control.setTarget(target);
+    showProgress(control);
+    AntColony colony(instance, params);
+    vector<int> tour = colony.run(seed, control);
+    control.stopReporting();
+
+    auto end = chrono::high_resolution_clock::now();
+    auto duration1 = chrono::duration_cast<chrono::microseconds>(middle - start);
+    auto duration2 = chrono::duration_cast<chrono::microseconds>(end - middle);
+
+    printTour(instance, tour);
+    cout << "The total distance of the triangular approximation was: " << triangularTotal << endl;
+    cout << "Iterations: " << colony.getIterations() << endl;
+    cout << "The setup with triangular approximation took: " << duration1.count() << " microseconds" << endl;
+    cout << "The ant colony took: " << duration2.count() << " microseconds" << endl;
+    finishTour(instance, tour);
+}
+
+void Manager::TSPIteratedLocalSearch()
+{
+    double timeLimit;
+    unsigned seed;
+    cout << "Tempo limite (segundos): ";
+    cin >> timeLimit;
+    cout << "Semente aleatoria: ";
+    cin >> seed;
+    cout << endl;
+    this->runIteratedLocalSearch(timeLimit, seed);
+}
+
+void Manager::runIteratedLocalSearch(double timeLimit, unsigned seed)
+{
+    TSPInstance instance = this->graphInstance();
+    double target = gapTargetCost(instance);
+
+    auto start = chrono::high_resolution_clock::now();
+
+    vector<Vertex *> path;
+    triangularApproximationPath(path);
+    vector<int> tour = instance.toTour(path);
+    completeTour(instance, tour);
+    double triangularTotal = instance.tourCost(tour);
+    warmStart(instance, tour);
+
+    int k = 10;
+    vector<int> neighbours = instance.nearestNeighbours(k);
+    k = min(k, instance.size() - 1);
+
+    auto middle = chrono::high_resolution_clock::now();
+
+    twoOptNeighbours(instance, tour, neighbours, k);
+    double twoOptTotal = instance.tourCost(tour);
+
+    auto middle2 = chrono::high_resolution_clock::now();
+
+    SolverControl control(timeLimit);
+    InterruptGuard guard(control);
+    control.setTarget(target);
+    showProgress(control);
+    long long kicks;
+    iteratedLocalSearch(instance, tour, neighbours, k, control, seed, &kicks);
+    control.stopReporting();
+
+    auto end = chrono::high_resolution_clock::now();
+    auto duration1 = chrono::duration_cast<chrono::microseconds>(middle - start);
+    auto duration2 = chrono::duration_cast<chrono::microseconds>(middle2 - middle);
+    auto duration3 = chrono::duration_cast<chrono::microseconds>(end - middle2);
+
+    printTour(instance, tour);
+    cout << "The total distance with triangular approximation was: " << triangularTotal << endl;
+    cout << "The total distance with 2-opt was: " << twoOptTotal << endl;
+    cout << "Double-bridge kicks tried: " << kicks << endl;
+    cout << "The path creation with triangular approximation took: " << duration1.count() << " microseconds" << endl;
+    cout << "The path improvement with 2-opt took: " << duration2.count() << " microseconds" << endl;
+    cout << "The iterated local search took: " << duration3.count() << " microseconds" << endl;
+    finishTour(instance, tour);
+}
+
+void Manager::portfolio()
+{
+    PortfolioParameters params;
+    double timeLimit;
+    cout << "Tempo limite (segundos): ";
+    cin >> timeLimit;
+    cout << "Numero de execucoes: ";
+    cin >> params.runs;
+    cout << "Numero de threads: ";
+    cin >> params.threads;
+    cout << endl;
+    this->runPortfolio(params, timeLimit);
+}
+
+void Manager::runPortfolio(const PortfolioParameters &params, double timeLimit)
+{
+    TSPInstance instance = this->graphInstance();
+    double target = gapTargetCost(instance);
+
+    auto start = chrono::high_resolution_clock::now();
+    SolverControl control(timeLimit);
+    InterruptGuard guard(control);
+    control.setTarget(target);
+    showProgress(control);
+    Portfolio solver(instance, params);
+    vector<int> tour = solver.run(control);
+    control.stopReporting();
+    auto end = chrono::high_resolution_clock::now();
+    auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
+
+    const vector<PortfolioRun> &runs = solver.getRuns();
+    for (int r = 0; r < (int)runs.size(); r++)
+    {
+        cout << "Run " << r << " (" << (runs[r].constructor.empty() ? "not started" : runs[r].constructor);
+        if (runs[r].start != -1)
+            cout << ", start " << instance.getId(runs[r].start);
+        cout << ", seed " << runs[r].seed;
+        if (runs[r].restartedFrom != -1)
+            cout << ", continued from run " << runs[r].restartedFrom;
+        cout << "): ";
+        if (runs[r].cost == INF)
+            cout << "cancelled" << endl;
+        else
+            cout << runs[r].cost << (r == solver.getBestRun() ? " (best)" : "") << endl;
+    }
+    printTour(instance, tour);
+    cout << "The execution time was: " << duration.count() << " microseconds" << endl;
+    finishTour(instance, tour);
+}
+
+void Manager::parallelTwoOpt()
+{
+    int threads;
+    cout << "Numero de threads: ";
+    cin >> threads;
+    cout << endl;
+    this->runParallelTwoOpt(threads, 0);
+}
+
+void Manager::runParallelTwoOpt(int threads, double timeLimit)
+{
+    TSPInstance instance = this->graphInstance();
+    double target = gapTargetCost(instance);
+
+    auto start = chrono::high_resolution_clock::now();
+
+    vector<Vertex *> path;
+    triangularApproximationPath(path);
+    vector<int> tour = instance.toTour(path);
+    completeTour(instance, tour);
+    warmStart(instance, tour);
+    double oldTotal = instance.tourCost(tour);
+
+    auto middle = chrono::high_resolution_clock::now();
+
+    SolverControl control(timeLimit);
+    InterruptGuard guard(control);
+    control.setTarget(target);
+    showProgress(control);
+    ParallelTwoOpt solver(instance, threads);
+    solver.run(tour, control);
+    control.stopReporting();
+
+    auto end = chrono::high_resolution_clock::now();
+    auto duration1 = chrono::duration_cast<chrono::microseconds>(middle - start);
+    auto duration2 = chrono::duration_cast<chrono::microseconds>(end - middle);
+
+    double total = instance.tourCost(tour);
+    printTour(instance, tour);
+    cout << "The total distance without 2-opt was: " << oldTotal << endl;
+    cout << "2-opt reduced the path cost in: " << oldTotal - total << endl;
+    cout << "Rounds: " << solver.getRounds() << ", moves applied: " << solver.getMoves() << endl;
+    cout << "The path creation with triangular approximation took: " << duration1.count() << " microseconds" << endl;
+    cout << "The path improvement took with parallel 2-opt: " << duration2.count() << " microseconds" << endl;
+    finishTour(instance, tour);
+}
+
+void Manager::partition()
+{
+    PartitionParameters params;
+    cout << "Tamanho maximo de cada particao: ";
+    cin >> params.clusterSize;
+    cout << "Numero de threads: ";
+    cin >> params.threads;
+    cout << endl;
+    this->runPartition(params, 0);
+}
+
+void Manager::runPartition(const PartitionParameters &params, double timeLimit)
+{
+    if (!this->graph->isReal() || this->closureEnabled)
+    {
+        cout << "The partition solver needs the coordinates of a real-world graph or of a TSPLIB coordinate instance"
+                " (and does not run on the metric closure)." << endl;
+        return;
+    }
+
+    TSPInstance instance = this->graphInstance();
+    double target = gapTargetCost(instance);
+
+    auto start = chrono::high_resolution_clock::now();
+    SolverControl control(timeLimit);
+    InterruptGuard guard(control);
+    control.setTarget(target);
+    showProgress(control);
+    PartitionSolver solver(instance, params);
+
+    auto middle = chrono::high_resolution_clock::now();
+
+    vector<int> tour = solver.run(control);
+    control.stopReporting();
+
+    auto end = chrono::high_resolution_clock::now();
+    auto duration1 = chrono::duration_cast<chrono::microseconds>(middle - start);
+    auto duration2 = chrono::duration_cast<chrono::microseconds>(end - middle);
+
+    printTour(instance, tour);
+    cout << "Clusters: " << solver.getClusters() << endl;
+    cout << "The setup with the neighbour lists took: " << duration1.count() << " microseconds" << endl;
+    cout << "The partition solver took: " << duration2.count() << " microseconds" << endl;
+    finishTour(instance, tour);
+}
+
+void Manager::heapBenchmark()
+{
+    int sources;
+    cout << "Numero de origens: ";
+    cin >> sources;
+    cout << endl;
+    this->runHeapBenchmark(sources);
+}
+
+void Manager::runHeapBenchmark(int sources)
+{
+    vector<HeapBenchmarkResult> results = benchmarkHeaps(*this->graph, sources);
+    for (auto &result : results)
+    {
+        cout << result.name << " took: " << result.microseconds << " microseconds";
+        if (result.checksum != results.front().checksum)
+            cout << " (different distances: " << result.checksum << " instead of " << results.front().checksum << ")";
+        cout << endl;
+    }
+}
+
+void Manager::subsetTour()
+{
+    int count;
+    SolveOptions options;
+    double timeLimit;
+    cout << "Numero de vertices do subconjunto: ";
+    cin >> count;
+    vector<int> ids(max(count, 0));
+    cout << "IDs dos vertices: ";
+    for (int &id : ids)
+        cin >> id;
+    cout << "Algoritmo (triangular, 2opt, ils, ga, aco, portfolio, partition): ";
+    cin >> options.algorithm;
+    cout << "Tempo limite (segundos): ";
+    cin >> timeLimit;
+    cout << endl;
+    options.closure = this->closureEnabled;
+    this->runSubset(ids, options, timeLimit);
+}
+
+void Manager::runSubset(const vector<int> &ids, const SolveOptions &options, double timeLimit)
+{
+    auto start = chrono::high_resolution_clock::now();
+    SolverControl control(timeLimit);
+    InterruptGuard guard(control);
+    showProgress(control);
+    TSPInstance instance;
+    string error;
+    vector<int> walk;
+    vector<int> tour = solveSubset(*this->graph, ids, options, control, instance, error, &walk);
+    control.stopReporting();
+    auto end = chrono::high_resolution_clock::now();
+
+    if (tour.empty())
+    {
+        cout << "Could not solve the subset: " << error << endl;
+        return;
+    }
+    printTour(instance, tour);
+    if (!walk.empty())
+        printWalk(walk);
+    cout << "Vertexes in the tour: " << instance.size() << " of " << this->graph->getNumVertex() << endl;
+    cout << "The sub-instance and the " << options.algorithm << " solver took: "
+         << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds" << endl;
+}
+
+void Manager::dynamicTourMenu()
+{
+    if (this->dynamicTour == nullptr)
+    {
+        auto start = chrono::high_resolution_clock::now();
+        vector<Vertex *> path;
+        triangularApproximationPath(path);
+        TSPInstance instance = TSPInstance::fromGraph(*this->graph);
+        vector<int> tour = instance.toTour(path);
+        completeTour(instance, tour);
+        warmStart(instance, tour);
+        twoOptNeighbours(instance, tour, instance.nearestNeighbours(10), min(10, instance.size() - 1));
+
+        path.clear();
+        for (int v : tour)
+            path.push_back(this->graph->findVertex(instance.getId(v)));
+        this->dynamicTour = make_unique<DynamicTour>(*this->graph, path);
+        auto end = chrono::high_resolution_clock::now();
+        cout << "The total distance is: " << this->dynamicTour->getCost() << endl;
+        cout << "The initial solve took: " << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds" << endl;
+    }
+
+    int i = 0;
+    while (i != 5)
+    {
+        cout << "------------MENU PERCURSO DINAMICO----------" << endl;
+        cout << "Selecione uma opcao: \n";
+        cout << "1: Inserir cidade\n";
+        cout << "2: Remover cidade\n";
+        cout << "3: Atualizar distancias\n";
+        cout << "4: Mostrar percurso\n";
+        cout << "5: Sair \n";
+        cout << "Numero de cidades no percurso: " << this->dynamicTour->size() << endl;
+        cout << "opcao: ";
+        cin >> i;
+        switch (i)
+        {
+        case 1:
+        {
+            int id;
+            cout << "ID da cidade: ";
+            cin >> id;
+            if (this->dynamicTour->contains(id))
+            {
+                cout << "A cidade ja esta no percurso" << endl;
+                break;
+            }
+            if (this->graph->findVertex(id) == nullptr)
+            {
+                this->graph->addVertex(id);
+                if (this->graph->isReal())
+                {
+                    double latitude, longitude;
+                    cout << "Latitude: ";
+                    cin >> latitude;
+                    cout << "Longitude: ";
+                    cin >> longitude;
+                    this->graph->findVertex(id)->setLatitude(latitude);
+                    this->graph->findVertex(id)->setLongitude(longitude);
+                }
+                else
+                {
+                    int edges;
+                    cout << "Numero de arestas da cidade: ";
+                    cin >> edges;
+                    for (int e = 0; e < edges; e++)
+                    {
+                        int dest;
+                        double weight;
+                        cout << "ID do destino e distancia: ";
+                        cin >> dest >> weight;
+                        if (!this->graph->addBidirectionalEdge(id, dest, weight))
+                            cout << "Vertice não encontrado, aresta ignorada" << endl;
+                    }
+                }
+                // the new vertex and its edges are not in the oracle, so it is dropped before the tour looks at them
+                this->graphModified();
+                this->dynamicTour->refresh();
+            }
+
+            auto start = chrono::high_resolution_clock::now();
+            this->dynamicTour->insertVertex(this->graph->findVertex(id));
+            auto end = chrono::high_resolution_clock::now();
+            cout << "The total distance is: " << this->dynamicTour->getCost() << endl;
+            cout << "The insertion took: " << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds" << endl;
+            break;
+        }
+        case 2:
+        {
+            Vertex *v = inputNode("Cidade a remover");
+            if (v == nullptr)
+                break;
+            if (v->getId() == 0)
+            {
+                cout << "O vertice 0 e o inicio do percurso e nao pode ser removido" << endl;
+                break;
+            }
+            auto start = chrono::high_resolution_clock::now();
+            this->dynamicTour->removeVertex(v->getId());
+            this->graph->removeVertex(v->getId());
+            this->graphModified();
+            this->dynamicTour->refresh();
+            auto end = chrono::high_resolution_clock::now();
+            cout << "The total distance is: " << this->dynamicTour->getCost() << endl;
+            cout << "The removal took: " << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds" << endl;
+            break;
+        }
+        case 3:
+        {
+            int count;
+            cout << "Numero de arestas a atualizar: ";
+            cin >> count;
+            vector<EdgeWeightUpdate> updates(max(count, 0));
+            for (auto &u : updates)
+            {
+                cout << "ID da origem, ID do destino e nova distancia: ";
+                cin >> u.orig >> u.dest >> u.weight;
+            }
+            auto start = chrono::high_resolution_clock::now();
+            // the oracle and the closure have the old shortest paths, so they are dropped before the re-optimization
+            this->graphModified();
+            this->dynamicTour->refresh();
+            int applied = this->dynamicTour->updateWeights(updates);
+            auto end = chrono::high_resolution_clock::now();
+            cout << "Edges updated: " << applied << endl;
+            cout << "The total distance is: " << this->dynamicTour->getCost() << endl;
+            cout << "The update took: " << chrono::duration_cast<chrono::microseconds>(end - start).count() << " microseconds" << endl;
+            break;
+        }
+        case 4:
+        {
+            vector<Vertex *> path = this->dynamicTour->getPath();
+            auto it = find(path.begin(), path.end(), this->graph->findVertex(0));
+            if (it != path.end())
+                rotate(path.begin(), it, path.end());
+            if (path.size() <= 100)
+            {
+                cout << "The TSP path is: ";
+                for (auto v : path)
+                {
+                    cout << v->getId() << " -> ";
+                }
+                cout << path.front()->getId() << endl;
+            }
+            cout << "The total distance is: " << this->dynamicTour->getCost() << endl;
+            break;
+        }
+        case 5:
+            cout << "A sair..." << endl;
+            break;
+        default:
+            cout << "Selecione uma opcao valida!" << endl;
+        }
+    }
 }
@@ -6,28 +6,95 @@
 #ifndef DAPROJECT2_MANAGER_H
 #define DAPROJECT2_MANAGER_H
 
+#include <memory>
 #include "Graph.h"
+#include "GraphRegistry.h"
+#include "MetricClosure.h"
+#include "DynamicTour.h"
+#include "TSPInstance.h"
+#include "AntColony.h"
+#include "GeneticAlgorithm.h"
+#include "Partition.h"
+#include "Portfolio.h"
+#include "SolverService.h"
+#include "TourCache.h"
 
 class Manager
 {
 private:
-    Graph graph;
+    GraphRegistry registry;                   /**< Graphs read before, kept so selecting them again does not read their files. */
+    std::shared_ptr<Graph> graph;             /**< The current graph, shared with the registry until it is modified. */
+    std::string graphPath;                    /**< Path of the current graph, its key in the registry. */
+    bool graphReal = false;                   /**< Whether the current graph was read as a real-world graph. */
+    int nearest = 0;                          /**< Nearest neighbours kept per vertex when reading CSV edge lists (0 keeps every edge, see readGraphFile). */
+    GraphScratch scratch;                     /**< State of the spanning tree and tree traversal queries on the graph. */
+    std::unique_ptr<DynamicTour> dynamicTour; /**< Solved tour kept while cities are inserted and removed (reset by readGraph). */
+    TourCache cache;                          /**< Best known tour of every graph, in src/cache/. */
+    bool cacheEnabled = true;                 /**< Whether the solvers warm-start from and update the cache. */
+    uint64_t fingerprint = 0;                 /**< Fingerprint of the graph, computed by readGraph (0 once the graph is modified). */
+    std::string tourOutput;                   /**< TSPLIB .tour file the solvers write their tour to (empty for none). */
+    double optimum = 0;                       /**< Known optimal distance of the graph, to report the optimality gap (0 if unknown). */
+    bool boundEnabled = true;                 /**< Whether the Held-Karp lower bound is computed to report the gap. */
+    double gapTarget = 0;                     /**< Gap to the lower bound, in percent, at which the solvers stop (0 to never stop early). */
+    double boundTimeLimit = 10;               /**< Time limit of the lower bound, in seconds, apart from the one of the solvers. */
+    double bound = 0;                         /**< Lower bound of the graph with fingerprint boundFingerprint. */
+    uint64_t boundFingerprint = 0;            /**< Fingerprint of the graph the lower bound belongs to. */
+    int mstThreads = 1;                       /**< Threads of the minimum spanning tree: Graph::boruvka above 1, Graph::prim otherwise. */
+    bool closureEnabled = false;              /**< Whether the solvers run on the shortest path distances of the graph (see graphInstance). */
+    int closureThreads = 1;                   /**< Threads computing the metric closure. */
+    std::unique_ptr<MetricClosure> closure;   /**< Metric closure of the current graph, computed by graphInstance (reset with the graph). */
+    bool oracleEnabled = false;               /**< Whether the graphs get a contraction hierarchy as distance oracle (see attachOracle). */
+    std::string oracleIndex;                  /**< File the contraction hierarchy is read from and written to (empty for none). */
 
 public:
+    static const size_t DEFAULT_MEMORY_BUDGET = (size_t)1024 << 20; /**< Memory budget of the registry, in bytes. */
+
     Manager();
     /**
      * @brief Reads a graph from a file and sets it as the current graph.
      *
      * This function reads a graph from the specified file path and sets it as the current graph
-     * in the Manager class. It can read both toy graphs and real-world graphs based on the `real` flag.
+     * in the Manager class. It can read both toy graphs and real-world graphs based on the `real` flag,
+     * and TSPLIB instances when the path ends with .tsp (see readTSPLib).
+     * It also computes the fingerprint of the graph, which is the key of its cached tour.
+     * Graphs already in the registry are not read again: their graph and fingerprint are reused.
      *
-     * Time complexity: O(V + E) being V the number of vertexes and E the number of edges
+     * Time complexity: O(V + E) being V the number of vertexes and E the number of edges; O(log(G)) for graphs in the
+     * registry, being G their number
      *
      * @param filePath The file path of the graph file.
-     * @param real A flag indicating whether the graph is a real-world graph (true) or a toy graph (false).
+     * @param real A flag indicating whether the graph is a real-world graph (true) or a toy graph (false); ignored for .tsp files.
      */
     void readGraph(const std::string &filePath, bool real);
 
+    /**
+     * @brief Runs a single algorithm from command line arguments, without the menus.
+     *
+     * Accepted options: --graph <path> (relative to src/, as in readGraph), --real, --algorithm <backtracking|triangular|2opt|2opt-parallel|ils|ga|aco|portfolio|partition|heap-benchmark>,
+     * --time <seconds>, --seed <number>, --threads <number>, --runs <number>, --cluster-size <number>, --no-cache,
+     * --tour-output <path> (TSPLIB .tour file for the tour found), --optimum <distance> (to report the optimality gap),
+     * --gap <percent> (stop once the tour is within this gap of the lower bound), --no-bound (skip the lower bound),
+     * --bound-time <seconds> (time limit of the lower bound, 10 by default),
+     * --sources <number> (Dijkstra sources of heap-benchmark) and --mst-threads <number> (threads of the minimum spanning
+     * tree of the triangular approximation, see spanningTree).
+     * With --serve <socket path> (or --serve - for the standard input and output) the program runs a SolverService
+     * instead, with --threads workers, until a shutdown request; --graph then loads that graph before the first request.
+     * --memory-budget <megabytes> sets the memory of the graphs kept in memory (by the menus, or by the service).
+     * --vertices <id,id,...> solves a tour over only these vertices with the chosen algorithm (see runSubset).
+     * --closure makes the solvers use shortest path distances, for sparse graphs (see graphInstance and runSubset); it
+     * disables the cache.
+     * --nearest <k> reads CSV edge lists keeping only the k nearest neighbours of every vertex (and a minimum spanning
+     * tree) as edges, with the other distances in the distance table of the graph (see readGraphFile).
+     * --ch builds a contraction hierarchy of the graph, used by Graph::getDistance and the metric closure, and --ch-index
+     * <path> (relative to src/) reads it from that file, or writes it there once built (see attachOracle).
+     *
+     * Time complexity: the one of the chosen algorithm
+     *
+     * @param args The command line arguments, without the program name.
+     * @return The exit status of the program.
+     */
+    int commandLine(const std::vector<std::string> &args);
+
     /**
      * @brief Displays the main menu and handles user input for various options.
      *
@@ -61,6 +128,31 @@ public:
      */
     void readGraphMenu();
 
+    /**
+     * @brief Lists the graphs in memory and sets the chosen one as the current graph, without reading it again.
+     *
+     * Time complexity: O(G) being G the number of graphs in memory
+     */
+    void residentGraphMenu();
+
+    /**
+     * @brief Marks the current graph as modified: its fingerprint must be computed again, and it is dropped from the
+     * registry, so selecting its dataset again reads the original files.
+     *
+     * Time complexity: O(log(G)) being G the number of graphs in memory
+     */
+    void graphModified();
+
+    /**
+     * @brief Gives the current graph a contraction hierarchy as distance oracle, if enabled and it has none yet: it is
+     * read from the index file if that holds the hierarchy of this graph (same fingerprint), and otherwise built and
+     * written to the index file.
+     *
+     * Time complexity: O(V + A) if read, being A the number of arcs of the hierarchy; the one of building a
+     * ContractionHierarchy otherwise
+     */
+    void attachOracle();
+
     /**
      * @brief Displays the toy graph menu and handles user input for toy graph selection.
      *
@@ -95,12 +187,23 @@ public:
      * @brief Calculates the Traveling Salesman Problem (TSP) solution using backtracking.
      *
      * This function calculates the TSP solution using backtracking and displays the optimal path and total distance.
-     * It starts from the vertex with ID 0 as the initial node.
+     * It starts from the vertex with ID 0 as the initial node. It asks for a time limit and then calls runBacktracking.
      *
      * Time complexity: O(2^V * V^2) being V the number of vertexes
      */
     void TSPBacktracking();
 
+    /**
+     * @brief Runs the backtracking until it finishes, the time limit passes or Ctrl+C is pressed.
+     *
+     * When it is stopped early the best path found so far is displayed (or "No tour found" if none was completed).
+     *
+     * Time complexity: O(2^V * V^2) being V the number of vertexes
+     *
+     * @param timeLimit Wall-clock limit in seconds (zero for no limit).
+     */
+    void runBacktracking(double timeLimit);
+
     /**
      * @brief Recursive helper function for TSPBacktracking.
      *
@@ -115,8 +218,11 @@ public:
      * @param currCost The current cost of the path.
      * @param minCost The minimum cost found so far.
      * @param bestPath The best path found so far.
+     * @param control Deadline and cancellation; it is cancelled when the deadline passes, so every level returns.
+     * @param nodes Number of search nodes visited; the deadline is checked every 1024 nodes.
      */
-    void TSPBacktrackingRecursive(Vertex *currNode, std::vector<Vertex *> &visitedNodes, double currCost, double &minCost, std::vector<Vertex *> &bestPath);
+    void TSPBacktrackingRecursive(Vertex *currNode, std::vector<Vertex *> &visitedNodes, double currCost, double &minCost, std::vector<Vertex *> &bestPath,
+                                  SolverControl &control, long long &nodes);
 
     /**
      *
@@ -140,21 +246,320 @@ public:
      * It starts by finding an initial solution using the Triangular Approximation algorithm.
      * Then, it repeatedly iterates over pairs of edges in the path and checks if swapping them can reduce the total distance.
      * If a swap improves the solution, the path is modified accordingly, and the process is repeated until no further improvement is found.
+     * For each first edge the second edges are evaluated in blocks over a cached array with the current edge lengths (see bestTwoOptMove),
+     * and the best improving swap of each block is applied.
      * The execution time of the function is measured and divided into two parts: the time spent on path creation and the time spent on path improvement.
      *
      * Time complexity: O(E * log(V) + V^2) being V the number of vertexes and E the number of edges
      */
     void twoOpt();
-};
 
-/**
- * Reads a field from a cvs file
- *
- * Time complexity: O(1)
- * 
- * @param line istringstream variable
- * @param delim until which character should the line be read
- */
-std::string getField(std::istringstream &line, char delim);
+    /**
+     * @brief Runs the 2-opt optimization of twoOpt() until a local optimum, the time limit or Ctrl+C.
+     *
+     * Time complexity: O(E * log(V) + V^2) being V the number of vertexes and E the number of edges
+     *
+     * @param timeLimit Wall-clock limit of the improvement in seconds (zero for no limit).
+     */
+    void runTwoOpt(double timeLimit);
+
+    /**
+     * @brief Solves the Traveling Salesman Problem (TSP) with the island-model genetic algorithm.
+     *
+     * This function asks for the time limit and number of islands, seeds every island with the Triangular Approximation tour
+     * and evolves the islands in parallel, one thread per island. The best tour found, its distance and the execution time are displayed.
+     *
+     * Time complexity: O(G * P * V * k) being G the number of generations, P the total population, V the number of vertexes and k the neighbour list size
+     */
+    void geneticAlgorithm();
+
+    /**
+     * @brief Runs the genetic algorithm with the given parameters and displays the result.
+     *
+     * Time complexity: O(G * P * V * k) being G the number of generations, P the total population, V the number of vertexes and k the neighbour list size
+     *
+     * @param params The parameters of the genetic algorithm.
+     * @param timeLimit Wall-clock limit in seconds.
+     */
+    void runGeneticAlgorithm(const GeneticParameters &params, double timeLimit);
+
+    /**
+     * @brief Solves the Traveling Salesman Problem (TSP) with the MAX-MIN Ant System.
+     *
+     * This function asks for the time limit, the number of threads and the random seed, and then calls runAntColony.
+     *
+     * Time complexity: O(I * A * V * k) being I the number of iterations, A the number of ants, V the number of vertexes and k the candidate list size
+     */
+    void antColony();
+
+    /**
+     * @brief Runs the MAX-MIN Ant System with the given parameters and displays the result.
+     *
+     * The pheromone bounds are initialized from the Triangular Approximation tour.
+     *
+     * Time complexity: O(I * A * V * k) being I the number of iterations, A the number of ants, V the number of vertexes and k the candidate list size
+     *
+     * @param params The parameters of the ant colony.
+     * @param timeLimit Wall-clock limit in seconds.
+     */
+    void runAntColony(const AntColonyParameters &params, double timeLimit);
+
+    /**
+     * @brief Improves the 2-opt tour with iterated local search until a time limit.
+     *
+     * This function asks for the time limit and the random seed, and then calls runIteratedLocalSearch.
+     *
+     * Time complexity: O(E * log(V) + V^2 + K * k) being K the number of kicks and k the neighbour list size
+     */
+    void TSPIteratedLocalSearch();
+
+    /**
+     * @brief Builds the Triangular Approximation tour, takes it to a 2-opt local optimum and then runs iterated local search
+     * with double-bridge kicks in the remaining time. The distances after each phase and the execution times are displayed.
+     *
+     * Time complexity: O(E * log(V) + V^2 + K * k) being K the number of kicks and k the neighbour list size
+     *
+     * @param timeLimit Wall-clock limit of the iterated local search, in seconds.
+     * @param seed Seed of the random number generator.
+     */
+    void runIteratedLocalSearch(double timeLimit, unsigned seed);
+
+    /**
+     * @brief Solves the Traveling Salesman Problem (TSP) with the multi-start portfolio.
+     *
+     * This function asks for the time limit, the number of runs and the number of threads, and then calls runPortfolio.
+     *
+     * Time complexity: O(R * (V^2 + K * k) / T) being R the number of runs, K the kicks per run and T the number of threads
+     */
+    void portfolio();
+
+    /**
+     * @brief Runs the multi-start portfolio with the given parameters and displays every run and the best tour.
+     *
+     * Time complexity: O(R * (V^2 + K * k) / T) being R the number of runs, K the kicks per run and T the number of threads
+     *
+     * @param params The parameters of the portfolio.
+     * @param timeLimit Wall-clock limit in seconds.
+     */
+    void runPortfolio(const PortfolioParameters &params, double timeLimit);
+
+    /**
+     * @brief Performs the best-improvement 2-opt optimization with the sweep split across threads.
+     *
+     * This function asks for the number of threads and then calls runParallelTwoOpt.
+     *
+     * Time complexity: O(E * log(V) + R * V^2 / T) being R the number of rounds and T the number of threads
+     */
+    void parallelTwoOpt();
+
+    /**
+     * @brief Improves the Triangular Approximation tour with the parallel best-improvement 2-opt and displays the result.
+     *
+     * Time complexity: O(E * log(V) + R * V^2 / T) being R the number of rounds and T the number of threads
+     *
+     * @param threads The number of threads.
+     * @param timeLimit Wall-clock limit of the improvement in seconds (zero for no limit).
+     */
+    void runParallelTwoOpt(int threads, double timeLimit);
+
+    /**
+     * @brief Solves a large coordinate graph (real-world or TSPLIB) with the partition solver.
+     *
+     * This function asks for the cluster size and the number of threads, and then calls runPartition.
+     *
+     * Time complexity: O(V * (C + k) + V^2 / C + C^2 * P) being C the cluster size, k the neighbour list size and P the 2-opt passes per cluster
+     */
+    void partition();
+
+    /**
+     * @brief Splits the coordinate graph into clusters, solves them in parallel and stitches their tours (see PartitionSolver).
+     *
+     * Time complexity: O(V * (C + k) + V^2 / C + C^2 * P) being C the cluster size, k the neighbour list size and P the 2-opt passes per cluster
+     *
+     * @param params The parameters of the partition solver.
+     * @param timeLimit Wall-clock limit in seconds (zero for no limit).
+     */
+    void runPartition(const PartitionParameters &params, double timeLimit);
+
+    /**
+     * @brief Compares the priority queues on Dijkstra queries over the graph.
+     *
+     * This function asks for the number of sources and then calls runHeapBenchmark.
+     *
+     * Time complexity: O(S * E * log(V)) being S the number of sources
+     */
+    void heapBenchmark();
+
+    /**
+     * @brief Runs Dijkstra's algorithm from several sources with every priority queue and displays their times (see benchmarkHeaps).
+     *
+     * Time complexity: O(S * E * log(V)) being S the number of sources
+     *
+     * @param sources The number of sources.
+     */
+    void runHeapBenchmark(int sources);
+
+    /**
+     * @brief Solves a tour over some of the vertices of the graph.
+     *
+     * This function asks for the vertex IDs, the algorithm and the time limit and then calls runSubset.
+     *
+     * Time complexity: the one of runSubset
+     */
+    void subsetTour();
+
+    /**
+     * @brief Solves a tour over some of the vertices of the graph with solveSubset, which builds a sub-instance from the
+     * graph without the whole instance, and displays it.
+     * The tour is not cached and no lower bound is computed, since both belong to the whole graph. With the metric
+     * closure enabled, the closure is built over these vertices only, and the walk over the graph edges is displayed.
+     *
+     * Time complexity: O(S^2) being S the number of vertices, plus the one of the chosen algorithm
+     *
+     * @param ids IDs of the vertices the tour visits.
+     * @param options The algorithm (triangular, 2opt, ils, ga, aco, portfolio or partition) and its parameters.
+     * @param timeLimit The time limit in seconds (0 for no limit).
+     */
+    void runSubset(const std::vector<int> &ids, const SolveOptions &options, double timeLimit);
+
+    /**
+     * @brief Displays the menu of the dynamic tour, where cities are inserted in and removed from a solved tour.
+     *
+     * The first time it is opened for a graph it solves the graph with the Triangular Approximation and 2-opt;
+     * that tour is then kept and updated by every insertion and removal (see DynamicTour), instead of being solved again.
+     * Inserting a city that is not in the graph adds it, asking for its coordinates (real-world graphs) or its edges.
+     * Removing a city also removes it from the graph. The vertex with ID 0 can not be removed.
+     * Edge weights can be changed in batches; only the tour around the changed edges is re-optimized.
+     *
+     * Time complexity: O(V) per insertion, removal or changed edge
+     */
+    void dynamicTourMenu();
+
+private:
+    /**
+     * @brief Builds the minimum spanning tree of the graph with Graph::boruvka on mstThreads threads, or Graph::prim if
+     * mstThreads is 1.
+     *
+     * Time complexity: O(E * log(V) / T) being T the number of threads
+     */
+    void spanningTree();
+
+    /**
+     * @brief Builds the Triangular Approximation tour, starting at the vertex with ID 0.
+     *
+     * Time complexity: O(E * log(V) + V) being V the number of vertexes and E the number of edges
+     *
+     * @param path Vector to store the path (without the return to the first vertex).
+     * @return The total distance of the tour.
+     */
+    double triangularApproximationPath(std::vector<Vertex *> &path);
+
+    /**
+     * @brief Displays a tour of an instance (only when the graph has at most 100 vertexes) and its total distance.
+     *
+     * The tour is rotated so that it starts at the vertex with ID 0.
+     *
+     * Time complexity: O(V)
+     *
+     * @param instance The instance the tour belongs to.
+     * @param tour The tour.
+     */
+    void printTour(const TSPInstance &instance, std::vector<int> tour);
+
+    /**
+     * @brief Displays a closed walk over the graph edges (when it has at most 200 vertices) and its number of edges.
+     *
+     * Time complexity: O(L) being L the length of the walk
+     *
+     * @param walk The vertex IDs of the walk, the first one repeated at the end.
+     */
+    void printWalk(const std::vector<int> &walk);
+
+    /**
+     * @brief Starts printing the progress of a solver (best distance, moves per second, elapsed time) every second.
+     *
+     * @param control The control of the solver.
+     */
+    void showProgress(SolverControl &control);
+
+    /**
+     * @brief Returns the fingerprint of the graph, computing it again if the graph was modified since it was read.
+     *
+     * Time complexity: O(1), or O(V * log(V) + E * log(E)) after a modification
+     *
+     * @return The fingerprint.
+     */
+    uint64_t graphFingerprint();
+
+    /**
+     * @brief Replaces a tour with the cached tour of the graph, if there is one and it is cheaper.
+     *
+     * Time complexity: O(V)
+     *
+     * @param instance The instance of the graph.
+     * @param tour The tour to replace (it can be empty).
+     * @return True if the tour was replaced.
+     */
+    bool warmStart(const TSPInstance &instance, std::vector<int> &tour);
+
+    /**
+     * @brief Writes a tour to the cache if it is cheaper than the cached tour of the graph.
+     *
+     * Time complexity: O(V)
+     *
+     * @param instance The instance of the graph.
+     * @param tour The tour, visiting every vertex.
+     */
+    void updateCache(const TSPInstance &instance, const std::vector<int> &tour);
+
+    /**
+     * @brief Returns the Held-Karp lower bound of the graph (see HeldKarpBound), computing and displaying it the first time.
+     *
+     * The bound is kept until the graph changes. It runs under its own time limit (boundTimeLimit), outside the timing
+     * and the deadline of the solvers. The subgradient steps use the shorter of the given tour and the cached one as the
+     * upper bound, and a bound below HeldKarpBound::trivialBound is replaced by it.
+     *
+     * Time complexity: O(I * V^2) the first time for dense instances (see HeldKarpBound::run), O(1) afterwards
+     *
+     * @param instance The instance of the graph.
+     * @param upperBound Length of a tour of the graph (INF if none).
+     * @return The lower bound (0 if it is disabled or could not be computed).
+     */
+    double lowerBound(const TSPInstance &instance, double upperBound);
+
+    /**
+     * @brief Returns the tour length at which the solvers stop with --gap, computing the lower bound if needed. It is
+     * called before a solver starts its clock, so the bound is not part of the solver's time.
+     *
+     * Time complexity: the one of lowerBound
+     *
+     * @param instance The instance of the graph.
+     * @return The target length (negative if there is no gap target, for SolverControl::setTarget).
+     */
+    double gapTargetCost(const TSPInstance &instance);
+
+    /**
+     * @brief Handles the tour a solver found: updates the cache, displays the optimality gap if the optimum is known,
+     * the gap to the lower bound, the walk over the graph edges with the metric closure, and writes the tour to the
+     * TSPLIB .tour output file if one was given.
+     *
+     * Time complexity: O(V)
+     *
+     * @param instance The instance of the graph.
+     * @param tour The tour, visiting every vertex.
+     */
+    void finishTour(const TSPInstance &instance, const std::vector<int> &tour);
+
+    /**
+     * @brief Builds the instance the solvers run on: the graph itself, or, with the metric closure enabled, the shortest
+     * path distances between all its vertices (computed once per graph with MetricClosure), so sparse graphs get a tour
+     * whose legs are paths over their edges. Graphs over TSPInstance::DENSE_LIMIT vertexes use their edges only.
+     *
+     * Time complexity: O(V^2 + E) without the closure; O(V * (V + E) * log(V) / threads) the first time with it
+     *
+     * @return The instance.
+     */
+    TSPInstance graphInstance();
+};
 
 #endif // DAPROJECT2_MANAGER_H
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "ContractionHierarchy.h"
+#include "MetricClosure.h"
+
+MetricClosure::MetricClosure(const Graph &graph, const std::vector<int> &terminals, int threads)
+    : graph(graph), n(graph.getNumVertex()), oracle(graph.getDistanceOracle())
+{
+    int t = (int)terminals.size();
+    terminalOf.assign(n, -1);
+    for (int i = 0; i < t; i++)
+    {
+        this->terminals.push_back(graph.findVertex(terminals[i])->getIndex());
+        terminalOf[this->terminals[i]] = i;
+    }
+    if (this->oracle != nullptr)
+    {
+        this->matrix = this->oracle->table(terminals, terminals, threads);
+        return;
+    }
+
+    const std::vector<Vertex *> &vertices = graph.getVertices();
+    start.assign(n + 1, 0);
+    for (int v = 0; v < n; v++)
+        start[v + 1] = start[v] + (int)vertices[v]->getAdj().size();
+    target.resize(start[n]);
+    weight.resize(start[n]);
+    for (int v = 0; v < n; v++)
+    {
+        int a = start[v];
+        for (auto &e : vertices[v]->getAdj())
+        {
+            target[a] = e.second->getDest()->getIndex();
+            weight[a++] = e.second->getWeight();
+        }
+    }
+
+    matrix.assign((size_t)t * t, INF);
+    bool keepPredecessors = (long long)t * n <= PREDECESSOR_LIMIT;
+    if (keepPredecessors)
+        predecessor.resize((size_t)t * n);
+
+    std::atomic<int> next{0};
+    auto work = [&]()
+    {
+        Search search;
+        for (int i; (i = next++) < t;)
+        {
+            dijkstra(this->terminals[i], -1, search);
+            for (int j = 0; j < t; j++)
+                matrix[(size_t)i * t + j] = search.dist[this->terminals[j]];
+            if (keepPredecessors)
+                std::copy(search.parent.begin(), search.parent.end(), predecessor.begin() + (size_t)i * n);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int k = 1; k < std::min(threads, t); k++)
+        pool.emplace_back(work);
+    work();
+    for (auto &thread : pool)
+        thread.join();
+}
+
+void MetricClosure::dijkstra(int source, int stopAt, Search &search) const
+{
+    if ((int)search.dist.size() != n)
+    {
+        search.queue.reset(n);
+        search.dist.assign(n, INF);
+        search.parent.assign(n, -1);
+    }
+    // only the vertices reached by the previous search are cleared
+    for (int v : search.touched)
+    {
+        search.dist[v] = INF;
+        search.parent[v] = -1;
+    }
+    search.touched.clear();
+    search.queue.clear();
+
+    search.dist[source] = 0;
+    search.touched.push_back(source);
+    search.queue.push(source, 0);
+    int remaining = stopAt == -1 ? (int)terminals.size() : 1;
+    while (!search.queue.empty())
+    {
+        int u = search.queue.pop();
+        if ((stopAt == -1 ? terminalOf[u] != -1 : u == stopAt) && --remaining == 0)
+            break;
+        double du = search.dist[u];
+        for (int a = start[u]; a < start[u + 1]; a++)
+        {
+            int v = target[a];
+            double d = du + weight[a];
+            if (d < search.dist[v])
+            {
+                if (search.dist[v] == INF)
+                    search.touched.push_back(v);
+                search.dist[v] = d;
+                search.parent[v] = u;
+                search.queue.pushOrDecrease(v, d);
+            }
+        }
+    }
+}
+
+int MetricClosure::size() const
+{
+    return (int)terminals.size();
+}
+
+double MetricClosure::dist(int i, int j) const
+{
+    return matrix[(size_t)i * terminals.size() + j];
+}
+
+TSPInstance MetricClosure::toInstance() const
+{
+    std::vector<int> ids;
+    for (int v : terminals)
+        ids.push_back(graph.getVertices()[v]->getId());
+    return TSPInstance::fromDistances(ids, matrix);
+}
+
+std::vector<int> MetricClosure::path(int i, int j) const
+{
+    if (dist(i, j) >= INF)
+        return {};
+    const std::vector<Vertex *> &vertices = graph.getVertices();
+    if (this->oracle != nullptr)
+        return this->oracle->path(vertices[terminals[i]]->getId(), vertices[terminals[j]]->getId());
+    std::vector<int> result;
+    if (!predecessor.empty())
+    {
+        const int *parent = predecessor.data() + (size_t)i * n;
+        for (int v = terminals[j]; v != -1; v = parent[v])
+            result.push_back(vertices[v]->getId());
+    }
+    else
+    {
+        Search search;
+        dijkstra(terminals[i], terminals[j], search);
+        for (int v = terminals[j]; v != -1; v = search.parent[v])
+            result.push_back(vertices[v]->getId());
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+std::vector<int> MetricClosure::expandTour(const std::vector<int> &tour) const
+{
+    if (tour.empty())
+        return {};
+    std::vector<int> walk = {graph.getVertices()[terminals[tour[0]]]->getId()};
+    for (size_t k = 0; k < tour.size(); k++)
+    {
+        std::vector<int> leg = path(tour[k], tour[(k + 1) % tour.size()]);
+        if (leg.empty())
+            return {};
+        walk.insert(walk.end(), leg.begin() + 1, leg.end());
+    }
+    return walk;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file MetricClosure.h
+ * @brief This file contains the metric closure of a sparse graph: shortest path distances between its terminals.
+ */
+
+#ifndef DAPROJECT2_METRICCLOSURE_H
+#define DAPROJECT2_METRICCLOSURE_H
+
+#include <memory>
+#include <vector>
+#include "IndexedHeap.h"
+#include "TSPInstance.h"
+
+/**
+ * @class MetricClosure
+ * @brief Shortest path distances between every pair of terminals of a graph, so the tour solvers, which need a
+ * complete graph, can run on sparse graphs (road networks, or edge lists like the shipping graph).
+ *
+ * Dijkstra's algorithm runs from every terminal, with a 4-ary IndexedHeap, and stops once every terminal is settled.
+ * The sources are shared by the threads through an atomic counter; each thread has its own heap and distance array
+ * over the CSR form of the graph, built once. The distances are stored in a T x T matrix, and the predecessors of the
+ * shortest path trees in a T x V array of vertex indexes if it fits PREDECESSOR_LIMIT; otherwise a path is found again
+ * by a single-pair Dijkstra when a tour is expanded.
+ *
+ * If the graph has a distance oracle (see Graph::setDistanceOracle), the matrix is its distance table instead, and the
+ * paths are unpacked from it, so there is no search over the whole graph.
+ */
+class MetricClosure
+{
+public:
+    static const long long PREDECESSOR_LIMIT = 1 << 24; /**< Largest T * V whose predecessors are stored. */
+
+    /**
+     * @brief Computes the closure of a graph over some of its vertices.
+     *
+     * Time complexity: O(T * (V + E) * log(V) / threads) being T the number of terminals; the one of
+     * ContractionHierarchy::table with a distance oracle
+     *
+     * @param graph The graph. It must outlive the closure and not be modified.
+     * @param terminals IDs of the terminals, all in the graph; terminal i gets index i.
+     * @param threads Number of threads running Dijkstra.
+     */
+    MetricClosure(const Graph &graph, const std::vector<int> &terminals, int threads);
+
+    /**
+     * @brief Returns the number of terminals.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of terminals.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns the length of the shortest path between two terminals.
+     *
+     * Time complexity: O(1)
+     *
+     * @param i Index of the first terminal.
+     * @param j Index of the second terminal.
+     * @return The distance (INF if there is no path).
+     */
+    double dist(int i, int j) const;
+
+    /**
+     * @brief Builds the instance of the terminals with the shortest path distances.
+     *
+     * Time complexity: O(T^2)
+     *
+     * @return The instance (dense, whatever its size).
+     */
+    TSPInstance toInstance() const;
+
+    /**
+     * @brief Returns the vertices of a shortest path between two terminals.
+     *
+     * Time complexity: O(L) if the predecessors are stored, O((V + E) * log(V)) otherwise, being L the length of the path
+     *
+     * @param i Index of the first terminal.
+     * @param j Index of the second terminal.
+     * @return The IDs of the vertices from terminal i to terminal j, both included (empty if there is no path).
+     */
+    std::vector<int> path(int i, int j) const;
+
+    /**
+     * @brief Expands a tour of terminals into the closed walk over the edges of the graph that it stands for.
+     *
+     * Time complexity: O(W) if the predecessors are stored, being W the length of the walk
+     *
+     * @param tour The tour, made of terminal indexes.
+     * @return The IDs of the vertices of the walk, which starts and ends at the first terminal of the tour (empty if a
+     *         leg has no path).
+     */
+    std::vector<int> expandTour(const std::vector<int> &tour) const;
+
+private:
+    const Graph &graph;
+    int n;                           /**< Number of vertices of the graph. */
+    std::vector<int> terminals;      /**< Dense vertex index of every terminal. */
+    std::vector<int> terminalOf;     /**< Terminal index of every vertex (-1 for the others). */
+    std::vector<int> start;          /**< The graph in CSR form, by dense vertex index. */
+    std::vector<int> target;
+    std::vector<double> weight;
+    std::vector<double> matrix;      /**< Distances between terminals, T x T. */
+    std::vector<int> predecessor;    /**< Predecessor of every vertex in the tree of every terminal, T x V (or empty). */
+    std::shared_ptr<const ContractionHierarchy> oracle; /**< Distance oracle of the graph (or null). */
+
+    /**
+     * @struct Search
+     * @brief Buffers of one Dijkstra search, reused between sources.
+     */
+    struct Search
+    {
+        IndexedHeap<4> queue;
+        std::vector<double> dist;
+        std::vector<int> parent;
+        std::vector<int> touched;
+    };
+
+    void dijkstra(int source, int stopAt, Search &search) const;
+};
+
+#endif // DAPROJECT2_METRICCLOSURE_H
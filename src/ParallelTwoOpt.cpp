@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <barrier>
+#include <thread>
+#include "ParallelTwoOpt.h"
+#include "TwoOptKernel.h"
+
+ParallelTwoOpt::ParallelTwoOpt(const TSPInstance &instance, int threads)
+    : instance(instance), threads(std::max(1, threads)) {}
+
+int ParallelTwoOpt::getRounds() const
+{
+    return this->rounds;
+}
+
+long long ParallelTwoOpt::getMoves() const
+{
+    return this->moves;
+}
+
+/*
+ * Splits rows 0..n-3 into parts with about the same number of (i, j) pairs.
+ * Row i has n - 2 - i pairs, so the rows near the top of the triangle are the longest.
+ */
+std::vector<int> ParallelTwoOpt::balancedRows(int n, int parts)
+{
+    long long total = (long long)(n - 2) * (n - 1) / 2;
+    std::vector<int> bounds = {0};
+    long long acc = 0;
+    for (int i = 0; i < n - 2 && (int)bounds.size() < parts; i++)
+    {
+        acc += n - 2 - i;
+        if (acc * parts >= total * (long long)bounds.size())
+            bounds.push_back(i + 1);
+    }
+    while ((int)bounds.size() <= parts)
+        bounds.push_back(std::max(n - 2, 0));
+    bounds.back() = std::max(n - 2, 0);
+    return bounds;
+}
+
+void ParallelTwoOpt::scanRows(const std::vector<int> &tour, const std::vector<double> &edges, int firstRow, int lastRow,
+                              std::vector<Move> &out) const
+{
+    int n = (int)tour.size() - 1;
+    double epsilon = 1e-9;
+    out.clear();
+    for (int i = firstRow; i < lastRow; i++)
+    {
+        // j = n - 1 with i = 0 would reconnect the same two edges
+        int lastJ = i == 0 ? n - 2 : n - 1;
+        double delta = -epsilon;
+        int j = bestTwoOptMove(instance, tour, edges, i, i + 2, lastJ + 1, delta);
+        if (j != -1)
+            out.push_back({delta, i, j});
+    }
+}
+
+double ParallelTwoOpt::run(std::vector<int> &tour, SolverControl &control)
+{
+    int n = (int)tour.size();
+    rounds = 0;
+    moves = 0;
+    if (n < 4)
+        return 0;
+
+    // closed tour (the first vertex repeated at the end) and the cached lengths of its edges
+    std::vector<int> closed(tour);
+    closed.push_back(tour[0]);
+    std::vector<double> edges;
+    tourEdges(instance, closed, edges);
+    double cost = instance.tourCost(tour);
+    control.report(cost);
+
+    std::vector<int> bounds = balancedRows(n, threads);
+    std::vector<std::vector<Move>> found(threads);
+    std::vector<Move> candidates;
+    std::vector<char> used(n, 0);
+    double total = 0;
+    bool done = false;
+
+    // runs on one thread once every thread has scanned its rows
+    auto applyMoves = [&]() noexcept
+    {
+        candidates.clear();
+        for (auto &f : found)
+            candidates.insert(candidates.end(), f.begin(), f.end());
+        std::sort(candidates.begin(), candidates.end(), [](const Move &x, const Move &y)
+                  { return x.delta < y.delta; });
+
+        // greedily take the best moves whose position ranges [i, j + 1] are disjoint
+        std::fill(used.begin(), used.end(), 0);
+        int applied = 0;
+        for (const Move &m : candidates)
+        {
+            // with j = n - 1 the second edge wraps around to position 0
+            int last = std::min(m.j + 1, n - 1);
+            bool wraps = m.j == n - 1;
+            bool free = !wraps || !used[0];
+            for (int p = m.i; p <= last && free; p++)
+                free = !used[p];
+            if (!free)
+                continue;
+            for (int p = m.i; p <= last; p++)
+                used[p] = 1;
+            if (wraps)
+                used[0] = 1;
+            std::reverse(closed.begin() + m.i + 1, closed.begin() + m.j + 1);
+            total += m.delta;
+            applied++;
+        }
+        tourEdges(instance, closed, edges);
+        moves += applied;
+        rounds++;
+        control.report(cost + total, applied);
+        done = applied == 0 || control.shouldStop();
+    };
+    std::barrier sync(threads, applyMoves);
+
+    auto work = [&](int t)
+    {
+        while (!done)
+        {
+            scanRows(closed, edges, bounds[t], bounds[t + 1], found[t]);
+            sync.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(work, t);
+    work(0);
+    for (auto &th : pool)
+        th.join();
+    std::copy(closed.begin(), closed.end() - 1, tour.begin());
+    return total;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file ParallelTwoOpt.h
+ * @brief This file contains the implementation of the parallel best-improvement 2-opt.
+ */
+
+#ifndef DAPROJECT2_PARALLELTWOOPT_H
+#define DAPROJECT2_PARALLELTWOOPT_H
+
+#include <vector>
+#include "SolverControl.h"
+#include "TSPInstance.h"
+
+/**
+ * @class ParallelTwoOpt
+ * @brief Best-improvement 2-opt whose O(V^2) sweep is split across threads.
+ *
+ * The (i, j) triangle of moves is cut into row ranges with the same number of pairs, one per thread.
+ * In each round every thread keeps the best move of each of its rows; the improving moves are then sorted and the
+ * best ones whose reversed segments do not overlap are all applied before the next round.
+ */
+class ParallelTwoOpt
+{
+public:
+    /**
+     * @brief Constructs the parallel 2-opt for an instance.
+     *
+     * @param instance The instance.
+     * @param threads The number of threads.
+     */
+    ParallelTwoOpt(const TSPInstance &instance, int threads);
+
+    /**
+     * @brief Improves a tour until no improving 2-opt move is left or the control asks it to stop (checked every round).
+     *
+     * Time complexity: O(R * V^2 / T) being R the number of rounds and T the number of threads
+     *
+     * @param tour The tour to improve.
+     * @param control Deadline, cancellation and progress reporting.
+     * @return The change in the tour cost (zero or negative).
+     */
+    double run(std::vector<int> &tour, SolverControl &control);
+
+    /**
+     * @brief Returns the number of rounds of the last call to run().
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of rounds.
+     */
+    int getRounds() const;
+
+    /**
+     * @brief Returns the number of moves applied by the last call to run().
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of moves.
+     */
+    long long getMoves() const;
+
+private:
+    /**
+     * @struct Move
+     * @brief A 2-opt move that reverses the tour between positions i + 1 and j.
+     */
+    struct Move
+    {
+        double delta;
+        int i;
+        int j;
+    };
+
+    const TSPInstance &instance;
+    int threads;
+    int rounds = 0;
+    long long moves = 0;
+
+    void scanRows(const std::vector<int> &tour, const std::vector<double> &edges, int firstRow, int lastRow,
+                  std::vector<Move> &out) const;
+    static std::vector<int> balancedRows(int n, int parts);
+};
+
+#endif // DAPROJECT2_PARALLELTWOOPT_H
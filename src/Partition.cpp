@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include "Constructors.h"
+#include "Partition.h"
+
+std::vector<int> gridNeighbours(const TSPInstance &instance, const std::vector<double> &x, const std::vector<double> &y, int k)
+{
+    int n = instance.size();
+    k = std::max(0, std::min(k, n - 1));
+    std::vector<int> result((size_t)n * k);
+    if (k == 0)
+        return result;
+
+    double minX = *std::min_element(x.begin(), x.end()), maxX = *std::max_element(x.begin(), x.end());
+    double minY = *std::min_element(y.begin(), y.end()), maxY = *std::max_element(y.begin(), y.end());
+    double width = std::max(maxX - minX, 1e-9), height = std::max(maxY - minY, 1e-9);
+
+    // about two points per cell (the second term keeps points spread along a line from getting a cell each)
+    double cell = std::max(std::sqrt(width * height * 2 / n), std::max(width, height) * 2 / n);
+    int columns = std::min((int)(width / cell) + 1, n), rows = std::min((int)(height / cell) + 1, n);
+    auto column = [&](int i) { return std::min(columns - 1, (int)((x[i] - minX) / cell)); };
+    auto row = [&](int i) { return std::min(rows - 1, (int)((y[i] - minY) / cell)); };
+
+    // points sorted by cell: the points of cell c are items[start[c]] to items[start[c + 1] - 1]
+    std::vector<int> start((size_t)columns * rows + 1, 0), items(n);
+    for (int i = 0; i < n; i++)
+        start[(size_t)row(i) * columns + column(i) + 1]++;
+    for (size_t c = 1; c < start.size(); c++)
+        start[c] += start[c - 1];
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (int i = 0; i < n; i++)
+        items[fill[(size_t)row(i) * columns + column(i)]++] = i;
+
+    std::vector<std::pair<double, int>> candidates;
+    for (int i = 0; i < n; i++)
+    {
+        int cx = column(i), cy = row(i);
+        auto visit = [&](int gx, int gy)
+        {
+            if (gx < 0 || gy < 0 || gx >= columns || gy >= rows)
+                return;
+            size_t c = (size_t)gy * columns + gx;
+            for (int a = start[c]; a < start[c + 1]; a++)
+                if (items[a] != i)
+                    candidates.emplace_back(instance.dist(i, items[a]), items[a]);
+        };
+
+        candidates.clear();
+        int foundRing = -1;
+        for (int r = 0; r <= std::max(columns, rows); r++)
+        {
+            if (r == 0)
+                visit(cx, cy);
+            for (int d = -r; d <= r && r > 0; d++)
+            {
+                visit(cx + d, cy - r);
+                visit(cx + d, cy + r);
+            }
+            for (int d = -r + 1; d <= r - 1; d++)
+            {
+                visit(cx - r, cy + d);
+                visit(cx + r, cy + d);
+            }
+            if (foundRing == -1 && (int)candidates.size() >= k)
+                foundRing = r;
+            if (foundRing != -1 && r > foundRing)
+                break;
+        }
+
+        std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+        for (int a = 0; a < k; a++)
+            result[(size_t)i * k + a] = candidates[a].second;
+    }
+    return result;
+}
+
+std::vector<int> candidateNeighbours(const TSPInstance &instance, int k)
+{
+    int n = instance.size();
+    if (instance.isDense() || !instance.hasCoordinates() || n == 0)
+        return instance.nearestNeighbours(k);
+
+    double refLat = 0;
+    for (int i = 0; i < n; i++)
+        refLat += instance.getLatitude(i) / n;
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; i++)
+        projectCoordinates(instance.getMetric(), instance.getLatitude(i), instance.getLongitude(i), refLat, x[i], y[i]);
+    return gridNeighbours(instance, x, y, k);
+}
+
+PartitionSolver::PartitionSolver(const TSPInstance &instance, const PartitionParameters &params)
+    : instance(instance), params(params)
+{
+    int n = instance.size();
+    this->params.clusterSize = std::max(2, params.clusterSize);
+    this->params.threads = std::max(1, params.threads);
+
+    double refLat = 0;
+    for (int i = 0; i < n; i++)
+        refLat += instance.getLatitude(i) / n;
+    this->x.resize(n);
+    this->y.resize(n);
+    for (int i = 0; i < n; i++)
+        projectCoordinates(instance.getMetric(), instance.getLatitude(i), instance.getLongitude(i), refLat, x[i], y[i]);
+
+    this->neighbours = gridNeighbours(instance, x, y, params.neighbours);
+    this->k = std::max(0, std::min(params.neighbours, n - 1));
+}
+
+int PartitionSolver::getClusters() const
+{
+    return (int)this->clusters.size();
+}
+
+void PartitionSolver::bisect(std::vector<int> &indexes, int first, int last)
+{
+    if (last - first <= params.clusterSize)
+    {
+        clusters.emplace_back(indexes.begin() + first, indexes.begin() + last);
+        return;
+    }
+
+    double minX = x[indexes[first]], maxX = minX, minY = y[indexes[first]], maxY = minY;
+    for (int i = first + 1; i < last; i++)
+    {
+        minX = std::min(minX, x[indexes[i]]);
+        maxX = std::max(maxX, x[indexes[i]]);
+        minY = std::min(minY, y[indexes[i]]);
+        maxY = std::max(maxY, y[indexes[i]]);
+    }
+    const std::vector<double> &axis = maxX - minX >= maxY - minY ? x : y;
+
+    int middle = first + (last - first) / 2;
+    std::nth_element(indexes.begin() + first, indexes.begin() + middle, indexes.begin() + last,
+                     [&](int a, int b) { return axis[a] < axis[b]; });
+    bisect(indexes, first, middle);
+    bisect(indexes, middle, last);
+}
+
+std::vector<int> PartitionSolver::solveCluster(const std::vector<int> &cluster, bool improve) const
+{
+    TSPInstance sub = instance.subset(cluster);
+    std::vector<int> tour = mstPreorderTour(sub, 0);
+    int subK = std::min(params.neighbours, sub.size() - 1);
+    if (improve && subK > 0)
+        twoOptNeighbours(sub, tour, sub.nearestNeighbours(subK), subK);
+    for (int &v : tour)
+        v = cluster[v];
+    return tour;
+}
+
+void PartitionSolver::merge(std::vector<int> &tour, std::vector<int> &pos, const std::vector<int> &cluster, std::vector<int> &seams) const
+{
+    int m = (int)cluster.size();
+    if (tour.empty())
+    {
+        tour = cluster;
+        for (int i = 0; i < m; i++)
+            pos[tour[i]] = i;
+        return;
+    }
+
+    // exchange the tour edge (a, b) and the cluster edge (c, c1) for (a, c1) and (c, b), or for (a, c) and (c1, b)
+    int t = (int)tour.size();
+    double bestDelta = std::numeric_limits<double>::max();
+    int bestP = -1, bestQ = -1;
+    bool forward = true;
+    auto tryExchange = [&](int p, int q)
+    {
+        int a = tour[p], b = tour[(p + 1) % t], c = cluster[q], c1 = cluster[(q + 1) % m];
+        double removed = instance.dist(a, b) + instance.dist(c, c1);
+        double viaC1 = instance.dist(a, c1) + instance.dist(c, b) - removed;
+        double viaC = instance.dist(a, c) + instance.dist(c1, b) - removed;
+        if (std::min(viaC1, viaC) < bestDelta)
+        {
+            bestDelta = std::min(viaC1, viaC);
+            bestP = p;
+            bestQ = q;
+            forward = viaC1 <= viaC;
+        }
+    };
+
+    // only tour edges next to a neighbour of the cluster are tried
+    for (int q = 0; q < m; q++)
+        for (int x = 0; x < k; x++)
+        {
+            int w = neighbours[(size_t)cluster[q] * k + x];
+            if (pos[w] == -1)
+                continue;
+            tryExchange(pos[w], q);
+            tryExchange((pos[w] - 1 + t) % t, q);
+        }
+    if (bestP == -1)
+        for (int p = 0; p < t; p++)
+            for (int q = 0; q < m; q++)
+                tryExchange(p, q);
+
+    std::vector<int> piece(m);
+    for (int s = 0; s < m; s++)
+        piece[s] = forward ? cluster[(bestQ + 1 + s) % m] : cluster[(bestQ - s + m) % m];
+    seams.insert(seams.end(), {tour[bestP], tour[(bestP + 1) % t], piece.front(), piece.back()});
+
+    tour.insert(tour.begin() + bestP + 1, piece.begin(), piece.end());
+    for (int i = bestP + 1; i < (int)tour.size(); i++)
+        pos[tour[i]] = i;
+}
+
+std::vector<int> PartitionSolver::run(SolverControl &control)
+{
+    int n = instance.size();
+    clusters.clear();
+    std::vector<int> indexes(n);
+    std::iota(indexes.begin(), indexes.end(), 0);
+    if (n > 0)
+        bisect(indexes, 0, n);
+
+    int count = (int)clusters.size();
+    std::vector<std::vector<int>> tours(count);
+    std::atomic<int> next(0);
+    auto work = [&]()
+    {
+        int c;
+        while ((c = next++) < count)
+            tours[c] = solveCluster(clusters[c], !control.shouldStop());
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < std::min(params.threads, count); t++)
+        pool.emplace_back(work);
+    work();
+    for (auto &t : pool)
+        t.join();
+
+    std::vector<int> tour, pos(n, -1), seams;
+    for (int c = 0; c < count; c++)
+        merge(tour, pos, tours[c], seams);
+    control.report(instance.tourCost(tour), n);
+
+    if (!control.shouldStop() && n >= 4 && k > 0)
+    {
+        LocalSearchWorkspace workspace;
+        workspace.pos = pos;
+        workspace.queue.resize(n);
+        workspace.inQueue.assign(n, 0);
+        twoOptFrom(instance, tour, neighbours, k, seams, workspace, nullptr);
+        control.report(instance.tourCost(tour));
+    }
+    return tour;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file Partition.h
+ * @brief This file contains the divide-and-conquer solver for large coordinate graphs.
+ */
+
+#ifndef DAPROJECT2_PARTITION_H
+#define DAPROJECT2_PARTITION_H
+
+#include <vector>
+#include "LocalSearch.h"
+
+/**
+ * @struct PartitionParameters
+ * @brief Parameters of the partition solver.
+ */
+struct PartitionParameters
+{
+    int clusterSize = 500; /**< Largest number of vertices in a cluster. */
+    int neighbours = 8;    /**< Size of the neighbour lists used by the stitching and the 2-opt passes. */
+    int threads = 4;       /**< Threads solving clusters. */
+};
+
+/**
+ * @brief Computes approximate k nearest neighbour lists of points in the plane with a uniform grid.
+ *
+ * The points are bucketed into a grid with about two points per cell. The candidates of a vertex are the points in the
+ * rings of cells around its own, up to one ring past the first one where k candidates were found; the k closest
+ * candidates (by TSPInstance::dist) are kept. Neighbours beyond that ring may be missed.
+ *
+ * Time complexity: O(V * C * log(k)) being C the number of candidates per vertex (O(k) for evenly spread points)
+ *
+ * @param instance The instance the points belong to.
+ * @param x First planar coordinate of every vertex (see projectCoordinates).
+ * @param y Second planar coordinate of every vertex.
+ * @param k The number of neighbours per vertex.
+ * @return The neighbour lists, stored as V consecutive blocks of min(k, V - 1) indexes sorted by increasing distance.
+ */
+std::vector<int> gridNeighbours(const TSPInstance &instance, const std::vector<double> &x, const std::vector<double> &y, int k);
+
+/**
+ * @brief Builds the neighbour lists of the local searches: with gridNeighbours for coordinate instances without a
+ * matrix, whose exact lists would take O(V^2) distance computations, and with TSPInstance::nearestNeighbours otherwise.
+ *
+ * Time complexity: O(V * C * log(k)) for coordinate instances without a matrix, O(V^2 * log(k)) otherwise
+ *
+ * @param instance The instance.
+ * @param k The number of neighbours per vertex.
+ * @return The neighbour lists, as V consecutive blocks of min(k, V - 1) indexes sorted by increasing distance.
+ */
+std::vector<int> candidateNeighbours(const TSPInstance &instance, int k);
+
+/**
+ * @class PartitionSolver
+ * @brief Divide-and-conquer solver for instances too large for the O(V^2) pipelines.
+ *
+ * The vertices are split by recursive bisection of their projected coordinates (at the median of the wider side)
+ * until every cluster has at most clusterSize vertices. Each cluster is solved in parallel as its own instance with
+ * the MST preorder tour (the array version of prim + dfs) followed by 2-opt. The cluster tours are then merged into
+ * one: each cluster is spliced into the tour built so far by exchanging one of its edges with a tour edge next to a
+ * neighbour of its vertices, choosing the cheapest exchange. Finally, 2-opt over neighbour lists is run from the
+ * vertices at the seams only.
+ * Only coordinate instances (real-world graphs and TSPLIB coordinate instances) can be partitioned.
+ */
+class PartitionSolver
+{
+public:
+    /**
+     * @brief Constructs the solver for an instance.
+     *
+     * @param instance The instance to solve; it must have coordinates.
+     * @param params The parameters.
+     */
+    PartitionSolver(const TSPInstance &instance, const PartitionParameters &params);
+
+    /**
+     * @brief Solves the instance. If the control asks it to stop, the remaining clusters skip 2-opt and the seams are not improved.
+     *
+     * Time complexity: O(V * (C + k) + V^2 / C + C^2 * P) being C the cluster size and P the number of 2-opt passes per cluster
+     *
+     * @param control Deadline, cancellation and progress reporting.
+     * @return The tour.
+     */
+    std::vector<int> run(SolverControl &control);
+
+    /**
+     * @brief Returns the number of clusters of the last call to run().
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of clusters.
+     */
+    int getClusters() const;
+
+private:
+    const TSPInstance &instance;
+    PartitionParameters params;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<int> neighbours;
+    int k;
+    std::vector<std::vector<int>> clusters;
+
+    void bisect(std::vector<int> &indexes, int first, int last);
+    std::vector<int> solveCluster(const std::vector<int> &cluster, bool improve) const;
+    void merge(std::vector<int> &tour, std::vector<int> &pos, const std::vector<int> &cluster, std::vector<int> &seams) const;
+};
+
+#endif // DAPROJECT2_PARTITION_H
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <thread>
+#include "Constructors.h"
+#include "Portfolio.h"
+
+Portfolio::Portfolio(const TSPInstance &instance, const PortfolioParameters &params)
+    : instance(instance), params(params)
+{
+    this->params.runs = std::max(1, params.runs);
+    this->params.threads = std::max(1, std::min(params.threads, this->params.runs));
+    this->neighbours = instance.nearestNeighbours(params.neighbours);
+    this->k = std::max(0, std::min(params.neighbours, instance.size() - 1));
+}
+
+const std::vector<PortfolioRun> &Portfolio::getRuns() const
+{
+    return this->runs;
+}
+
+int Portfolio::getBestRun() const
+{
+    PortfolioRun *result = this->best.load();
+    return result == nullptr ? -1 : (int)(result - this->runs.data());
+}
+
+void Portfolio::publish(PortfolioRun *result)
+{
+    PortfolioRun *current = this->best.load();
+    while ((current == nullptr || result->cost < current->cost) && !this->best.compare_exchange_weak(current, result))
+    {
+    }
+}
+
+std::vector<int> Portfolio::run(SolverControl &control)
+{
+    int n = instance.size();
+    int runCount = params.runs, threads = params.threads;
+    int rounds = (runCount + threads - 1) / threads;
+
+    runs.assign(runCount, PortfolioRun());
+    best = nullptr;
+    std::atomic<int> next(0);
+    std::atomic<int> started(0);
+
+    auto work = [&]()
+    {
+        int r;
+        while (!control.shouldStop() && (r = next++) < runCount)
+        {
+            // every run gets an equal share of the time its thread has left
+            int roundsLeft = std::max(1, rounds - (started++ / threads));
+            SolverControl runControl(control.remaining() / roundsLeft, &control);
+
+            PortfolioRun &result = runs[r];
+            std::mt19937 rng(params.seed + r);
+            result.seed = params.seed + r;
+            result.start = std::uniform_int_distribution<int>(0, n - 1)(rng);
+
+            std::vector<int> tour;
+            switch (r % 3)
+            {
+            case 0:
+                result.constructor = "nearest neighbour";
+                tour = nearestNeighbourTour(instance, result.start);
+                break;
+            case 1:
+                result.constructor = "MST preorder";
+                tour = mstPreorderTour(instance, result.start);
+                break;
+            default:
+                result.constructor = "greedy edge";
+                tour = greedyEdgeTour(instance, neighbours, k, result.start);
+                break;
+            }
+
+            // a run cancelled after building its tour still publishes it
+            twoOptNeighbours(instance, tour, neighbours, k);
+            SolverControl firstHalf(runControl.remaining() / 2, &runControl);
+            iteratedLocalSearch(instance, tour, neighbours, k, firstHalf, result.seed);
+
+            // a straggler continues from the best finished run, whose slot is no longer written
+            PortfolioRun *leader = best.load();
+            if (leader != nullptr && leader->cost < instance.tourCost(tour))
+            {
+                tour = leader->tour;
+                result.restartedFrom = (int)(leader - runs.data());
+            }
+            iteratedLocalSearch(instance, tour, neighbours, k, runControl, result.seed);
+
+            result.cost = instance.tourCost(tour);
+            result.tour = std::move(tour);
+            publish(&result);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(work);
+    work();
+    for (auto &t : pool)
+        t.join();
+
+    PortfolioRun *result = best.load();
+    if (result == nullptr)
+        return nearestNeighbourTour(instance, 0);
+    return result->tour;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file Portfolio.h
+ * @brief This file contains the implementation of the multi-start portfolio solver.
+ */
+
+#ifndef DAPROJECT2_PORTFOLIO_H
+#define DAPROJECT2_PORTFOLIO_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "LocalSearch.h"
+
+/**
+ * @struct PortfolioParameters
+ * @brief Parameters of the portfolio solver.
+ */
+struct PortfolioParameters
+{
+    int runs = 8;          /**< Number of independent construct-then-improve runs. */
+    int threads = 4;       /**< Threads running the runs. */
+    int neighbours = 10;   /**< Size of the neighbour lists used by 2-opt and the greedy constructor. */
+    unsigned seed = 42;    /**< Base seed; run r uses seed + r. */
+};
+
+/**
+ * @struct PortfolioRun
+ * @brief Outcome of one run of the portfolio.
+ */
+struct PortfolioRun
+{
+    std::string constructor; /**< Name of the constructor used. */
+    int start = -1;          /**< Dense index of the start vertex. */
+    unsigned seed = 0;       /**< Seed of the iterated local search. */
+    int restartedFrom = -1;  /**< Run whose tour this run continued from halfway (-1 if it kept its own tour). */
+    double cost = INF;       /**< Cost of the final tour (INF if the run was cancelled before building one). */
+    std::vector<int> tour;   /**< The final tour. */
+};
+
+/**
+ * @class Portfolio
+ * @brief Runs independent construct-then-improve runs in parallel and keeps the best tour.
+ *
+ * Runs vary the constructor (nearest neighbour, MST preorder, greedy edge), the start vertex and the seed, and improve
+ * their tour with 2-opt followed by iterated local search for an equal share of the remaining time.
+ * Each run owns its result slot; the best result is published by a compare-and-swap on an atomic pointer to a slot,
+ * so no lock is taken. A slot is written once, before it is published, so runs read the shared best without a lock:
+ * halfway through its time, a run whose tour is worse than the best finished run continues from that run's tour. Every run has its own control, child of the portfolio's one, so when the deadline hits (or the
+ * portfolio is cancelled) the runs still going stop and publish the best tour they have.
+ */
+class Portfolio
+{
+public:
+    /**
+     * @brief Constructs the portfolio for an instance.
+     *
+     * @param instance The instance to solve.
+     * @param params The parameters.
+     */
+    Portfolio(const TSPInstance &instance, const PortfolioParameters &params);
+
+    /**
+     * @brief Runs the portfolio.
+     *
+     * Time complexity: O(R * (V^2 + K * k) / T) being R the number of runs, K the kicks per run and T the number of threads
+     *
+     * @param control Deadline, cancellation and progress reporting (it must have a deadline, which is shared among the runs).
+     * @return The best tour found.
+     */
+    std::vector<int> run(SolverControl &control);
+
+    /**
+     * @brief Returns the outcome of every run of the last call to run().
+     *
+     * Time complexity: O(1)
+     *
+     * @return The runs.
+     */
+    const std::vector<PortfolioRun> &getRuns() const;
+
+    /**
+     * @brief Returns the index of the run with the best tour of the last call to run().
+     *
+     * Time complexity: O(1)
+     *
+     * @return The index of the best run.
+     */
+    int getBestRun() const;
+
+private:
+    const TSPInstance &instance;
+    PortfolioParameters params;
+    std::vector<int> neighbours;
+    int k;
+    std::vector<PortfolioRun> runs;
+    std::atomic<PortfolioRun *> best{nullptr};
+
+    void publish(PortfolioRun *result);
+};
+
+#endif // DAPROJECT2_PORTFOLIO_H
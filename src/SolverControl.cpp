@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <csignal>
+#include <limits>
+#include "Graph.h"
+#include "SolverControl.h"
+
+SolverControl::SolverControl(double timeLimit, SolverControl *parentControl)
+    : parentControl(parentControl), start(std::chrono::steady_clock::now()), hasDeadline(timeLimit > 0 && timeLimit < 1e9), bestCost(INF)
+{
+    if (hasDeadline)
+        deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimit));
+}
+
+SolverControl::~SolverControl()
+{
+    stopReporting();
+}
+
+void SolverControl::cancel()
+{
+    this->cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool SolverControl::isCancelled() const
+{
+    return this->cancelled.load(std::memory_order_relaxed) || (parentControl != nullptr && parentControl->isCancelled());
+}
+
+void SolverControl::setTarget(double cost)
+{
+    this->target.store(cost, std::memory_order_relaxed);
+}
+
+bool SolverControl::shouldStop() const
+{
+    if (this->cancelled.load(std::memory_order_relaxed))
+        return true;
+    if (getBestCost() <= this->target.load(std::memory_order_relaxed))
+        return true;
+    if (hasDeadline && std::chrono::steady_clock::now() >= deadline)
+        return true;
+    return parentControl != nullptr && parentControl->shouldStop();
+}
+
+double SolverControl::remaining() const
+{
+    double left = std::numeric_limits<double>::max();
+    if (hasDeadline)
+        left = std::max(0.0, std::chrono::duration<double>(deadline - std::chrono::steady_clock::now()).count());
+    if (parentControl != nullptr)
+        left = std::min(left, parentControl->remaining());
+    return left;
+}
+
+void SolverControl::report(double cost, long long count)
+{
+    double current = this->bestCost.load(std::memory_order_relaxed);
+    while (cost < current && !this->bestCost.compare_exchange_weak(current, cost, std::memory_order_relaxed))
+    {
+    }
+    if (count != 0)
+        this->moves.fetch_add(count, std::memory_order_relaxed);
+    if (parentControl != nullptr)
+        parentControl->report(cost, count);
+}
+
+double SolverControl::getBestCost() const
+{
+    return this->bestCost.load(std::memory_order_relaxed);
+}
+
+ProgressSnapshot SolverControl::snapshot() const
+{
+    ProgressSnapshot result;
+    result.bestCost = getBestCost();
+    result.moves = this->moves.load(std::memory_order_relaxed);
+    result.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.movesPerSecond = result.elapsed > 0 ? result.moves / result.elapsed : 0;
+    return result;
+}
+
+void SolverControl::startReporting(std::function<void(const ProgressSnapshot &)> callback, double interval)
+{
+    stopReporting();
+    reporterStop = false;
+    reporter = std::thread([this, callback, interval]()
+    {
+        auto period = std::chrono::duration<double>(interval);
+        long long lastMoves = 0;
+        double lastElapsed = 0;
+        std::unique_lock<std::mutex> lock(reporterMutex);
+        while (!reporterWake.wait_for(lock, period, [this] { return reporterStop; }))
+        {
+            ProgressSnapshot s = snapshot();
+            double window = s.elapsed - lastElapsed;
+            long long done = s.moves - lastMoves;
+            lastMoves = s.moves;
+            lastElapsed = s.elapsed;
+            s.movesPerSecond = window > 0 ? done / window : 0;
+            callback(s);
+        }
+    });
+}
+
+void SolverControl::stopReporting()
+{
+    if (!reporter.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(reporterMutex);
+        reporterStop = true;
+    }
+    reporterWake.notify_all();
+    reporter.join();
+}
+
+static std::atomic<SolverControl *> interrupted{nullptr};
+
+static void onInterrupt(int)
+{
+    SolverControl *control = interrupted.load();
+    if (control != nullptr)
+        control->cancel();
+}
+
+InterruptGuard::InterruptGuard(SolverControl &control)
+{
+    interrupted = &control;
+    previous = std::signal(SIGINT, onInterrupt);
+}
+
+InterruptGuard::~InterruptGuard()
+{
+    std::signal(SIGINT, previous == SIG_ERR ? SIG_DFL : previous);
+    interrupted = nullptr;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file SolverControl.h
+ * @brief This file contains the deadline, cancellation and progress reporting shared by the solvers.
+ */
+
+#ifndef DAPROJECT2_SOLVERCONTROL_H
+#define DAPROJECT2_SOLVERCONTROL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @struct ProgressSnapshot
+ * @brief State of a running solver, as seen by the progress callback.
+ */
+struct ProgressSnapshot
+{
+    double bestCost;       /**< Cost of the best tour found so far (INF if none yet). */
+    long long moves;       /**< Moves (or nodes, kicks, tours) evaluated so far. */
+    double movesPerSecond; /**< Moves per second since the previous snapshot. */
+    double elapsed;        /**< Seconds since the control was created. */
+};
+
+/**
+ * @class SolverControl
+ * @brief Deadline, cancellation token and progress counters of one solver run.
+ *
+ * Solvers poll shouldStop() in their main loops and, when it returns true, stop and return the best tour found so far.
+ * They call report() whenever they find a better tour or finish a batch of moves; both counters are atomics, so any
+ * number of solver threads can report without locking. A control can have a parent: it then also stops when the parent
+ * stops, and forwards its reports to it (used by solvers that run sub-solvers with their own time slices).
+ * An optional reporting thread periodically sends snapshots to a callback.
+ */
+class SolverControl
+{
+public:
+    /**
+     * @brief Constructs a control.
+     *
+     * @param timeLimit Wall-clock limit in seconds (zero, negative or huge for no limit).
+     * @param parentControl The parent control, or nullptr.
+     */
+    explicit SolverControl(double timeLimit = 0, SolverControl *parentControl = nullptr);
+
+    /**
+     * @brief Stops the reporting thread, if it is running.
+     */
+    ~SolverControl();
+
+    SolverControl(const SolverControl &) = delete;
+    SolverControl &operator=(const SolverControl &) = delete;
+
+    /**
+     * @brief Requests the solver to stop. Safe to call from any thread and from a signal handler.
+     *
+     * Time complexity: O(1)
+     */
+    void cancel();
+
+    /**
+     * @brief Checks whether the control (or its parent) was cancelled.
+     *
+     * Time complexity: O(1)
+     *
+     * @return True if cancel() was called.
+     */
+    bool isCancelled() const;
+
+    /**
+     * @brief Sets a target cost: the solver stops as soon as a tour at least this cheap is reported.
+     *
+     * Time complexity: O(1)
+     *
+     * @param cost The target cost (negative for none).
+     */
+    void setTarget(double cost);
+
+    /**
+     * @brief Checks whether the solver should stop, because it was cancelled, the deadline passed or the target was reached.
+     *
+     * Time complexity: O(1)
+     *
+     * @return True if the solver should stop.
+     */
+    bool shouldStop() const;
+
+    /**
+     * @brief Returns the number of seconds left until the deadline.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The seconds left (a very large value if there is no deadline, zero if it passed).
+     */
+    double remaining() const;
+
+    /**
+     * @brief Records progress: a tour cost (kept if it is the best so far) and a number of moves.
+     *
+     * Time complexity: O(1)
+     *
+     * @param cost The cost of a tour the solver holds (INF to only count moves).
+     * @param moves The number of moves done since the last report.
+     */
+    void report(double cost, long long moves = 0);
+
+    /**
+     * @brief Returns the best cost reported so far.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The best cost (INF if none was reported).
+     */
+    double getBestCost() const;
+
+    /**
+     * @brief Returns the current progress.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The snapshot (movesPerSecond is the average since the start).
+     */
+    ProgressSnapshot snapshot() const;
+
+    /**
+     * @brief Starts a thread that calls the callback with a snapshot every interval, until stopReporting() or destruction.
+     *
+     * @param callback The progress callback. It runs on the reporting thread.
+     * @param interval Seconds between snapshots.
+     */
+    void startReporting(std::function<void(const ProgressSnapshot &)> callback, double interval = 1);
+
+    /**
+     * @brief Stops the reporting thread and waits for it.
+     */
+    void stopReporting();
+
+private:
+    SolverControl *parentControl;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point deadline;
+    bool hasDeadline;
+    std::atomic<bool> cancelled{false};
+    std::atomic<double> bestCost;
+    std::atomic<double> target{-1};
+    std::atomic<long long> moves{0};
+
+    std::thread reporter;
+    std::mutex reporterMutex;
+    std::condition_variable reporterWake;
+    bool reporterStop = false;
+};
+
+/**
+ * @class InterruptGuard
+ * @brief While alive, makes Ctrl+C (SIGINT) cancel the given control instead of terminating the program.
+ */
+class InterruptGuard
+{
+public:
+    /**
+     * @brief Installs the SIGINT handler for the control.
+     *
+     * @param control The control to cancel on SIGINT.
+     */
+    explicit InterruptGuard(SolverControl &control);
+
+    /**
+     * @brief Restores the previous SIGINT handler.
+     */
+    ~InterruptGuard();
+
+    InterruptGuard(const InterruptGuard &) = delete;
+    InterruptGuard &operator=(const InterruptGuard &) = delete;
+
+private:
+    void (*previous)(int);
+};
+
+#endif // DAPROJECT2_SOLVERCONTROL_H
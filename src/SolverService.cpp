@@ -0,0 +1,691 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+#include "SolverService.h"
+#include "AntColony.h"
+#include "Constructors.h"
+#include "GeneticAlgorithm.h"
+#include "MetricClosure.h"
+#include "Partition.h"
+#include "Portfolio.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+namespace
+{
+    /*
+     * Value of a request field. Only what the requests use is parsed: strings, numbers, booleans, null and arrays of
+     * numbers. raw keeps the text of the value, so the id can be copied to the response as it came.
+     */
+    struct JsonValue
+    {
+        enum Type { String, Number, Bool, Null, Array } type = Null;
+        std::string text;
+        double number = 0;
+        bool boolean = false;
+        std::vector<double> numbers;
+        std::string raw;
+    };
+
+    class JsonParser
+    {
+    public:
+        explicit JsonParser(const std::string &text) : text(text) {}
+
+        bool parseObject(std::map<std::string, JsonValue> &fields, std::string &error)
+        {
+            skipSpace();
+            if (!consume('{'))
+                return fail("expected a JSON object", error);
+            skipSpace();
+            if (consume('}'))
+                return atEnd(error);
+            while (true)
+            {
+                skipSpace();
+                std::string key;
+                if (!parseString(key))
+                    return fail("expected a string key", error);
+                skipSpace();
+                if (!consume(':'))
+                    return fail("expected ':' after \"" + key + "\"", error);
+                skipSpace();
+                JsonValue value;
+                if (!parseValue(value))
+                    return fail("invalid value of \"" + key + "\"", error);
+                fields[key] = value;
+                skipSpace();
+                if (consume('}'))
+                    return atEnd(error);
+                if (!consume(','))
+                    return fail("expected ',' or '}'", error);
+            }
+        }
+
+    private:
+        const std::string &text;
+        size_t pos = 0;
+
+        bool fail(const std::string &message, std::string &error) const
+        {
+            error = message + " at column " + std::to_string(pos + 1);
+            return false;
+        }
+
+        bool atEnd(std::string &error)
+        {
+            skipSpace();
+            return pos == text.size() || fail("unexpected text after the object", error);
+        }
+
+        void skipSpace()
+        {
+            while (pos < text.size() && std::isspace((unsigned char)text[pos]))
+                pos++;
+        }
+
+        bool consume(char c)
+        {
+            if (pos < text.size() && text[pos] == c)
+            {
+                pos++;
+                return true;
+            }
+            return false;
+        }
+
+        bool consumeWord(const char *word)
+        {
+            size_t length = std::strlen(word);
+            if (text.compare(pos, length, word) != 0)
+                return false;
+            pos += length;
+            return true;
+        }
+
+        bool parseString(std::string &out)
+        {
+            if (!consume('"'))
+                return false;
+            while (pos < text.size() && text[pos] != '"')
+            {
+                char c = text[pos++];
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+                if (pos == text.size())
+                    return false;
+                char e = text[pos++];
+                switch (e)
+                {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u':
+                {
+                    // only the code point is kept, as UTF-8
+                    if (pos + 4 > text.size() || !std::all_of(text.begin() + pos, text.begin() + pos + 4,
+                                                              [](char h) { return std::isxdigit((unsigned char)h); }))
+                        return false;
+                    unsigned code = (unsigned)std::stoul(text.substr(pos, 4), nullptr, 16);
+                    pos += 4;
+                    if (code < 0x80)
+                        out += (char)code;
+                    else if (code < 0x800)
+                    {
+                        out += (char)(0xC0 | (code >> 6));
+                        out += (char)(0x80 | (code & 0x3F));
+                    }
+                    else
+                    {
+                        out += (char)(0xE0 | (code >> 12));
+                        out += (char)(0x80 | ((code >> 6) & 0x3F));
+                        out += (char)(0x80 | (code & 0x3F));
+                    }
+                    break;
+                }
+                default: out += e;
+                }
+            }
+            return consume('"');
+        }
+
+        bool parseNumber(double &out)
+        {
+            size_t begin = pos;
+            if (pos < text.size() && (text[pos] == '-' || text[pos] == '+'))
+                pos++;
+            while (pos < text.size() && (std::isdigit((unsigned char)text[pos]) || std::strchr(".eE+-", text[pos])))
+                pos++;
+            if (begin == pos)
+                return false;
+            try
+            {
+                size_t used;
+                out = std::stod(text.substr(begin, pos - begin), &used);
+                return used == pos - begin;
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+        }
+
+        bool parseValue(JsonValue &value)
+        {
+            size_t begin = pos;
+            bool ok;
+            if (pos < text.size() && text[pos] == '"')
+            {
+                value.type = JsonValue::String;
+                ok = parseString(value.text);
+            }
+            else if (consume('['))
+            {
+                value.type = JsonValue::Array;
+                skipSpace();
+                ok = consume(']');
+                while (!ok)
+                {
+                    double number;
+                    skipSpace();
+                    if (!parseNumber(number))
+                        return false;
+                    value.numbers.push_back(number);
+                    skipSpace();
+                    ok = consume(']');
+                    if (!ok && !consume(','))
+                        return false;
+                }
+            }
+            else if (consumeWord("true") || consumeWord("false"))
+            {
+                value.type = JsonValue::Bool;
+                value.boolean = text[begin] == 't';
+                ok = true;
+            }
+            else if (consumeWord("null"))
+                ok = true;
+            else
+            {
+                value.type = JsonValue::Number;
+                ok = parseNumber(value.number);
+            }
+            value.raw = text.substr(begin, pos - begin);
+            return ok;
+        }
+    };
+
+    std::string jsonString(const std::string &text)
+    {
+        std::string out = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                out += '\\', out += c;
+            else if (c == '\n')
+                out += "\\n";
+            else if ((unsigned char)c < 0x20)
+                out += ' ';
+            else
+                out += c;
+        }
+        return out + "\"";
+    }
+
+    long long microsecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+#ifndef _WIN32
+    /*
+     * Accepted connection of the socket. It is shared by its reader thread and by the requests still running, and
+     * closed when the last of them lets it go.
+     */
+    struct Connection
+    {
+        int fd;
+        std::mutex writing;
+
+        explicit Connection(int fd) : fd(fd) {}
+
+        ~Connection()
+        {
+            close(fd);
+        }
+
+        void send(const std::string &line)
+        {
+            std::lock_guard<std::mutex> lock(writing);
+            std::string data = line + "\n";
+            size_t sent = 0;
+            while (sent < data.size())
+            {
+                ssize_t written = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                if (written <= 0)
+                    return;
+                sent += written;
+            }
+        }
+    };
+#endif
+}
+
+std::vector<int> solveTour(const TSPInstance &instance, std::vector<int> start, const SolveOptions &options,
+                           SolverControl &control, std::string &error)
+{
+    const std::string &algorithm = options.algorithm;
+    bool known = algorithm == "triangular" || algorithm == "2opt" || algorithm == "ils" || algorithm == "ga" ||
+                 algorithm == "aco" || algorithm == "portfolio" || algorithm == "partition";
+    if (!known)
+    {
+        error = "unknown algorithm " + algorithm;
+        return {};
+    }
+    // every tour of three vertices or less has the same length
+    if (algorithm == "triangular" || instance.size() < 4)
+        return start;
+
+    int k = std::min(10, instance.size() - 1);
+    if (algorithm == "2opt" || algorithm == "ils")
+    {
+        std::vector<int> neighbours = candidateNeighbours(instance, k);
+        twoOptNeighbours(instance, start, neighbours, k, &control);
+        if (algorithm == "ils")
+            iteratedLocalSearch(instance, start, neighbours, k, control, options.seed);
+        return start;
+    }
+    if (algorithm == "ga")
+    {
+        GeneticParameters params;
+        params.seed = options.seed;
+        params.islands = options.threads;
+        return GeneticAlgorithm(instance, params).run(start, control);
+    }
+    if (algorithm == "aco")
+    {
+        if (instance.size() > AntColony::MAX_VERTICES)
+        {
+            error = "too many vertices for the ant colony (at most " + std::to_string(AntColony::MAX_VERTICES) + ")";
+            return {};
+        }
+        AntColonyParameters params;
+        params.seed = options.seed;
+        params.threads = options.threads;
+        return AntColony(instance, params).run(start, control);
+    }
+    if (algorithm == "portfolio")
+    {
+        PortfolioParameters params;
+        params.seed = options.seed;
+        params.threads = options.threads;
+        return Portfolio(instance, params).run(control);
+    }
+    if (!instance.hasCoordinates())
+    {
+        error = "the partition solver needs vertex coordinates";
+        return {};
+    }
+    PartitionParameters params;
+    params.threads = options.threads;
+    return PartitionSolver(instance, params).run(control);
+}
+
+std::vector<int> solveSubset(const Graph &graph, const std::vector<int> &ids, const SolveOptions &options,
+                             SolverControl &control, TSPInstance &instance, std::string &error, std::vector<int> *walk)
+{
+    std::unordered_set<int> seen;
+    for (int id : ids)
+    {
+        if (graph.findVertex(id) == nullptr)
+        {
+            error = "vertex " + std::to_string(id) + " is not in the graph";
+            return {};
+        }
+        if (!seen.insert(id).second)
+        {
+            error = "vertex " + std::to_string(id) + " is repeated";
+            return {};
+        }
+    }
+    if (ids.empty())
+    {
+        error = "no vertices to visit";
+        return {};
+    }
+    if (!options.closure)
+    {
+        instance = TSPInstance::fromGraph(graph, ids);
+        return solveTour(instance, mstPreorderTour(instance, 0), options, control, error);
+    }
+
+    if ((int)ids.size() > TSPInstance::DENSE_LIMIT)
+    {
+        error = "the metric closure is limited to " + std::to_string(TSPInstance::DENSE_LIMIT) + " vertices";
+        return {};
+    }
+    MetricClosure closure(graph, ids, options.threads);
+    instance = closure.toInstance();
+    std::vector<int> tour = solveTour(instance, mstPreorderTour(instance, 0), options, control, error);
+    if (walk != nullptr && !tour.empty())
+        *walk = closure.expandTour(tour);
+    return tour;
+}
+
+SolverService::SolverService(const std::string &baseDir, int workers, size_t memoryBudget)
+    : registry(baseDir, memoryBudget)
+{
+    for (int t = 0; t < std::max(1, workers); t++)
+        this->workers.emplace_back([this] { work(); });
+}
+
+SolverService::~SolverService()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    for (auto &worker : workers)
+        worker.join();
+}
+
+bool SolverService::submit(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (queue.size() >= QUEUE_LIMIT)
+            return false;
+        queue.push_back(std::move(job));
+    }
+    queueChanged.notify_all();
+    return true;
+}
+
+void SolverService::drain()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueChanged.wait(lock, [this] { return queue.empty() && running == 0; });
+}
+
+void SolverService::work()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true)
+    {
+        queueChanged.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty())
+            return;
+        std::function<void()> job = std::move(queue.front());
+        queue.pop_front();
+        running++;
+        lock.unlock();
+        job();
+        lock.lock();
+        running--;
+        queueChanged.notify_all();
+    }
+}
+
+bool SolverService::preload(const std::string &path, bool real, std::string &error, int nearest)
+{
+    return registry.acquire(path, real, true, error, nullptr, nearest).graph != nullptr;
+}
+
+void SolverService::handle(const std::string &line, const std::function<void(const std::string &)> &reply)
+{
+    auto received = std::chrono::steady_clock::now();
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+        return;
+
+    std::map<std::string, JsonValue> fields;
+    std::string error;
+    if (!JsonParser(line).parseObject(fields, error))
+    {
+        reply("{\"id\":null,\"error\":" + jsonString(error) + "}");
+        return;
+    }
+    std::string id = fields.count("id") ? fields["id"].raw : "null";
+    auto fail = [id, reply](const std::string &message) { reply("{\"id\":" + id + ",\"error\":" + jsonString(message) + "}"); };
+
+    std::string op = fields.count("op") ? fields["op"].text : "solve";
+    if (op == "shutdown")
+    {
+        shutdownRequested = true;
+#ifndef _WIN32
+        int fd = listenSocket.exchange(-1);
+        if (fd != -1)
+            shutdown(fd, SHUT_RDWR);
+#endif
+        reply("{\"id\":" + id + ",\"status\":\"shutting down\"}");
+        return;
+    }
+    if (op != "solve" && op != "load")
+        return fail("unknown op " + op);
+    if (!fields.count("graph") || fields["graph"].type != JsonValue::String)
+        return fail("missing \"graph\"");
+
+    std::string path = fields["graph"].text;
+    bool real = fields.count("real") && fields["real"].boolean;
+    int nearest = fields.count("nearest") ? std::max(0, (int)fields["nearest"].number) : 0;
+    SolveOptions options;
+    if (fields.count("algorithm"))
+        options.algorithm = fields["algorithm"].text;
+    if (fields.count("seed"))
+        options.seed = (unsigned)fields["seed"].number;
+    if (fields.count("threads"))
+    {
+        // at most one thread per core, so a request cannot start thousands of threads
+        double threads = fields["threads"].number;
+        if (!std::isfinite(threads))
+            return fail("\"threads\" must be a number");
+        int cores = (int)std::thread::hardware_concurrency();
+        options.threads = (int)std::clamp(threads, 1.0, (double)(cores > 0 ? cores : (int)this->workers.size()));
+    }
+    options.closure = fields.count("closure") && fields["closure"].boolean;
+    double deadline = fields.count("deadline") ? fields["deadline"].number : 30;
+    if (!(deadline > 0))
+        return fail("\"deadline\" must be positive");
+    bool hasVertices = fields.count("vertices") > 0;
+    std::vector<int> ids;
+    if (hasVertices)
+    {
+        if (fields["vertices"].type != JsonValue::Array)
+            return fail("\"vertices\" must be an array of vertex IDs");
+        for (double v : fields["vertices"].numbers)
+            ids.push_back((int)v);
+        if (ids.empty())
+            return fail("\"vertices\" is empty");
+    }
+
+    bool queued = submit([=, this]
+    {
+        long long queueTime = microsecondsSince(received);
+        try
+        {
+            // includes waiting for another request that is reading the same graph
+            std::string error;
+            auto loadStart = std::chrono::steady_clock::now();
+            ResidentGraph resident = registry.acquire(path, real, !hasVertices && op == "solve", error, nullptr, nearest);
+            long long loadTime = microsecondsSince(loadStart);
+            if (resident.graph == nullptr)
+                return fail(error);
+            if (op == "load")
+                return reply("{\"id\":" + id + ",\"vertices\":" + std::to_string(resident.graph->getNumVertex()) +
+                             ",\"queue_microseconds\":" + std::to_string(queueTime) + ",\"load_microseconds\":" +
+                             std::to_string(loadTime) + "}");
+
+            double remaining = deadline - microsecondsSince(received) / 1e6;
+            if (remaining <= 0)
+                return fail("the deadline passed before the request started");
+            SolverControl control(remaining);
+            auto start = std::chrono::steady_clock::now();
+
+            // subsets get their own instance; the whole graph starts from the triangular approximation of the graph
+            TSPInstance sub;
+            const TSPInstance *instance = &sub;
+            std::vector<int> tour, walk;
+            if (hasVertices)
+                tour = solveSubset(*resident.graph, ids, options, control, sub, error, &walk);
+            else
+            {
+                const TSPInstance &full = *resident.instance;
+                GraphScratch scratch;
+                Vertex *root = resident.graph->findVertex(full.getId(0)), *lastVertex = nullptr;
+                std::vector<Vertex *> path;
+                resident.graph->prim(scratch);
+                resident.graph->dfs(root, &lastVertex, path, scratch);
+                tour = full.toTour(path);
+                completeTour(full, tour);
+                instance = &full;
+                tour = solveTour(full, tour, options, control, error);
+            }
+            if (tour.empty())
+                return fail(error);
+            long long solveTime = microsecondsSince(start);
+
+            std::ostringstream out;
+            out << std::setprecision(15) << "{\"id\":" << id << ",\"algorithm\":" << jsonString(options.algorithm)
+                << ",\"cost\":";
+            double cost = instance->tourCost(tour);
+            if (cost >= INF)
+                out << "null";
+            else
+                out << cost;
+            out << ",\"tour\":[";
+            for (size_t i = 0; i < tour.size(); i++)
+                out << (i ? "," : "") << instance->getId(tour[i]);
+            if (!walk.empty())
+            {
+                out << "],\"walk\":[";
+                for (size_t i = 0; i < walk.size(); i++)
+                    out << (i ? "," : "") << walk[i];
+            }
+            out << "],\"queue_microseconds\":" << queueTime << ",\"load_microseconds\":" << loadTime
+                << ",\"solve_microseconds\":" << solveTime << "}";
+            reply(out.str());
+        }
+        catch (const std::exception &e)
+        {
+            fail(e.what());
+        }
+    });
+    if (!queued)
+        fail("busy");
+}
+
+void SolverService::serveStream(std::istream &in, std::ostream &out)
+{
+    std::mutex writing;
+    auto reply = [&](const std::string &line)
+    {
+        std::lock_guard<std::mutex> lock(writing);
+        out << line << std::endl;
+    };
+    std::string line;
+    while (!shutdownRequested && getline(in, line))
+        handle(line, reply);
+    drain();
+}
+
+bool SolverService::serveSocket(const std::string &socketPath, std::string &error)
+{
+#ifdef _WIN32
+    error = "Unix domain sockets are not available on Windows, use --serve - instead";
+    return false;
+#else
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        error = "the socket path is too long";
+        return false;
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1)
+    {
+        error = std::string("cannot create the socket: ") + std::strerror(errno);
+        return false;
+    }
+    unlink(socketPath.c_str());
+    if (bind(fd, (sockaddr *)&address, sizeof(address)) == -1 || listen(fd, 16) == -1)
+    {
+        error = "cannot listen on " + socketPath + ": " + std::strerror(errno);
+        close(fd);
+        return false;
+    }
+    listenSocket = fd;
+
+    std::vector<std::thread> readers;
+    std::mutex connectionsMutex;
+    std::vector<std::weak_ptr<Connection>> connections;
+    while (!shutdownRequested)
+    {
+        int client = accept(fd, nullptr, nullptr);
+        if (client == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        auto connection = std::make_shared<Connection>(client);
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            connections.push_back(connection);
+        }
+        readers.emplace_back([this, connection]
+        {
+            auto reply = [connection](const std::string &line) { connection->send(line); };
+            std::string buffer;
+            char chunk[4096];
+            ssize_t size;
+            while (!shutdownRequested && (size = recv(connection->fd, chunk, sizeof(chunk), 0)) > 0)
+            {
+                buffer.append(chunk, size);
+                size_t end;
+                while ((end = buffer.find('\n')) != std::string::npos)
+                {
+                    handle(buffer.substr(0, end), reply);
+                    buffer.erase(0, end + 1);
+                }
+            }
+            if (!buffer.empty() && !shutdownRequested)
+                handle(buffer, reply);
+        });
+    }
+
+    // the readers blocked on open connections stop reading; the requests already queued are still answered
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (auto &weak : connections)
+            if (auto connection = weak.lock())
+                shutdown(connection->fd, SHUT_RD);
+    }
+    for (auto &reader : readers)
+        reader.join();
+    drain();
+    listenSocket = -1;
+    close(fd);
+    unlink(socketPath.c_str());
+    return true;
+#endif
+}
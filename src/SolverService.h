@@ -0,0 +1,178 @@
+/**
+ * @file SolverService.h
+ * @brief This file contains the long-running solver service, which keeps graphs in memory and answers solve requests.
+ */
+
+#ifndef DAPROJECT2_SOLVERSERVICE_H
+#define DAPROJECT2_SOLVERSERVICE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GraphRegistry.h"
+#include "SolverControl.h"
+
+/**
+ * @struct SolveOptions
+ * @brief What a solve request asks for, besides the instance.
+ */
+struct SolveOptions
+{
+    std::string algorithm = "2opt"; /**< triangular, 2opt, ils, ga, aco, portfolio or partition. */
+    unsigned seed = 42;             /**< Seed of the randomized solvers. */
+    int threads = 1;                /**< Threads of the solvers that have them (ga, aco, portfolio, partition). */
+    bool closure = false;           /**< Whether a subset is solved on the shortest path distances between its vertices (see MetricClosure). */
+};
+
+/**
+ * @brief Solves an instance with one of the solvers, starting from a given tour.
+ *
+ * The starting tour is returned as is by triangular, improved with neighbour-list 2-opt by 2opt, and used as the seed
+ * of ils, ga and aco. Portfolio and partition build their own tours.
+ *
+ * Time complexity: the one of the chosen solver
+ *
+ * @param instance The instance.
+ * @param start A tour with every vertex of the instance.
+ * @param options The algorithm and its parameters.
+ * @param control Deadline and cancellation of the solver.
+ * @param error Receives the reason when the instance cannot be solved with the algorithm.
+ * @return The tour (empty on error).
+ */
+std::vector<int> solveTour(const TSPInstance &instance, std::vector<int> start, const SolveOptions &options,
+                           SolverControl &control, std::string &error);
+
+/**
+ * @brief Solves a tour over some of the vertices of a graph, on a sub-instance built directly from the graph
+ * (see TSPInstance::fromGraph), starting from the triangular approximation of the sub-instance.
+ *
+ * With options.closure the sub-instance holds the shortest path distances between the vertices instead, from a
+ * MetricClosure over them only, so its cost does not depend on the size of the graph; at most
+ * TSPInstance::DENSE_LIMIT vertices, since the closure is a dense matrix.
+ *
+ * Time complexity: O(S^2) to build the sub-instance and the starting tour, being S the number of vertices, plus the
+ * one of the chosen solver; plus O(S * (V + E) * log(V) / threads) with the closure
+ *
+ * @param graph The graph.
+ * @param ids IDs of the vertices the tour visits.
+ * @param options The algorithm and its parameters.
+ * @param control Deadline and cancellation of the solver.
+ * @param instance Receives the sub-instance; the tour is made of its indexes.
+ * @param error Receives the reason when an ID is not in the graph or repeated, or when the solver fails.
+ * @param walk Receives, with the closure, the closed walk over the graph edges that the tour stands for (vertex IDs).
+ * @return The tour (empty on error).
+ */
+std::vector<int> solveSubset(const Graph &graph, const std::vector<int> &ids, const SolveOptions &options,
+                             SolverControl &control, TSPInstance &instance, std::string &error,
+                             std::vector<int> *walk = nullptr);
+
+/**
+ * @class SolverService
+ * @brief Daemon that keeps graphs loaded and solves TSP requests received as JSON lines.
+ *
+ * Every request is one JSON object per line:
+ * - "op": "solve" (default), "load" (only loads the graph) or "shutdown" (stops reading requests).
+ * - "id": any string or number, copied to the response.
+ * - "graph": path of the graph (as in --graph, relative to the data directory); "real": true for real-world graphs;
+ *   "nearest": nearest neighbours kept per vertex of a CSV edge list (as in --nearest; 0, every edge, by default).
+ * - "algorithm", "seed", "threads": see SolveOptions; "threads" is limited to the number of cores.
+ * - "vertices": optional array of vertex IDs; the tour visits only these vertices.
+ * - "closure": true to solve the vertices on the shortest path distances between them (see solveSubset); the
+ *   response then also has the "walk" over the graph edges.
+ * - "deadline": seconds, counted from the reception of the request, to answer (30 by default).
+ *
+ * Each response is one JSON line with the id, the tour (vertex IDs, the first one not repeated at the end), its cost
+ * and the time spent waiting in the queue, loading the graph (close to zero when it was already loaded) and solving, in
+ * microseconds; or the id and an "error" message. Responses are written when the requests finish, so they can come
+ * out of order.
+ *
+ * The graphs are loaded the first time a request names them, and stay loaded in a GraphRegistry (with their TSPInstance,
+ * once a request asks for the whole graph) until the memory budget makes it drop the least recently used ones. Both are
+ * read-only and shared by every request; the per-request state (spanning tree scratch, sub-instances built by
+ * solveSubset) belongs to the worker.
+ * Requests run on a fixed pool of worker threads; the thread reading the requests only parses and queues them. When
+ * QUEUE_LIMIT requests are already waiting, a new one is answered at once with the error "busy".
+ */
+class SolverService
+{
+public:
+    static const size_t QUEUE_LIMIT = 256; /**< Requests waiting for a worker; more are answered with a "busy" error. */
+
+    /**
+     * @brief Constructs the service and starts its workers.
+     *
+     * @param baseDir Directory prepended to the graph paths of the requests.
+     * @param workers Number of worker threads (at least one).
+     * @param memoryBudget Memory of the graphs kept loaded, in bytes (0 for no limit); see GraphRegistry.
+     */
+    SolverService(const std::string &baseDir, int workers, size_t memoryBudget = 0);
+
+    /**
+     * @brief Waits for the queued requests and stops the workers.
+     */
+    ~SolverService();
+
+    SolverService(const SolverService &) = delete;
+    SolverService &operator=(const SolverService &) = delete;
+
+    /**
+     * @brief Loads a graph before the first request that uses it.
+     *
+     * Time complexity: O(V + E) the first time, O(log(G)) afterwards, being G the number of graphs loaded
+     *
+     * @param path Path of the graph, relative to the data directory.
+     * @param real Whether it is a real-world graph directory.
+     * @param error Receives the reason when the graph cannot be read.
+     * @param nearest Nearest neighbours kept per vertex of a CSV edge list (0 keeps every edge).
+     * @return True if the graph is loaded.
+     */
+    bool preload(const std::string &path, bool real, std::string &error, int nearest = 0);
+
+    /**
+     * @brief Answers the requests read from a stream until its end (or a shutdown request), then waits for the last ones.
+     *
+     * @param in The requests.
+     * @param out The responses.
+     */
+    void serveStream(std::istream &in, std::ostream &out);
+
+    /**
+     * @brief Listens on a Unix domain socket and answers the requests of every connection until a shutdown request.
+     *
+     * Every connection is read by its own thread; the responses are written to the connection of the request.
+     * Not available on Windows.
+     *
+     * @param socketPath Path of the socket (an existing file there is replaced).
+     * @param error Receives the reason when the socket cannot be opened.
+     * @return True if the service ran and was shut down.
+     */
+    bool serveSocket(const std::string &socketPath, std::string &error);
+
+private:
+    GraphRegistry registry; /**< The graphs, with their instances. */
+
+    std::mutex queueMutex;
+    std::condition_variable queueChanged;
+    std::deque<std::function<void()>> queue;
+    int running = 0;       /**< Jobs taken by a worker and not finished. */
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    std::atomic<bool> shutdownRequested{false};
+    std::atomic<int> listenSocket{-1}; /**< Listening socket of serveSocket, closed by a shutdown request. */
+
+    bool submit(std::function<void()> job);
+    void drain();
+    void work();
+    void handle(const std::string &line, const std::function<void(const std::string &)> &reply);
+};
+
+#endif // DAPROJECT2_SOLVERSERVICE_H
@@ -0,0 +1,337 @@
+#include <algorithm>
+#include <thread>
+#include "ContractionHierarchy.h"
+#include "TSPInstance.h"
+
+TSPInstance TSPInstance::fromGraph(const Graph &graph)
+{
+    std::vector<int> ids;
+    ids.reserve(graph.getNumVertex());
+    for (auto a : graph.getVertexMap())
+        ids.push_back(a.first);
+    std::sort(ids.begin(), ids.end());
+    return fromGraph(graph, ids);
+}
+
+TSPInstance TSPInstance::fromGraph(const Graph &graph, const std::vector<int> &ids)
+{
+    TSPInstance instance;
+    instance.ids = ids;
+    instance.n = (int)ids.size();
+    int n = instance.n;
+    std::vector<const Vertex *> vertices(n);
+    for (int i = 0; i < n; i++)
+    {
+        instance.indexOf[ids[i]] = i;
+        vertices[i] = graph.findVertex(ids[i]);
+    }
+
+    instance.metric = graph.getMetric();
+    bool real = graph.isReal();
+    if (real)
+    {
+        instance.latitude.resize(n);
+        instance.longitude.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            instance.latitude[i] = vertices[i]->getLatitude();
+            instance.longitude[i] = vertices[i]->getLongitude();
+        }
+    }
+
+    // a graph with a distance table has every distance in memory already, so its instance is dense whatever its size
+    bool table = graph.hasDistanceTable();
+    if (n <= DENSE_LIMIT || table)
+    {
+        instance.matrix.assign((size_t)n * n, INF);
+        for (int i = 0; i < n; i++)
+        {
+            instance.matrix[(size_t)i * n + i] = 0;
+            if (real)
+                for (int j = i + 1; j < n; j++)
+                {
+                    double d = coordinateDistance(instance.metric, instance.latitude[i], instance.longitude[i], instance.latitude[j], instance.longitude[j]);
+                    instance.matrix[(size_t)i * n + j] = d;
+                    instance.matrix[(size_t)j * n + i] = d;
+                }
+        }
+        if (table)
+        {
+            std::vector<int> position(n);
+            for (int i = 0; i < n; i++)
+                position[i] = graph.getTablePosition(ids[i]);
+            for (int i = 0; i < n; i++)
+                for (int j = i + 1; j < n; j++)
+                    if (position[i] != -1 && position[j] != -1)
+                    {
+                        double d = graph.getTableDistance(position[i], position[j]);
+                        if (d < INF)
+                        {
+                            instance.matrix[(size_t)i * n + j] = d;
+                            instance.matrix[(size_t)j * n + i] = d;
+                        }
+                    }
+        }
+    }
+
+    // the pairs without an edge get their shortest path distance from the oracle, as in Graph::getDistance: the whole
+    // table at once for dense instances, one query per pair otherwise
+    if (graph.getDistanceOracle() != nullptr && !table)
+    {
+        if (instance.matrix.empty())
+            instance.oracle = graph.getDistanceOracle();
+        else
+            instance.fillFromOracle(*graph.getDistanceOracle());
+    }
+
+    auto setWeight = [&instance, n](int i, int j, double weight)
+    {
+        if (!instance.matrix.empty())
+            instance.matrix[(size_t)i * n + j] = weight;
+        else
+            instance.explicitWeights[(long long)i * n + j] = weight;
+    };
+    for (int i = 0; i < n; i++)
+    {
+        // the shorter of the adjacency map and the kept vertices is scanned, and looked up in the other
+        const auto &adj = vertices[i]->getAdj();
+        if ((int)adj.size() <= n)
+        {
+            for (auto e : adj)
+            {
+                auto it = instance.indexOf.find(e.first);
+                if (it != instance.indexOf.end())
+                    setWeight(i, it->second, e.second->getWeight());
+            }
+        }
+        else
+            for (int j = 0; j < n; j++)
+            {
+                auto it = adj.find(ids[j]);
+                if (it != adj.end())
+                    setWeight(i, j, it->second->getWeight());
+            }
+    }
+    return instance;
+}
+
+void TSPInstance::fillFromOracle(const ContractionHierarchy &hierarchy)
+{
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<double> distances = hierarchy.table(this->ids, this->ids, threads);
+    for (size_t a = 0; a < distances.size(); a++)
+        if (distances[a] < INF)
+            this->matrix[a] = distances[a];
+}
+
+TSPInstance TSPInstance::fromDistances(const std::vector<int> &ids, std::vector<double> matrix)
+{
+    TSPInstance instance;
+    instance.ids = ids;
+    instance.n = (int)ids.size();
+    for (int i = 0; i < instance.n; i++)
+        instance.indexOf[ids[i]] = i;
+    instance.matrix = std::move(matrix);
+    return instance;
+}
+
+TSPInstance TSPInstance::subset(const std::vector<int> &indexes) const
+{
+    TSPInstance instance;
+    int n = (int)indexes.size();
+    instance.n = n;
+    instance.metric = this->metric;
+    instance.ids.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+        instance.ids[i] = this->ids[indexes[i]];
+        instance.indexOf[instance.ids[i]] = i;
+    }
+    if (!this->latitude.empty())
+    {
+        instance.latitude.resize(n);
+        instance.longitude.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            instance.latitude[i] = this->latitude[indexes[i]];
+            instance.longitude[i] = this->longitude[indexes[i]];
+        }
+    }
+
+    std::vector<int> newIndex(this->n, -1);
+    for (int i = 0; i < n; i++)
+        newIndex[indexes[i]] = i;
+    auto keepWeights = [&](auto setWeight)
+    {
+        for (auto &e : this->explicitWeights)
+        {
+            int i = newIndex[e.first / this->n], j = newIndex[e.first % this->n];
+            if (i != -1 && j != -1)
+                setWeight(i, j, e.second);
+        }
+    };
+
+    if (n <= DENSE_LIMIT && this->oracle != nullptr)
+    {
+        // same order as computeDist, with one table query instead of one oracle query per pair
+        instance.matrix.assign((size_t)n * n, INF);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                if (i == j)
+                    instance.matrix[(size_t)i * n + j] = 0;
+                else if (!instance.latitude.empty())
+                    instance.matrix[(size_t)i * n + j] = coordinateDistance(instance.metric, instance.latitude[i],
+                                                                            instance.longitude[i], instance.latitude[j],
+                                                                            instance.longitude[j]);
+        instance.fillFromOracle(*this->oracle);
+        keepWeights([&instance, n](int i, int j, double weight) { instance.matrix[(size_t)i * n + j] = weight; });
+    }
+    else if (n <= DENSE_LIMIT || !this->matrix.empty())
+    {
+        // a subset of a dense instance (which can be larger than DENSE_LIMIT with a distance table) is never larger
+        // than its parent's matrix, and has no other source for the distances when there are no coordinates
+        instance.matrix.resize((size_t)n * n);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                instance.matrix[(size_t)i * n + j] = dist(indexes[i], indexes[j]);
+    }
+    else
+    {
+        // this instance is larger, so it is not dense either: keep the explicit weights between kept vertices
+        instance.oracle = this->oracle;
+        keepWeights([&instance, n](int i, int j, double weight) { instance.explicitWeights[(long long)i * n + j] = weight; });
+    }
+    return instance;
+}
+
+int TSPInstance::size() const
+{
+    return this->n;
+}
+
+int TSPInstance::getId(int index) const
+{
+    return this->ids[index];
+}
+
+int TSPInstance::getIndex(int id) const
+{
+    auto it = this->indexOf.find(id);
+    if (it == this->indexOf.end())
+        return -1;
+    return it->second;
+}
+
+bool TSPInstance::isDense() const
+{
+    return !this->matrix.empty();
+}
+
+Metric TSPInstance::getMetric() const
+{
+    return this->metric;
+}
+
+bool TSPInstance::hasCoordinates() const
+{
+    return !this->latitude.empty();
+}
+
+double TSPInstance::getLatitude(int i) const
+{
+    return this->latitude[i];
+}
+
+double TSPInstance::getLongitude(int i) const
+{
+    return this->longitude[i];
+}
+
+const std::vector<double> &TSPInstance::getMatrix() const
+{
+    return this->matrix;
+}
+
+double TSPInstance::computeDist(int i, int j) const
+{
+    if (i == j)
+        return 0;
+    if (!this->explicitWeights.empty())
+    {
+        auto it = this->explicitWeights.find((long long)i * n + j);
+        if (it != this->explicitWeights.end())
+            return it->second;
+    }
+    if (this->oracle != nullptr)
+    {
+        double d = this->oracle->distance(this->ids[i], this->ids[j]);
+        if (d < INF)
+            return d;
+    }
+    if (this->latitude.empty())
+        return INF;
+    return coordinateDistance(this->metric, this->latitude[i], this->longitude[i], this->latitude[j], this->longitude[j]);
+}
+
+double TSPInstance::tourCost(const std::vector<int> &tour) const
+{
+    double total = 0;
+    int m = (int)tour.size();
+    for (int i = 0; i < m; i++)
+        total += dist(tour[i], tour[(i + 1) % m]);
+    return total;
+}
+
+std::vector<int> TSPInstance::nearestNeighbours(int k) const
+{
+    k = std::min(k, n - 1);
+    std::vector<int> result((size_t)n * std::max(k, 0));
+    if (k <= 0)
+        return result;
+
+    std::vector<std::pair<double, int>> heap;
+    for (int i = 0; i < n; i++)
+    {
+        // bounded max-heap with the k closest vertices seen so far
+        heap.clear();
+        for (int j = 0; j < n; j++)
+        {
+            if (j == i)
+                continue;
+            double d = dist(i, j);
+            if ((int)heap.size() < k)
+            {
+                heap.emplace_back(d, j);
+                std::push_heap(heap.begin(), heap.end());
+            }
+            else if (d < heap.front().first)
+            {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = {d, j};
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+        std::sort_heap(heap.begin(), heap.end());
+        for (int a = 0; a < k; a++)
+            result[(size_t)i * k + a] = heap[a].second;
+    }
+    return result;
+}
+
+std::vector<int> TSPInstance::toTour(const std::vector<Vertex *> &path) const
+{
+    std::vector<int> tour;
+    tour.reserve(path.size());
+    for (auto v : path)
+        tour.push_back(getIndex(v->getId()));
+    return tour;
+}
+
+size_t TSPInstance::memoryUsage() const
+{
+    const size_t node = sizeof(void *) + sizeof(std::pair<const long long, double>);
+    return sizeof(TSPInstance) + this->ids.capacity() * sizeof(int) + this->matrix.capacity() * sizeof(double) +
+           (this->latitude.capacity() + this->longitude.capacity()) * sizeof(double) +
+           (this->indexOf.bucket_count() + this->explicitWeights.bucket_count()) * sizeof(void *) +
+           (this->indexOf.size() + this->explicitWeights.size()) * node;
+}
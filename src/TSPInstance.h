@@ -0,0 +1,235 @@
+/**
+ * @file TSPInstance.h
+ * @brief This file contains the implementation of the TSPInstance class.
+ */
+
+#ifndef DAPROJECT2_TSPINSTANCE_H
+#define DAPROJECT2_TSPINSTANCE_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Graph.h"
+
+/**
+ * @class TSPInstance
+ * @brief Compact, read-only view of a graph used by the tour solvers.
+ *
+ * Vertices are remapped to dense indexes 0..n-1 (sorted by ID, so index 0 is the vertex with the smallest ID).
+ * Small instances keep a dense distance matrix; large coordinate instances keep the coordinates and compute
+ * distances on demand with the graph's metric, using the explicit edge weights when the graph has them.
+ * Unlike Graph::getDistance, every query is const, so one instance can be shared by several solver threads.
+ */
+class TSPInstance
+{
+public:
+    static const int DENSE_LIMIT = 3000; /**< Largest instance that stores a dense distance matrix. */
+
+    TSPInstance() = default;
+
+    /**
+     * @brief Builds an instance with every vertex of a graph.
+     *
+     * Missing edges on graphs without coordinates get distance INF, so the solvers avoid them. The pairs in the distance
+     * table of the graph (see Graph::setDistanceTable) get their distance, and the instance is then dense at any size.
+     * With a distance oracle (see Graph::setDistanceOracle), the pairs without an edge get their shortest path distance
+     * instead, like in Graph::getDistance.
+     *
+     * Time complexity: O(V^2 + E) for dense instances, plus the oracle's table query; O(V + E) otherwise
+     *
+     * @param graph The graph to convert.
+     * @return The instance.
+     */
+    static TSPInstance fromGraph(const Graph &graph);
+
+    /**
+     * @brief Builds an instance with some of the vertices of a graph, reading their coordinates and the weights of the
+     * edges between them directly from the graph (neither the whole instance nor any Vertex or Edge is built).
+     *
+     * Time complexity: O(S^2) for dense instances, O(S * min(S, D)) otherwise, being S the number of vertices kept and
+     * D the largest degree
+     *
+     * @param graph The graph.
+     * @param ids IDs of the vertices to keep, all in the graph and without repetitions; vertex ids[i] gets index i.
+     * @return The instance.
+     */
+    static TSPInstance fromGraph(const Graph &graph, const std::vector<int> &ids);
+
+    /**
+     * @brief Builds a dense instance from a distance matrix (for example shortest path distances, see MetricClosure).
+     *
+     * Time complexity: O(V)
+     *
+     * @param ids ID of every vertex; vertex ids[i] gets index i.
+     * @param matrix Distances, V x V in row-major order.
+     * @return The instance, without coordinates.
+     */
+    static TSPInstance fromDistances(const std::vector<int> &ids, std::vector<double> matrix);
+
+    /**
+     * @brief Builds an instance with some of the vertices of this one. The result is dense when it has at most
+     * DENSE_LIMIT vertices or this instance is dense.
+     *
+     * Time complexity: O(S^2) for dense results, O(S + E) otherwise, being S the number of vertices kept
+     *
+     * @param indexes Dense indexes of the vertices to keep; vertex indexes[i] becomes index i of the result.
+     * @return The instance.
+     */
+    TSPInstance subset(const std::vector<int> &indexes) const;
+
+    /**
+     * @brief Returns the number of vertices of the instance.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The number of vertices.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns the graph ID of a dense index.
+     *
+     * Time complexity: O(1)
+     *
+     * @param index The dense index.
+     * @return The vertex ID.
+     */
+    int getId(int index) const;
+
+    /**
+     * @brief Returns the dense index of a graph ID.
+     *
+     * Time complexity: O(1)
+     *
+     * @param id The vertex ID.
+     * @return The dense index, or -1 if the vertex is not part of the instance.
+     */
+    int getIndex(int id) const;
+
+    /**
+     * @brief Returns the distance between two vertices.
+     *
+     * Time complexity: O(1)
+     *
+     * @param i Dense index of the first vertex.
+     * @param j Dense index of the second vertex.
+     * @return The distance between the two vertices.
+     */
+    double dist(int i, int j) const
+    {
+        if (!matrix.empty())
+            return matrix[(size_t)i * n + j];
+        return computeDist(i, j);
+    }
+
+    /**
+     * @brief Checks whether the instance stores a dense distance matrix.
+     *
+     * Time complexity: O(1)
+     *
+     * @return True if dist() is a matrix lookup.
+     */
+    bool isDense() const;
+
+    /**
+     * @brief Returns how distances are computed from the coordinates.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The metric of the graph the instance comes from.
+     */
+    Metric getMetric() const;
+
+    /**
+     * @brief Checks whether the vertices have coordinates (the instance comes from a real-world or TSPLIB coordinate graph).
+     *
+     * Time complexity: O(1)
+     *
+     * @return True if getLatitude() and getLongitude() can be used.
+     */
+    bool hasCoordinates() const;
+
+    /**
+     * @brief Returns the latitude of a vertex.
+     *
+     * Time complexity: O(1)
+     *
+     * @param i Dense index of the vertex.
+     * @return The latitude.
+     */
+    double getLatitude(int i) const;
+
+    /**
+     * @brief Returns the longitude of a vertex.
+     *
+     * Time complexity: O(1)
+     *
+     * @param i Dense index of the vertex.
+     * @return The longitude.
+     */
+    double getLongitude(int i) const;
+
+    /**
+     * @brief Returns the dense distance matrix, stored row by row (empty if the instance is not dense).
+     *
+     * Time complexity: O(1)
+     *
+     * @return The distance matrix.
+     */
+    const std::vector<double> &getMatrix() const;
+
+    /**
+     * @brief Calculates the cost of a closed tour.
+     *
+     * Time complexity: O(V)
+     *
+     * @param tour The tour, as a permutation of dense indexes (the return to the first vertex is implicit).
+     * @return The total distance of the tour.
+     */
+    double tourCost(const std::vector<int> &tour) const;
+
+    /**
+     * @brief Computes, for every vertex, its k nearest vertices sorted by increasing distance.
+     *
+     * Time complexity: O(V^2 * log(k))
+     *
+     * @param k The number of neighbours per vertex.
+     * @return The neighbour lists, stored as V consecutive blocks of min(k, V - 1) indexes.
+     */
+    std::vector<int> nearestNeighbours(int k) const;
+
+    /**
+     * @brief Converts a path of graph vertices into a tour of dense indexes.
+     *
+     * Time complexity: O(V)
+     *
+     * @param path The path, as returned by Graph::dfs.
+     * @return The tour.
+     */
+    std::vector<int> toTour(const std::vector<Vertex *> &path) const;
+
+    /**
+     * @brief Estimates the memory used by the instance (the distance matrix, for dense instances).
+     *
+     * Time complexity: O(1)
+     *
+     * @return The estimate, in bytes.
+     */
+    size_t memoryUsage() const;
+
+private:
+    int n = 0;
+    std::vector<int> ids;                                  /**< Dense index to vertex ID. */
+    std::unordered_map<int, int> indexOf;                  /**< Vertex ID to dense index. */
+    std::vector<double> matrix;                            /**< Dense distances, empty for large instances. */
+    Metric metric = Metric::None;                          /**< How distances are computed from the coordinates. */
+    std::vector<double> latitude;                          /**< Latitudes (first coordinates), used when there is no matrix. */
+    std::vector<double> longitude;                         /**< Longitudes (second coordinates), used when there is no matrix. */
+    std::unordered_map<long long, double> explicitWeights; /**< Edge weights, used when there is no matrix. */
+    std::shared_ptr<const ContractionHierarchy> oracle;    /**< Shortest path distances between vertices without an edge, used when there is no matrix. */
+
+    void fillFromOracle(const ContractionHierarchy &hierarchy);
+    double computeDist(int i, int j) const;
+};
+
+#endif // DAPROJECT2_TSPINSTANCE_H
@@ -0,0 +1,195 @@
+#include <charconv>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "TSPLib.h"
+
+/*
+ * Removes the spaces and the colon around a keyword value ("NAME : pr2392" leaves " : pr2392" after the keyword).
+ */
+static std::string trimValue(const std::string &value)
+{
+    size_t first = value.find_first_not_of(" \t\r:");
+    if (first == std::string::npos)
+        return "";
+    size_t last = value.find_last_not_of(" \t\r");
+    return value.substr(first, last - first + 1);
+}
+
+/*
+ * Reads the EDGE_WEIGHT_SECTION. Every format is read as rows of a matrix: the column-wise formats of one triangle
+ * list the same numbers as the row-wise formats of the other one.
+ */
+static bool readEdgeWeights(std::istream &file, Graph &graph, int n, const std::string &format)
+{
+    bool full = format == "FULL_MATRIX";
+    bool upper = format == "UPPER_ROW" || format == "LOWER_COL";
+    bool lower = format == "LOWER_ROW" || format == "UPPER_COL";
+    bool upperDiagonal = format == "UPPER_DIAG_ROW" || format == "LOWER_DIAG_COL";
+    bool lowerDiagonal = format == "LOWER_DIAG_ROW" || format == "UPPER_DIAG_COL";
+    if (!full && !upper && !lower && !upperDiagonal && !lowerDiagonal)
+        return false;
+
+    for (int i = 0; i < n; i++)
+    {
+        int first = full || lower || lowerDiagonal ? 0 : (upper ? i + 1 : i);
+        int last = full || upper || upperDiagonal ? n - 1 : (lower ? i - 1 : i);
+        for (int j = first; j <= last; j++)
+        {
+            double weight;
+            if (!(file >> weight))
+                return false;
+            if (i != j && (!full || i < j))
+                graph.addBidirectionalEdge(i, j, weight);
+        }
+    }
+    return true;
+}
+
+bool readTSPLib(const std::string &path, Graph &graph, std::string &error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    int n = -1;
+    std::string edgeWeightType, edgeWeightFormat = "FULL_MATRIX";
+    std::string token;
+    while (file >> token && token != "EOF")
+    {
+        if (token.size() > 8 && token.compare(token.size() - 8, 8, "_SECTION") == 0)
+        {
+            if (n <= 0)
+            {
+                error = token + " before DIMENSION";
+                return false;
+            }
+            if (token == "NODE_COORD_SECTION")
+            {
+                for (int i = 0; i < n; i++)
+                {
+                    int node;
+                    double x, y;
+                    if (!(file >> node >> x >> y) || node < 1 || node > n)
+                    {
+                        error = "invalid NODE_COORD_SECTION";
+                        return false;
+                    }
+                    graph.addVertex(node - 1);
+                    graph.findVertex(node - 1)->setLatitude(x);
+                    graph.findVertex(node - 1)->setLongitude(y);
+                }
+            }
+            else if (token == "EDGE_WEIGHT_SECTION")
+            {
+                for (int i = 0; i < n; i++)
+                    graph.addVertex(i);
+                if (!readEdgeWeights(file, graph, n, edgeWeightFormat))
+                {
+                    error = "invalid EDGE_WEIGHT_SECTION (format " + edgeWeightFormat + ")";
+                    return false;
+                }
+            }
+            else if (token == "DISPLAY_DATA_SECTION")
+            {
+                double value;
+                for (int i = 0; i < 3 * n; i++)
+                    file >> value;
+            }
+            else if (token == "FIXED_EDGES_SECTION")
+            {
+                int node;
+                while (file >> node && node != -1)
+                {
+                }
+            }
+            else
+            {
+                error = "unsupported " + token;
+                return false;
+            }
+            continue;
+        }
+
+        // "KEYWORD : value", "KEYWORD: value" or "KEYWORD:value"
+        std::string rest;
+        size_t colon = token.find(':');
+        if (colon != std::string::npos)
+        {
+            rest = token.substr(colon + 1);
+            token.erase(colon);
+        }
+        std::string line;
+        std::getline(file, line);
+        std::string value = trimValue(rest + " " + line);
+
+        if (token == "DIMENSION")
+        {
+            const char *last = value.data() + value.size();
+            auto [end, status] = std::from_chars(value.data(), last, n);
+            if (status != std::errc() || end != last || n <= 0)
+            {
+                error = "invalid DIMENSION";
+                return false;
+            }
+        }
+        else if (token == "TYPE" && value.compare(0, 3, "TSP") != 0)
+        {
+            error = "only symmetric TSP instances are supported (TYPE " + value + ")";
+            return false;
+        }
+        else if (token == "EDGE_WEIGHT_TYPE")
+        {
+            edgeWeightType = value;
+            if (value == "EUC_2D")
+                graph.setMetric(Metric::Euclidean);
+            else if (value == "ATT")
+                graph.setMetric(Metric::Att);
+            else if (value == "GEO")
+                graph.setMetric(Metric::Geo);
+            else if (value == "EXPLICIT")
+                graph.setMetric(Metric::None);
+            else
+            {
+                error = "unsupported EDGE_WEIGHT_TYPE " + value;
+                return false;
+            }
+        }
+        else if (token == "EDGE_WEIGHT_FORMAT")
+            edgeWeightFormat = value;
+    }
+
+    if (n <= 0 || (int)graph.getNumVertex() != n)
+    {
+        error = "expected " + std::to_string(n) + " nodes, read " + std::to_string(graph.getNumVertex());
+        return false;
+    }
+    if (edgeWeightType.empty())
+    {
+        error = "missing EDGE_WEIGHT_TYPE";
+        return false;
+    }
+    return true;
+}
+
+bool writeTSPLibTour(const std::string &path, const std::string &name, const std::vector<int> &ids, double cost)
+{
+    std::ostringstream buffer;
+    buffer << std::setprecision(17);
+    buffer << "NAME : " << name << "\n";
+    buffer << "COMMENT : Length " << cost << "\n";
+    buffer << "TYPE : TOUR\n";
+    buffer << "DIMENSION : " << ids.size() << "\n";
+    buffer << "TOUR_SECTION\n";
+    for (int id : ids)
+        buffer << id + 1 << "\n";
+    buffer << "-1\nEOF\n";
+
+    std::ofstream file(path, std::ios::binary);
+    std::string contents = buffer.str();
+    file.write(contents.data(), (std::streamsize)contents.size());
+    return (bool)file;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file TSPLib.h
+ * @brief This file contains the reader of TSPLIB instances (.tsp) and the writer of TSPLIB tours (.tour).
+ */
+
+#ifndef DAPROJECT2_TSPLIB_H
+#define DAPROJECT2_TSPLIB_H
+
+#include <string>
+#include <vector>
+#include "Graph.h"
+
+/**
+ * @brief Reads a symmetric TSPLIB instance into an empty graph.
+ *
+ * The file is read as a stream of tokens, so the coordinates or weights are never held twice in memory.
+ * The TSPLIB node i becomes the vertex with ID i - 1, so the first node is vertex 0 (the start of the tours).
+ * Supported edge weight types:
+ * - EUC_2D, ATT and GEO: the coordinates are stored in the vertices and the graph gets the matching Metric;
+ *   no edges are added, distances are computed on demand (see Graph::getDistance and TSPInstance).
+ * - EXPLICIT: the weights become bidirectional edges. Formats FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW and
+ *   LOWER_DIAG_ROW are supported, as well as their column-wise equivalents.
+ *
+ * Time complexity: O(V) for coordinate instances, O(V^2) for explicit ones
+ *
+ * @param path The path of the .tsp file.
+ * @param graph The graph that receives the instance (it must be empty).
+ * @param error Receives the reason when the file cannot be read.
+ * @return True if the instance was read.
+ */
+bool readTSPLib(const std::string &path, Graph &graph, std::string &error);
+
+/**
+ * @brief Writes a tour in the TSPLIB .tour format.
+ *
+ * The whole file is built in memory and written with a single call. Vertex IDs are written as TSPLIB nodes (ID + 1),
+ * the inverse of readTSPLib.
+ *
+ * Time complexity: O(V)
+ *
+ * @param path The path of the .tour file.
+ * @param name The NAME of the tour.
+ * @param ids The vertex IDs in tour order.
+ * @param cost The length of the tour, written as a comment.
+ * @return True if the file was written.
+ */
+bool writeTSPLibTour(const std::string &path, const std::string &name, const std::vector<int> &ids, double cost);
+
+#endif // DAPROJECT2_TSPLIB_H
@@ -0,0 +1,52 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "TourCache.h"
+
+TourCache::TourCache(const std::string &directory) : directory(directory) {}
+
+std::string TourCache::path(uint64_t fingerprint) const
+{
+    std::ostringstream name;
+    name << this->directory << std::hex << std::setw(16) << std::setfill('0') << fingerprint << ".tour";
+    return name.str();
+}
+
+bool TourCache::load(uint64_t fingerprint, std::vector<int> &ids, double &cost) const
+{
+    std::ifstream file(path(fingerprint));
+    size_t n;
+    if (!(file >> cost >> n))
+        return false;
+    ids.resize(n);
+    for (size_t i = 0; i < n; i++)
+        if (!(file >> ids[i]))
+            return false;
+    return true;
+}
+
+bool TourCache::store(uint64_t fingerprint, const std::vector<int> &ids, double cost) const
+{
+    std::vector<int> cachedIds;
+    double cachedCost;
+    if (load(fingerprint, cachedIds, cachedCost) && cachedCost <= cost + 1e-9)
+        return false;
+
+    std::error_code error;
+    std::filesystem::create_directories(this->directory, error);
+    std::string target = path(fingerprint), temporary = target + ".tmp";
+    {
+        std::ofstream file(temporary);
+        if (!file)
+            return false;
+        file << std::setprecision(17) << cost << "\n" << ids.size() << "\n";
+        for (int id : ids)
+            file << id << "\n";
+        if (!file)
+            return false;
+    }
+    std::filesystem::rename(temporary, target, error);
+    return !error;
+}
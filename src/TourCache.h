@@ -0,0 +1,61 @@
+/**
+ * @file TourCache.h
+ * @brief This file contains the on-disk cache of the best known tour of each graph.
+ */
+
+#ifndef DAPROJECT2_TOURCACHE_H
+#define DAPROJECT2_TOURCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class TourCache
+ * @brief Stores the best known tour of every graph in a directory, one file per graph fingerprint (see Graph::fingerprint).
+ *
+ * Each file holds the cost of the tour followed by the vertex IDs in tour order. A tour is only written when it is
+ * cheaper than the cached one, and it is written to a temporary file that is then renamed over the old one, so a
+ * reader never sees a partial file.
+ */
+class TourCache
+{
+public:
+    /**
+     * @brief Constructs a cache stored in a directory (created on the first store).
+     *
+     * @param directory The directory, ending with a separator.
+     */
+    explicit TourCache(const std::string &directory);
+
+    /**
+     * @brief Reads the cached tour of a graph.
+     *
+     * Time complexity: O(V)
+     *
+     * @param fingerprint The fingerprint of the graph.
+     * @param ids Receives the vertex IDs in tour order.
+     * @param cost Receives the cost of the tour.
+     * @return True if there is a cached tour for the graph.
+     */
+    bool load(uint64_t fingerprint, std::vector<int> &ids, double &cost) const;
+
+    /**
+     * @brief Caches a tour of a graph, if it is cheaper than the cached one.
+     *
+     * Time complexity: O(V)
+     *
+     * @param fingerprint The fingerprint of the graph.
+     * @param ids The vertex IDs in tour order.
+     * @param cost The cost of the tour.
+     * @return True if the tour was written.
+     */
+    bool store(uint64_t fingerprint, const std::vector<int> &ids, double cost) const;
+
+private:
+    std::string directory;
+
+    std::string path(uint64_t fingerprint) const;
+};
+
+#endif // DAPROJECT2_TOURCACHE_H
@@ -0,0 +1,82 @@
+#include "TwoOptKernel.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+void tourEdges(const TSPInstance &instance, const std::vector<int> &tour, std::vector<double> &edges)
+{
+    int n = (int)tour.size() - 1;
+    edges.resize(n);
+    for (int p = 0; p < n; p++)
+        edges[p] = instance.dist(tour[p], tour[p + 1]);
+}
+
+int bestTwoOptMove(const TSPInstance &instance, const std::vector<int> &tour, const std::vector<double> &edges,
+                   int i, int jBegin, int jEnd, double &bestDelta)
+{
+    int a = tour[i], b = tour[i + 1];
+    double dab = edges[i];
+    int bestJ = -1;
+    int j = jBegin;
+
+    if (instance.isDense())
+    {
+        int n = instance.size();
+        const double *rowA = instance.getMatrix().data() + (size_t)a * n;
+        const double *rowB = instance.getMatrix().data() + (size_t)b * n;
+#ifdef __AVX2__
+        if (jEnd - jBegin >= 4)
+        {
+            __m256d best = _mm256_set1_pd(bestDelta);
+            __m256d bestIndex = _mm256_set1_pd(-1);
+            __m256d index = _mm256_setr_pd(j, j + 1, j + 2, j + 3);
+            __m256d four = _mm256_set1_pd(4);
+            __m256d removed = _mm256_set1_pd(dab);
+            for (; j + 4 <= jEnd; j += 4)
+            {
+                __m128i c = _mm_loadu_si128((const __m128i *)(tour.data() + j));
+                __m128i d = _mm_loadu_si128((const __m128i *)(tour.data() + j + 1));
+                __m256d dac = _mm256_i32gather_pd(rowA, c, 8);
+                __m256d dbd = _mm256_i32gather_pd(rowB, d, 8);
+                __m256d dcd = _mm256_loadu_pd(edges.data() + j);
+                __m256d delta = _mm256_sub_pd(_mm256_add_pd(dac, dbd), _mm256_add_pd(dcd, removed));
+                __m256d lower = _mm256_cmp_pd(delta, best, _CMP_LT_OQ);
+                best = _mm256_blendv_pd(best, delta, lower);
+                bestIndex = _mm256_blendv_pd(bestIndex, index, lower);
+                index = _mm256_add_pd(index, four);
+            }
+            double lanes[4], lanesIndex[4];
+            _mm256_storeu_pd(lanes, best);
+            _mm256_storeu_pd(lanesIndex, bestIndex);
+            for (int l = 0; l < 4; l++)
+                if (lanesIndex[l] >= 0 && (lanes[l] < bestDelta || (lanes[l] == bestDelta && (int)lanesIndex[l] < bestJ)))
+                {
+                    bestDelta = lanes[l];
+                    bestJ = (int)lanesIndex[l];
+                }
+        }
+#endif
+        for (; j < jEnd; j++)
+        {
+            double delta = (rowA[tour[j]] + rowB[tour[j + 1]]) - (edges[j] + dab);
+            if (delta < bestDelta)
+            {
+                bestDelta = delta;
+                bestJ = j;
+            }
+        }
+        return bestJ;
+    }
+
+    for (; j < jEnd; j++)
+    {
+        double delta = (instance.dist(a, tour[j]) + instance.dist(b, tour[j + 1])) - (edges[j] + dab);
+        if (delta < bestDelta)
+        {
+            bestDelta = delta;
+            bestJ = j;
+        }
+    }
+    return bestJ;
+}
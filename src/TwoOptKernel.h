@@ -0,0 +1,47 @@
+/**
+ * @file TwoOptKernel.h
+ * @brief This file contains the blocked 2-opt delta evaluation shared by the 2-opt solvers.
+ */
+
+#ifndef DAPROJECT2_TWOOPTKERNEL_H
+#define DAPROJECT2_TWOOPTKERNEL_H
+
+#include <vector>
+#include "TSPInstance.h"
+
+/**
+ * @brief Fills the cached tour-edge array: edges[p] is the length of the edge from tour[p] to tour[p + 1].
+ *
+ * The tour array must have n + 1 entries, the last one repeating tour[0].
+ *
+ * Time complexity: O(V)
+ *
+ * @param instance The instance.
+ * @param tour The closed tour (n + 1 entries).
+ * @param edges The edge lengths, resized to n.
+ */
+void tourEdges(const TSPInstance &instance, const std::vector<int> &tour, std::vector<double> &edges);
+
+/**
+ * @brief Finds, for a fixed i, the 2-opt move (i, j) with the lowest delta among j in [jBegin, jEnd).
+ *
+ * The move (i, j) replaces the edges (tour[i], tour[i + 1]) and (tour[j], tour[j + 1]) with
+ * (tour[i], tour[j]) and (tour[i + 1], tour[j + 1]). The current edge lengths come from the cached array, so only the two
+ * new edges are looked up. On dense instances built with AVX2 four j are evaluated at a time, with gathers from the
+ * distance matrix and a vector min-reduction; otherwise the block is evaluated one j at a time.
+ *
+ * Time complexity: O(jEnd - jBegin)
+ *
+ * @param instance The instance.
+ * @param tour The closed tour (n + 1 entries, the last one repeating tour[0]).
+ * @param edges The cached edge lengths, as filled by tourEdges.
+ * @param i The first position of the move.
+ * @param jBegin The first j of the block (at least i + 2).
+ * @param jEnd One past the last j of the block (at most n).
+ * @param bestDelta Receives the lowest delta found, if it is lower than the value it holds on entry.
+ * @return The j of the lowest delta, or -1 if no j improved on bestDelta.
+ */
+int bestTwoOptMove(const TSPInstance &instance, const std::vector<int> &tour, const std::vector<double> &edges,
+                   int i, int jBegin, int jEnd, double &bestDelta);
+
+#endif // DAPROJECT2_TWOOPTKERNEL_H
@@ -41,32 +41,16 @@ void Vertex::removeOutgoingEdges() {
     }
 }
 
-bool Vertex::operator<(Vertex & vertex) const {
-    return this->dist < vertex.dist;
-}
-
 int Vertex::getId() const {
     return this->id;
 }
 
-std::unordered_map<int,Edge *> Vertex::getAdj() const {
+const std::unordered_map<int,Edge *> &Vertex::getAdj() const {
     return this->adj;
 }
 
-bool Vertex::isVisited() const {
-    return this->visited;
-}
-
-bool Vertex::isProcessing() const {
-    return this->processing;
-}
-
-unsigned int Vertex::getIndegree() const {
-    return this->indegree;
-}
-
-double Vertex::getDist() const {
-    return this->dist;
+int Vertex::getIndex() const {
+    return this->index;
 }
 
 double Vertex::getLatitude() const { 
@@ -77,10 +61,6 @@ double Vertex::getLongitude() const {
     return this->longitude;
 }
 
-Edge *Vertex::getPath() const {
-    return this->path;
-}
-
 double Vertex::getDistTo(Vertex *v)
 {
     if(findEdge(v) != nullptr) return findEdge(v)->weight;
@@ -91,18 +71,6 @@ void Vertex::setId(int id) {
     this->id = id;
 }
 
-void Vertex::setVisited(bool visited) {
-    this->visited = visited;
-}
-
-void Vertex::setProcessing(bool processing) {
-    this->processing = processing;
-}
-
-void Vertex::setIndegree(unsigned int indegree) {
-    this->indegree = indegree;
-}
-
 void Vertex::setLatitude(double latitude) {
     this->latitude = latitude;
 }
@@ -111,14 +79,6 @@ void Vertex::setLongitude(double longitude) {
     this->longitude = longitude;
 }
 
-void Vertex::setDist(double dist) {
-    this->dist = dist;
-}
-
-void Vertex::setPath(Edge *path) {
-    this->path = path;
-}
-
 void Vertex::deleteEdge(Edge *edge) {
     /*
     Vertex *dest = edge->getDest();
@@ -170,12 +130,17 @@ void Edge::setReverse(Edge *reverse) {
     this->reverse = reverse;
 }
 
+void Edge::setWeight(double weight) {
+    this->weight = weight;
+}
+
 void Edge::setFlow(double flow) {
     this->flow = flow;
 }
 
-Edge* Vertex::findEdge(Vertex* dest) const {
-    if(adj.find(dest->getId())!=adj.end()){
-        return getAdj()[dest->getId()];
+Edge* Vertex::findEdge(const Vertex* dest) const {
+    auto it = adj.find(dest->getId());
+    if(it!=adj.end()){
+        return it->second;
     }return nullptr;
 }
\ No newline at end of file
@@ -7,7 +7,6 @@
 #define VERTEXEDGE_H
 
 #include <unordered_map>
-#include "MutablePriorityQueue.h"
 
 class Edge;
 
@@ -22,13 +21,9 @@ class Vertex
 private:
     int id;
     std::unordered_map<int, Edge *> adj; // Outgoing edges
-    bool visited;
-    bool processing;
-    unsigned int indegree;
-    double dist;
-    double latitude;
-    double longitude;
-    Edge *path;
+    int index = 0;                       // Position in Graph::getVertices()
+    double latitude = 0;
+    double longitude = 0;
 
 public:
     /**
@@ -66,16 +61,6 @@ public:
      */
     void removeOutgoingEdges();
 
-    /**
-     * @brief Checks if this vertex is less than another vertex. Used for sorting purposes.
-     *
-     * Time complexity: O(1)
-     *
-     * @param vertex The vertex to compare with.
-     * @return True if this vertex is less than the other vertex, false otherwise.
-     */
-    bool operator<(Vertex &vertex) const;
-
     /**
      * @brief Returns the ID of this vertex.
      *
@@ -90,45 +75,19 @@ public:
      *
      * Time complexity: O(1)
      *
-     * @return The outgoing edges of this vertex.
+     * @return The outgoing edges of this vertex (a reference, valid until the edges of the vertex change).
      */
-    std::unordered_map<int, Edge *> getAdj() const;
+    const std::unordered_map<int, Edge *> &getAdj() const;
 
     /**
-     * @brief Checks if this vertex has been visited.
+     * @brief Returns the dense index of this vertex: its position in Graph::getVertices(), and the index of its entries
+     * in the arrays of a GraphScratch.
      *
      * Time complexity: O(1)
      *
-     * @return True if the vertex has been visited, false otherwise.
+     * @return The index of this vertex.
      */
-    bool isVisited() const;
-
-    /**
-     * @brief Checks if this vertex is being processed.
-     *
-     * Time complexity: O(1)
-     *
-     * @return True if the vertex is being processed, false otherwise.
-     */
-    bool isProcessing() const;
-
-    /**
-     * @brief Returns the indegree of this vertex.
-     *
-     * Time complexity: O(1)
-     *
-     * @return The indegree of this vertex.
-     */
-    unsigned int getIndegree() const;
-
-    /**
-     * @brief Returns the distance of this vertex.
-     *
-     * Time complexity: O(1)
-     *
-     * @return The distance of this vertex.
-     */
-    double getDist() const;
+    int getIndex() const;
 
     /**
      * @brief Returns the latitude of this vertex.
@@ -148,15 +107,6 @@ public:
      */
     double getLongitude() const;
 
-    /**
-     * @brief Returns the path (edge) to this vertex.
-     *
-     * Time complexity: O(1)
-     *
-     * @return The path (edge) to this vertex.
-     */
-    Edge *getPath() const;
-
     /**
      * @brief Returns the distance to a specific vertex.
      *
@@ -176,33 +126,6 @@ public:
      */
     void setId(int id);
 
-    /**
-     * @brief Sets the visited status of this vertex.
-     *
-     * Time complexity: O(1)
-     *
-     * @param visited The visited status to set.
-     */
-    void setVisited(bool visited);
-
-    /**
-     * @brief Sets the processing status of this vertex.
-     *
-     * Time complexity: O(1)
-     *
-     * @param processing The processing status to set.
-     */
-    void setProcessing(bool processing);
-
-    /**
-     * @brief Sets the indegree of this vertex.
-     *
-     * Time complexity: O(1)
-     *
-     * @param indegree The indegree to set.
-     */
-    void setIndegree(unsigned int indegree);
-
     /**
      * @brief Sets the latitude of this vertex.
      *
@@ -221,24 +144,6 @@ public:
      */
     void setLongitude(double longitude);
 
-    /**
-     * @brief Sets the distance of this vertex.
-     *
-     * Time complexity: O(1)
-     *
-     * @param dist The distance to set.
-     */
-    void setDist(double dist);
-
-    /**
-     * @brief Sets the path (edge) to this vertex.
-     *
-     * Time complexity: O(1)
-     *
-     * @param path The path (edge) to set.
-     */
-    void setPath(Edge *path);
-
     /**
      * @brief Find an edge connecting this vertex to the specified destination vertex.
      *
@@ -251,11 +156,9 @@ public:
      * @param dest A pointer to the destination vertex.
      * @return A pointer to the found edge, or nullptr if no edge is found.
      */
-    Edge *findEdge(Vertex *dest) const;
+    Edge *findEdge(const Vertex *dest) const;
 
-    friend class MutablePriorityQueue<Vertex>;
-protected:
-    int queueIndex = 0;         // required by MutablePriorityQueue and UFDS
+    friend class Graph;
 private:
     /**
      * @brief Deletes an edge from the memory.
@@ -281,9 +184,9 @@ private:
     Vertex *orig;
     Vertex *dest;
     double weight;
-    Edge *reverse;
-    bool selected;
-    double flow;
+    Edge *reverse = nullptr; // Set only for bidirectional edges
+    bool selected = false;
+    double flow = 0;
 
 public:
     /**
@@ -367,6 +270,15 @@ public:
      */
     void setReverse(Edge *reverse);
 
+    /**
+     * @brief Sets the weight of this edge (the reverse edge is not changed, see Graph::updateEdgeWeight).
+     *
+     * Time complexity: O(1)
+     *
+     * @param weight The new weight.
+     */
+    void setWeight(double weight);
+
     /**
      * @brief Sets the flow of this edge.
      *
@@ -0,0 +1,43 @@
+/**
+ * @file AntColonyTests.cpp
+ * @brief Checks of the MAX-MIN ant system on a complete sample graph.
+ */
+
+#include "../src/AntColony.h"
+#include "../src/Constructors.h"
+#include "TestUtils.h"
+
+int main()
+{
+    auto graph = loadGraph("datasets/extra-fully-connected-graphs/edges_100.csv");
+    TSPInstance instance = TSPInstance::fromGraph(*graph);
+    std::vector<int> initialTour = nearestNeighbourTour(instance, 0);
+    double initialCost = instance.tourCost(initialTour);
+
+    AntColonyParameters params;
+    params.ants = 10;
+    params.iterations = 15;
+
+    // every ant seeds its own generator from the iteration and its number, so the threads do not change the result
+    std::vector<int> tours[2];
+    for (int t = 0; t < 2; t++)
+    {
+        params.threads = t == 0 ? 1 : 3;
+        AntColony colony(instance, params);
+        SolverControl control;
+        tours[t] = colony.run(initialTour, control);
+        check(isTour(tours[t], instance.size()), "the colony did not return a tour");
+        check(colony.getIterations() == params.iterations, "ran " + std::to_string(colony.getIterations()) + " iterations");
+        check(instance.tourCost(tours[t]) <= initialCost + 1e-9, "the result is worse than the initial tour");
+        check(near(control.getBestCost(), instance.tourCost(tours[t])), "the reported best cost is not the cost of the result");
+    }
+    check(tours[0] == tours[1], "one and three threads built different tours");
+
+    // a cancelled control stops the colony before the first iteration
+    SolverControl cancelled;
+    cancelled.cancel();
+    AntColony stopped(instance, params);
+    check(stopped.run(initialTour, cancelled) == initialTour && stopped.getIterations() == 0,
+          "a cancelled colony did not return the initial tour");
+    return finish();
+}
@@ -0,0 +1,86 @@
+/**
+ * @file BoruvkaTests.cpp
+ * @brief Checks of the parallel Borůvka minimum spanning tree against Graph::prim.
+ */
+
+#include "TestUtils.h"
+
+/*
+ * Weight of the tree left in a scratch by Graph::prim or Graph::boruvka.
+ */
+static double treeWeight(const GraphScratch &scratch)
+{
+    double total = 0;
+    for (size_t i = 0; i < scratch.parent.size(); i++)
+        if (scratch.parent[i] != -1)
+            total += scratch.dist[i];
+    return total;
+}
+
+/*
+ * Checks that the scratch holds a spanning tree made of edges of the graph, rooted at vertex 0.
+ */
+static void checkTree(const Graph &graph, const GraphScratch &scratch, const std::string &name)
+{
+    const std::vector<Vertex *> &vertices = graph.getVertices();
+    int roots = 0, wrongEdges = 0;
+    for (int i = 0; i < graph.getNumVertex(); i++)
+    {
+        if (scratch.parent[i] == -1)
+        {
+            roots++;
+            continue;
+        }
+        Edge *e = vertices[scratch.parent[i]]->findEdge(vertices[i]);
+        if (e == nullptr || e->getWeight() != scratch.dist[i])
+            wrongEdges++;
+    }
+    check(roots == 1 && scratch.parent[graph.findVertex(0)->getIndex()] == -1, name + ": the tree is not rooted at vertex 0");
+    check(wrongEdges == 0, name + ": " + std::to_string(wrongEdges) + " tree edges are not edges of the graph");
+}
+
+/*
+ * Runs Borůvka with 1 and 3 threads and checks both trees against Prim's: equally light, and the same tree for any
+ * number of threads.
+ */
+static void checkAgainstPrim(const Graph &graph, const std::string &name)
+{
+    GraphScratch prim, single, boruvka;
+    graph.prim(prim);
+    graph.boruvka(1, single);
+    checkTree(graph, single, name + " with 1 thread");
+    check(near(treeWeight(single), treeWeight(prim)), name + ": Borůvka weighs " + std::to_string(treeWeight(single)) +
+          ", Prim " + std::to_string(treeWeight(prim)));
+    for (int threads : {3, 4})
+    {
+        graph.boruvka(threads, boruvka);
+        check(boruvka.parent == single.parent && boruvka.dist == single.dist,
+              name + ": " + std::to_string(threads) + " threads built another tree than 1 thread");
+    }
+}
+
+int main()
+{
+    std::vector<std::pair<std::string, int>> graphs = {
+        {"datasets/toy-graphs/shipping.csv", 0}, {"datasets/toy-graphs/stadiums.csv", 0},
+        {"datasets/toy-graphs/tourism.csv", 0}, {"datasets/extra-fully-connected-graphs/edges_300.csv", 0},
+        {"datasets/extra-fully-connected-graphs/edges_700.csv", 8}};
+    for (auto &[path, nearest] : graphs)
+        checkAgainstPrim(*loadGraph(path, false, nearest), path);
+
+    // a grid where every edge weighs the same, so only the tie-breaking by IDs makes the tree unique
+    Graph grid;
+    int side = 40;
+    for (int id = 0; id < side * side; id++)
+        grid.addVertex(id);
+    for (int r = 0; r < side; r++)
+        for (int c = 0; c < side; c++)
+        {
+            if (c + 1 < side)
+                grid.addBidirectionalEdge(r * side + c, r * side + c + 1, 1);
+            if (r + 1 < side)
+                grid.addBidirectionalEdge(r * side + c, (r + 1) * side + c, 1);
+        }
+    checkAgainstPrim(grid, "grid of equal weights");
+    return finish();
+}
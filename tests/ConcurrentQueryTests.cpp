@@ -0,0 +1,78 @@
+/**
+ * @file ConcurrentQueryTests.cpp
+ * @brief Checks that several threads can run the tree queries on one shared graph, each with its own GraphScratch.
+ */
+
+#include <thread>
+#include "TestUtils.h"
+
+/*
+ * Result of one tree query: the tree and the preorder walk of it from vertex 0.
+ */
+struct QueryResult
+{
+    std::vector<int> parent;
+    std::vector<Vertex *> path;
+    double total = 0;
+
+    bool operator==(const QueryResult &other) const
+    {
+        return parent == other.parent && path == other.path && total == other.total;
+    }
+};
+
+/*
+ * Builds the tree (with prim, or boruvka on one thread) and walks it, keeping all the state in the scratch.
+ */
+static QueryResult query(const Graph &graph, bool boruvka, GraphScratch &scratch)
+{
+    QueryResult result;
+    if (boruvka)
+        graph.boruvka(1, scratch);
+    else
+        graph.prim(scratch);
+    result.parent = scratch.parent;
+    Vertex *lastVertex = nullptr;
+    result.total = graph.dfs(graph.findVertex(0), &lastVertex, result.path, scratch);
+    return result;
+}
+
+/*
+ * Runs the queries on 4 threads at once, each repeating them with one reused scratch, and checks every result against
+ * the one of a single query.
+ */
+static void checkConcurrentQueries(const Graph &graph, const std::string &name)
+{
+    GraphScratch scratch;
+    QueryResult primAlone = query(graph, false, scratch), boruvkaAlone = query(graph, true, scratch);
+
+    int threads = 4, repetitions = 20;
+    std::vector<int> wrong(threads, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back([&, t]()
+        {
+            GraphScratch own;
+            for (int r = 0; r < repetitions; r++)
+            {
+                bool boruvka = (t + r) % 2 == 1;
+                if (!(query(graph, boruvka, own) == (boruvka ? boruvkaAlone : primAlone)))
+                    wrong[t]++;
+            }
+        });
+    for (std::thread &worker : workers)
+        worker.join();
+    int total = 0;
+    for (int w : wrong)
+        total += w;
+    check(total == 0, name + ": " + std::to_string(total) + " concurrent queries differ from a single query");
+}
+
+int main()
+{
+    checkConcurrentQueries(*loadGraph("datasets/toy-graphs/tourism.csv"), "tourism");
+    checkConcurrentQueries(*loadGraph("datasets/extra-fully-connected-graphs/edges_300.csv"), "edges_300");
+    checkConcurrentQueries(*loadGraph("datasets/extra-fully-connected-graphs/edges_700.csv", false, 8), "edges_700 with 8 nearest");
+    checkConcurrentQueries(*loadGraph("datasets/real-world-graphs/graph1/", true), "graph1");
+    return finish();
+}
@@ -0,0 +1,143 @@
+/**
+ * @file ContractionHierarchyTests.cpp
+ * @brief Checks of the contraction hierarchy against the Dijkstra searches of the metric closure.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include "TestUtils.h"
+#include "../src/ContractionHierarchy.h"
+#include "../src/MetricClosure.h"
+
+/*
+ * Checks the distances, the one-to-many distances and the unpacked paths of the hierarchy of a graph against the
+ * closure over the given vertices, then the instance built with the hierarchy as the oracle of the graph.
+ */
+static void checkHierarchy(Graph &graph, const std::vector<int> &ids, const std::string &name)
+{
+    int n = (int)ids.size();
+    // without an oracle, the closure runs one Dijkstra search per vertex
+    MetricClosure dijkstra(graph, ids, 1);
+    auto hierarchy = std::make_shared<ContractionHierarchy>(graph);
+    check(hierarchy->getFingerprint() == graph.fingerprint(), name + ": the hierarchy has another fingerprint");
+
+    std::vector<double> table = hierarchy->table(ids, ids, 2);
+    int wrong = 0;
+    for (int i = 0; i < n; i++)
+    {
+        std::vector<double> row = hierarchy->distances(ids[i], ids);
+        for (int j = 0; j < n; j++)
+        {
+            double expected = dijkstra.dist(i, j);
+            wrong += !near(table[(size_t)i * n + j], expected) || !near(row[j], expected);
+            if ((i + j) % 7 == 0 && !near(hierarchy->distance(ids[i], ids[j]), expected))
+                wrong++;
+        }
+    }
+    check(wrong == 0, std::to_string(wrong) + " hierarchy distances of " + name + " differ from Dijkstra");
+    check(hierarchy->distance(ids[0], -12345) >= INF, name + ": a vertex outside the graph is reachable");
+
+    // the unpacked paths are made of edges of the graph and are as long as the distance
+    for (int i = 0; i < n; i += std::max(1, n / 10))
+    {
+        int j = n - 1 - i;
+        std::vector<int> walk = hierarchy->path(ids[i], ids[j]);
+        if (dijkstra.dist(i, j) >= INF || i == j)
+            continue;
+        double length = 0;
+        for (size_t a = 0; a + 1 < walk.size(); a++)
+        {
+            Vertex *from = graph.findVertex(walk[a]);
+            auto edge = from->getAdj().find(walk[a + 1]);
+            length += edge == from->getAdj().end() ? INF : edge->second->getWeight();
+        }
+        check(!walk.empty() && walk.front() == ids[i] && walk.back() == ids[j] && near(length, dijkstra.dist(i, j)),
+              "unpacked path " + std::to_string(ids[i]) + " -> " + std::to_string(ids[j]) + " of " + name +
+              " is not a shortest path");
+    }
+
+    // the solvers' instance takes the pairs without an edge from the oracle (graphs read with --nearest keep the
+    // whole distance table instead)
+    if (graph.hasDistanceTable() || n != graph.getNumVertex())
+        return;
+    graph.setDistanceOracle(hierarchy);
+    TSPInstance instance = TSPInstance::fromGraph(graph);
+    wrong = 0;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            if (!graph.findVertex(ids[i])->getAdj().count(ids[j]) &&
+                !near(instance.dist(instance.getIndex(ids[i]), instance.getIndex(ids[j])), dijkstra.dist(i, j)))
+                wrong++;
+    check(wrong == 0, std::to_string(wrong) + " instance distances of " + name + " do not come from the oracle");
+}
+
+/*
+ * A square grid of side vertices with random integer weights and a few one-way streets, like a small road network.
+ */
+static std::unique_ptr<Graph> grid(int side, unsigned seed)
+{
+    auto graph = std::make_unique<Graph>();
+    std::mt19937 random(seed);
+    for (int id = 0; id < side * side; id++)
+        graph->addVertex(id);
+    auto connect = [&](int a, int b)
+    {
+        if (random() % 10 == 0)
+            graph->addEdge(a, b, 1 + random() % 100);
+        else
+            graph->addBidirectionalEdge(a, b, 1 + random() % 100);
+    };
+    for (int r = 0; r < side; r++)
+        for (int c = 0; c < side; c++)
+        {
+            if (c + 1 < side)
+                connect(r * side + c, r * side + c + 1);
+            if (r + 1 < side)
+                connect(r * side + c, (r + 1) * side + c);
+        }
+    return graph;
+}
+
+/*
+ * An index read back from its file answers the same; a file that is not an index is rejected.
+ */
+static void checkSaveAndLoad()
+{
+    auto graph = loadGraph("datasets/toy-graphs/tourism.csv");
+    ContractionHierarchy built(*graph), read;
+    std::string file = (std::filesystem::temp_directory_path() / "daproject2-tests.ch").string(), error;
+    check(built.save(file, error) && read.load(file, error), "hierarchy file: " + error);
+    std::vector<int> ids = sortedIds(*graph);
+    check(built.table(ids, ids) == read.table(ids, ids), "the hierarchy read from its file answers differently");
+    check(read.getFingerprint() == built.getFingerprint(), "the hierarchy read from its file has another fingerprint");
+
+    std::ofstream(file) << "not a hierarchy";
+    ContractionHierarchy rejected;
+    error.clear();
+    check(!rejected.load(file, error) && !error.empty() && rejected.size() == 0, "a file that is not a hierarchy was read");
+    std::filesystem::remove(file);
+    check(!rejected.load(file, error), "a missing hierarchy file was read");
+}
+
+int main()
+{
+    std::vector<std::pair<std::string, int>> graphs = {
+        {"datasets/toy-graphs/shipping.csv", 0}, {"datasets/toy-graphs/stadiums.csv", 0},
+        {"datasets/toy-graphs/tourism.csv", 0}, {"datasets/extra-fully-connected-graphs/edges_100.csv", 0},
+        {"datasets/extra-fully-connected-graphs/edges_300.csv", 4}};
+    for (auto &[path, nearest] : graphs)
+    {
+        auto graph = loadGraph(path, false, nearest);
+        checkHierarchy(*graph, sortedIds(*graph), path);
+    }
+
+    auto road = grid(60, 1);
+    std::vector<int> ids = sortedIds(*road);
+    std::shuffle(ids.begin(), ids.end(), std::mt19937(2));
+    ids.resize(80);
+    checkHierarchy(*road, ids, "60 x 60 grid");
+
+    checkSaveAndLoad();
+    return finish();
+}
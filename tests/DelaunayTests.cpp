@@ -0,0 +1,147 @@
+/**
+ * @file DelaunayTests.cpp
+ * @brief Checks of the Delaunay triangulation and of the minimum spanning tree Graph::prim builds over it.
+ */
+
+#include <numeric>
+#include <random>
+#include <set>
+#include "TestUtils.h"
+#include "../src/Delaunay.h"
+
+/*
+ * Weight of the tree left in a scratch by Graph::prim.
+ */
+static double treeWeight(const GraphScratch &scratch)
+{
+    double total = 0;
+    for (size_t i = 0; i < scratch.parent.size(); i++)
+        if (scratch.parent[i] != -1)
+            total += scratch.dist[i];
+    return total;
+}
+
+/*
+ * Weight of the minimum spanning tree of an instance, with the array-scan Prim over every pair of vertices.
+ */
+static double densePrimWeight(const TSPInstance &instance)
+{
+    int n = instance.size();
+    std::vector<double> key(n, INF);
+    std::vector<char> inTree(n, 0);
+    key[0] = 0;
+    double total = 0;
+    for (int step = 0; step < n; step++)
+    {
+        int u = -1;
+        for (int v = 0; v < n; v++)
+            if (!inTree[v] && (u == -1 || key[v] < key[u]))
+                u = v;
+        inTree[u] = 1;
+        total += key[u];
+        for (int v = 0; v < n; v++)
+            if (!inTree[v])
+                key[v] = std::min(key[v], instance.dist(u, v));
+    }
+    return total;
+}
+
+/*
+ * Checks that the tree of the coordinate-only graphs, built over the Delaunay triangulation, weighs as much as the
+ * minimum spanning tree over every pair of vertices.
+ */
+static void delaunayTreeMatchesDensePrim()
+{
+    for (std::string path : {"datasets/real-world-graphs/graph1/", "datasets/real-world-graphs/graph2/"})
+    {
+        auto graph = loadGraph(path, true);
+        GraphScratch scratch;
+        graph->prim(scratch);
+        int roots = 0;
+        for (int p : scratch.parent)
+            roots += p == -1;
+        check(roots == 1, "the Delaunay tree of " + path + " does not span every vertex");
+        double dense = densePrimWeight(TSPInstance::fromGraph(*graph));
+        check(near(treeWeight(scratch), dense), "Delaunay tree of " + path + " weighs " +
+              std::to_string(treeWeight(scratch)) + ", dense Prim " + std::to_string(dense));
+    }
+}
+
+/*
+ * Checks the triangulation of random points: at most 3 * V - 6 edges, all of them connecting distinct points, every
+ * point reachable and, without equal points, every point joined to its nearest neighbour.
+ */
+static void checkTriangulation(int n, int duplicates, unsigned seed)
+{
+    std::string name = std::to_string(n) + " random points, " + std::to_string(duplicates) + " repeated";
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = coordinate(random);
+        y[i] = coordinate(random);
+    }
+    for (int i = 0; i < duplicates; i++)
+    {
+        int from = random() % (n - duplicates), to = n - duplicates + i;
+        x[to] = x[from];
+        y[to] = y[from];
+    }
+
+    std::vector<std::pair<int, int>> edges = delaunayEdges(x, y);
+    std::set<std::pair<int, int>> unique(edges.begin(), edges.end());
+    check(unique.size() == edges.size(), name + ": repeated edges");
+    check((int)edges.size() <= 3 * n - 6, name + ": " + std::to_string(edges.size()) + " edges, more than 3 * V - 6");
+    bool ordered = true;
+    for (auto &[a, b] : edges)
+        ordered = ordered && 0 <= a && a < b && b < n;
+    check(ordered, name + ": an edge is not a pair of distinct point indexes, smaller first");
+
+    std::vector<int> root(n);
+    std::iota(root.begin(), root.end(), 0);
+    auto find = [&root](int v)
+    {
+        while (root[v] != v)
+            v = root[v] = root[root[v]];
+        return v;
+    };
+    int components = n;
+    for (auto &[a, b] : edges)
+        if (find(a) != find(b))
+        {
+            root[find(a)] = find(b);
+            components--;
+        }
+    check(components == 1, name + ": the edges leave " + std::to_string(components) + " components");
+
+    if (duplicates > 0)
+        return;
+    // the nearest neighbour graph is a subgraph of the triangulation
+    int missing = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int nearest = -1;
+        double best = INF;
+        for (int j = 0; j < n; j++)
+        {
+            double d = std::hypot(x[i] - x[j], y[i] - y[j]);
+            if (j != i && d < best)
+            {
+                best = d;
+                nearest = j;
+            }
+        }
+        if (!unique.count({std::min(i, nearest), std::max(i, nearest)}))
+            missing++;
+    }
+    check(missing == 0, name + ": " + std::to_string(missing) + " points lack the edge to their nearest neighbour");
+}
+
+int main()
+{
+    delaunayTreeMatchesDensePrim();
+    checkTriangulation(2000, 0, 1);
+    checkTriangulation(500, 20, 2);
+    return finish();
+}
@@ -0,0 +1,99 @@
+/**
+ * @file DfsTests.cpp
+ * @brief Checks of the iterative preorder traversal of the spanning tree (Graph::dfs) against a recursive one.
+ */
+
+#include "TestUtils.h"
+
+/*
+ * Number of edges of a graph, counted over the adjacency lists.
+ */
+static size_t edgeCount(const Graph &graph)
+{
+    size_t count = 0;
+    for (Vertex *v : graph.getVertices())
+        count += v->getAdj().size();
+    return count;
+}
+
+/*
+ * Preorder of the tree in a scratch, recursively, visiting the children of every vertex by increasing ID.
+ */
+static void recursivePreorder(const Graph &graph, const GraphScratch &scratch, int v, std::vector<Vertex *> &path)
+{
+    const std::vector<Vertex *> &vertices = graph.getVertices();
+    path.push_back(vertices[v]);
+    std::vector<int> children;
+    for (int c = 0; c < graph.getNumVertex(); c++)
+        if (scratch.parent[c] == v)
+            children.push_back(c);
+    std::sort(children.begin(), children.end(), [&](int a, int b) { return vertices[a]->getId() < vertices[b]->getId(); });
+    for (int c : children)
+        recursivePreorder(graph, scratch, c, path);
+}
+
+/*
+ * Checks the preorder of the spanning tree of a graph from vertex 0: the recursive order, every vertex once, every
+ * parent before its children, and the distance of pathCost. The traversal must not add edges to the graph.
+ */
+static void checkPreorder(const Graph &graph, const std::string &name)
+{
+    GraphScratch scratch;
+    graph.prim(scratch);
+    size_t edges = edgeCount(graph);
+    std::vector<Vertex *> path;
+    Vertex *lastVertex = nullptr;
+    double total = graph.dfs(graph.findVertex(0), &lastVertex, path, scratch);
+
+    std::vector<Vertex *> expected;
+    recursivePreorder(graph, scratch, graph.findVertex(0)->getIndex(), expected);
+    check(path == expected, name + ": the preorder differs from the recursive one");
+    check((int)path.size() == graph.getNumVertex(), name + ": the preorder does not visit every vertex");
+    std::vector<int> position(graph.getNumVertex(), -1);
+    for (size_t i = 0; i < path.size(); i++)
+        position[path[i]->getIndex()] = (int)i;
+    bool parentsFirst = true;
+    for (int i = 0; i < graph.getNumVertex(); i++)
+        if (scratch.parent[i] != -1)
+            parentsFirst = parentsFirst && position[scratch.parent[i]] < position[i];
+    check(parentsFirst, name + ": a vertex comes before its parent");
+    check(lastVertex == path.back(), name + ": lastVertex is not the last vertex of the path");
+    check(near(total, graph.pathCost(path)), name + ": the distance " + std::to_string(total) + " differs from pathCost " +
+          std::to_string(graph.pathCost(path)));
+    check(edgeCount(graph) == edges, name + ": the traversal added edges to the graph");
+
+    // continuing from a given vertex adds the distance from it to the root (-1 without an edge between them)
+    std::vector<Vertex *> again;
+    Vertex *from = path.back();
+    double continued = graph.dfs(graph.findVertex(0), &from, again, scratch);
+    double back = graph.getDistance(path.back(), path.front());
+    check(near(continued, back < 0 ? -1 : total + back),
+          name + ": the distance from lastVertex was not added");
+}
+
+int main()
+{
+    for (std::string path : {"datasets/toy-graphs/shipping.csv", "datasets/toy-graphs/stadiums.csv",
+                             "datasets/toy-graphs/tourism.csv", "datasets/extra-fully-connected-graphs/edges_300.csv"})
+        checkPreorder(*loadGraph(path), path);
+    checkPreorder(*loadGraph("datasets/real-world-graphs/graph1/", true), "graph1");
+
+    // a path of 200000 vertices gives a tree as deep, which a recursive traversal could not walk
+    Graph chain;
+    int n = 200000;
+    for (int id = 0; id < n; id++)
+        chain.addVertex(id);
+    for (int id = 0; id + 1 < n; id++)
+        chain.addBidirectionalEdge(id, id + 1, 1);
+    GraphScratch scratch;
+    chain.prim(scratch);
+    std::vector<Vertex *> path;
+    Vertex *lastVertex = nullptr;
+    double total = chain.dfs(chain.findVertex(0), &lastVertex, path, scratch);
+    bool inOrder = (int)path.size() == n;
+    for (int i = 0; inOrder && i < n; i++)
+        inOrder = path[i]->getId() == i;
+    check(inOrder, "the path of 200000 vertices was not walked in order");
+    check(total == n - 1, "the path of 200000 vertices does not measure " + std::to_string(n - 1));
+    return finish();
+}
@@ -0,0 +1,166 @@
+/**
+ * @file DynamicTourTests.cpp
+ * @brief Checks of the resident tour under vertex insertions and removals and edge weight updates.
+ */
+
+#include <set>
+#include "../src/ContractionHierarchy.h"
+#include "../src/DynamicTour.h"
+#include "TestUtils.h"
+
+/*
+ * Cost of the path of a dynamic tour, summed again from the graph.
+ */
+static double pathCost(const Graph &graph, const std::vector<Vertex *> &path)
+{
+    double total = 0;
+    for (size_t i = 0; i < path.size(); i++)
+    {
+        double d = graph.getDistance(path[i], path[(i + 1) % path.size()]);
+        total += d < 0 ? INF : d;
+    }
+    return total;
+}
+
+/*
+ * Checks that the tour holds the expected vertices once each and that its cost is the cost of its path.
+ */
+static void checkTour(const Graph &graph, const DynamicTour &tour, const std::set<int> &expected, const std::string &when)
+{
+    std::set<int> ids;
+    for (Vertex *v : tour.getPath())
+        ids.insert(v->getId());
+    check(tour.size() == (int)expected.size() && ids == expected, when + ": the tour does not hold the expected vertices");
+    check(near(tour.getCost(), pathCost(graph, tour.getPath())), when + ": the cost " + std::to_string(tour.getCost()) +
+          " is not the cost of the path " + std::to_string(pathCost(graph, tour.getPath())));
+    for (int id : expected)
+        check(tour.contains(id), when + ": vertex " + std::to_string(id) + " is missing");
+}
+
+int main()
+{
+    auto graph = loadGraph("datasets/extra-fully-connected-graphs/edges_100.csv");
+
+    // a tour over the first 80 vertices, then the other 20 inserted one at a time (the first line of the file, the
+    // edge 0-1, is read as a header, so 0 and 1 are kept apart)
+    std::vector<Vertex *> path;
+    std::set<int> expected;
+    for (int id = 0; id < 80; id++)
+    {
+        path.push_back(graph->findVertex(id % 2 == 0 ? id / 2 : 40 + id / 2));
+        expected.insert(id);
+    }
+    DynamicTour tour(*graph, path);
+    checkTour(*graph, tour, expected, "initial tour");
+    double initialCost = tour.getCost();
+
+    for (int id = 80; id < 100; id++)
+    {
+        check(tour.insertVertex(graph->findVertex(id)), "vertex " + std::to_string(id) + " was not inserted");
+        expected.insert(id);
+        checkTour(*graph, tour, expected, "after inserting " + std::to_string(id));
+    }
+    check(!tour.insertVertex(graph->findVertex(80)) && !tour.insertVertex(nullptr), "a vertex was inserted twice");
+
+    // the windows are re-optimized, so removing the inserted vertices again gives a tour no worse than the initial one
+    for (int id = 99; id >= 80; id--)
+    {
+        check(tour.removeVertex(id), "vertex " + std::to_string(id) + " was not removed");
+        expected.erase(id);
+        checkTour(*graph, tour, expected, "after removing " + std::to_string(id));
+    }
+    check(!tour.removeVertex(99), "a vertex was removed twice");
+    check(tour.getCost() <= initialCost + 1e-6, "the round trip made the tour longer");
+
+    // edge weight updates: a tour edge made much longer and a pair far apart made very close
+    std::vector<Vertex *> current = tour.getPath();
+    int a = current[10]->getId(), b = current[11]->getId();
+    int c = current[20]->getId(), d = current[60]->getId();
+    double before = tour.getCost();
+    std::vector<EdgeWeightUpdate> updates = {{a, b, 1e7}, {c, d, 1}, {a, 123456, 5}};
+    check(tour.updateWeights(updates) == 2, "the update naming a missing vertex was not skipped");
+    check(graph->getDistance(graph->findVertex(b), graph->findVertex(a)) == 1e7, "the weight was not set both ways");
+    checkTour(*graph, tour, expected, "after updating weights");
+    check(tour.getCost() < before + 1e7, "the tour kept the edge made longer");
+    auto adjacent = [&tour](int x, int y)
+    {
+        const std::vector<Vertex *> &p = tour.getPath();
+        for (size_t i = 0; i < p.size(); i++)
+        {
+            int u = p[i]->getId(), v = p[(i + 1) % p.size()]->getId();
+            if ((u == x && v == y) || (u == y && v == x))
+                return true;
+        }
+        return false;
+    };
+    // the close pair becomes a tour edge unless neither 2-opt move that joins it improves the tour
+    auto joinGain = [&graph, &tour](int x, int y)
+    {
+        const std::vector<Vertex *> &p = tour.getPath();
+        int n = (int)p.size(), px = 0, py = 0;
+        for (int i = 0; i < n; i++)
+        {
+            px = p[i]->getId() == x ? i : px;
+            py = p[i]->getId() == y ? i : py;
+        }
+        int i = std::min(px, py), j = std::max(px, py);
+        auto dist = [&graph, &p, n](int u, int v) { return graph->getDistance(p[(u + n) % n], p[(v + n) % n]); };
+        double after = dist(i, j) + dist(i + 1, j + 1) - dist(i, i + 1) - dist(j, j + 1);
+        double before = dist(i, j) + dist(i - 1, j - 1) - dist(i - 1, i) - dist(j - 1, j);
+        return std::min(after, before);
+    };
+    check(adjacent(c, d) || joinGain(c, d) >= -1e-9, "the pair made close was not joined by an improving move");
+    check(!adjacent(a, b), "the edge made longer is still in the tour");
+
+    // the oracle has the shortest paths of the old weights: an update drops it before re-optimizing
+    Graph ring;
+    for (int id = 0; id < 30; id++)
+        ring.addVertex(id);
+    for (int id = 0; id < 30; id++)
+    {
+        ring.addBidirectionalEdge(id, (id + 1) % 30, 10);
+        ring.addBidirectionalEdge(id, (id + 5) % 30, 45);
+    }
+    ring.setDistanceOracle(std::make_shared<ContractionHierarchy>(ring));
+    std::vector<Vertex *> ringPath;
+    std::set<int> ringIds;
+    for (int id = 0; id < 30; id++)
+    {
+        ringPath.push_back(ring.findVertex(id));
+        ringIds.insert(id);
+    }
+    DynamicTour ringTour(ring, ringPath);
+    std::vector<EdgeWeightUpdate> ringUpdates = {{0, 1, 1}, {2, 3, 500}};
+    check(ringTour.updateWeights(ringUpdates) == 2, "the ring updates were not applied");
+    check(ring.getDistanceOracle() == nullptr, "the stale oracle is still attached after the update");
+    checkTour(ring, ringTour, ringIds, "after updating the ring");
+    check(ringTour.getCost() < 300 - 9 + 490, "the ring tour kept the edge made longer");
+
+    // an edge added one way only has no reverse edge to update
+    Graph directed;
+    directed.addVertex(1);
+    directed.addVertex(2);
+    directed.addEdge(1, 2, 10);
+    check(directed.updateEdgeWeight(1, 2, 4) && directed.findVertex(1)->findEdge(directed.findVertex(2))->getWeight() == 4,
+          "the weight of a one-way edge was not updated");
+    check(directed.findVertex(2)->findEdge(directed.findVertex(1)) == nullptr, "updating a one-way edge added its reverse");
+
+    // a vertex new to a real-world graph is priced by its coordinates
+    auto real = loadGraph("datasets/real-world-graphs/graph1/", true);
+    std::vector<Vertex *> realPath;
+    std::set<int> realIds;
+    for (int id = 0; id < 200; id++)
+    {
+        realPath.push_back(real->findVertex(id));
+        realIds.insert(id);
+    }
+    DynamicTour realTour(*real, realPath);
+    Vertex *source = real->findVertex(500);
+    real->addVertex(100000);
+    real->findVertex(100000)->setLatitude(source->getLatitude() + 0.001);
+    real->findVertex(100000)->setLongitude(source->getLongitude());
+    check(realTour.insertVertex(real->findVertex(100000)), "the new vertex was not inserted");
+    realIds.insert(100000);
+    checkTour(*real, realTour, realIds, "after inserting a new real-world vertex");
+    return finish();
+}
@@ -0,0 +1,45 @@
+/**
+ * @file GeneticAlgorithmTests.cpp
+ * @brief Checks of the island-model genetic algorithm on a complete sample graph.
+ */
+
+#include "../src/Constructors.h"
+#include "../src/GeneticAlgorithm.h"
+#include "TestUtils.h"
+
+int main()
+{
+    auto graph = loadGraph("datasets/extra-fully-connected-graphs/edges_100.csv");
+    TSPInstance instance = TSPInstance::fromGraph(*graph);
+    std::vector<int> seedTour = mstPreorderTour(instance, 0);
+    double seedCost = instance.tourCost(seedTour);
+
+    GeneticParameters params;
+    params.islands = 3;
+    params.populationSize = 8;
+    params.generations = 20;
+    params.migrationInterval = 5;
+
+    // without a deadline the islands run every generation; the seed survives in island 0, so the result is no worse
+    GeneticAlgorithm ga(instance, params);
+    SolverControl control;
+    std::vector<int> tour = ga.run(seedTour, control);
+    check(isTour(tour, instance.size()), "the genetic algorithm did not return a tour");
+    check(ga.getGenerations() == params.generations, "ran " + std::to_string(ga.getGenerations()) + " generations");
+    check(instance.tourCost(tour) <= seedCost + 1e-9, "the result is worse than the seed tour");
+    check(near(control.getBestCost(), instance.tourCost(tour)), "the reported best cost is not the cost of the result");
+
+    // every island has its own seeded generator and migrations happen at barriers, so a run is reproducible
+    GeneticAlgorithm again(instance, params);
+    SolverControl againControl;
+    check(again.run(seedTour, againControl) == tour, "two runs with the same seed gave different tours");
+
+    // a cancelled control stops the islands at the first generation boundary
+    SolverControl cancelled;
+    cancelled.cancel();
+    GeneticAlgorithm stopped(instance, params);
+    std::vector<int> early = stopped.run(seedTour, cancelled);
+    check(stopped.getGenerations() == 0, "a cancelled run ran " + std::to_string(stopped.getGenerations()) + " generations");
+    check(isTour(early, instance.size()) && instance.tourCost(early) <= seedCost + 1e-9, "a cancelled run lost the seed tour");
+    return finish();
+}
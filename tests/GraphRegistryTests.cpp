@@ -0,0 +1,134 @@
+/**
+ * @file GraphRegistryTests.cpp
+ * @brief Checks of the graph registry: reuse of the graphs read, least recently used eviction and concurrent reads.
+ */
+
+#include <thread>
+#include "TestUtils.h"
+#include "../src/GraphRegistry.h"
+
+static const std::string A = "extra-fully-connected-graphs/edges_25.csv";
+static const std::string B = "extra-fully-connected-graphs/edges_50.csv";
+static const std::string C = "extra-fully-connected-graphs/edges_75.csv";
+static const std::string D = "extra-fully-connected-graphs/edges_100.csv";
+
+/*
+ * Paths of the graphs in the registry, from the most to the least recently used.
+ */
+static std::vector<std::string> listed(const GraphRegistry &registry)
+{
+    std::vector<std::string> paths;
+    for (const RegistryEntry &entry : registry.list())
+        paths.push_back(entry.path);
+    return paths;
+}
+
+/*
+ * Memory charged for a graph in the registry (0 if it is not there).
+ */
+static size_t bytesOf(const GraphRegistry &registry, const std::string &path)
+{
+    for (const RegistryEntry &entry : registry.list())
+        if (entry.path == path)
+            return entry.bytes;
+    return 0;
+}
+
+/*
+ * Acquires a graph without its instance and returns whether its files were read.
+ */
+static bool acquireRead(GraphRegistry &registry, const std::string &path, std::shared_ptr<Graph> *graph = nullptr)
+{
+    std::string error;
+    bool read = false;
+    ResidentGraph resident = registry.acquire(path, false, false, error, &read);
+    check(resident.graph != nullptr, "could not acquire " + path + ": " + error);
+    if (graph != nullptr)
+        *graph = resident.graph;
+    return read;
+}
+
+/*
+ * Graphs read once and reused, listed by recency, and dropped least recently used first when the budget shrinks.
+ */
+static void checkEviction()
+{
+    GraphRegistry registry("datasets/");
+    std::shared_ptr<Graph> first, again, held;
+    check(acquireRead(registry, A, &first), "the first acquire of A did not read it");
+    check(acquireRead(registry, B, &held), "the first acquire of B did not read it");
+    check(acquireRead(registry, C), "the first acquire of C did not read it");
+    check(!acquireRead(registry, A, &again) && again == first, "acquiring A again read it again");
+    check(listed(registry) == std::vector<std::string>({A, C, B}), "the registry is not listed as A, C, B");
+    size_t total = bytesOf(registry, A) + bytesOf(registry, B) + bytesOf(registry, C);
+    check(total > 0 && registry.getMemoryUsage() == total, "the memory usage is not the sum of the graphs");
+
+    // B is the least recently used, so it goes first; a graph still held survives its eviction
+    registry.setBudget(bytesOf(registry, A) + bytesOf(registry, C));
+    check(listed(registry) == std::vector<std::string>({A, C}), "shrinking the budget did not drop only B");
+    check(held->getNumVertex() == 50, "the dropped graph B was deleted while held");
+    check(acquireRead(registry, B), "B was not read again after its eviction");
+    check(listed(registry) == std::vector<std::string>({B, A}), "acquiring B did not drop C, the least recently used");
+
+    // a graph larger than the budget is kept alone
+    registry.setBudget(1);
+    check(listed(registry) == std::vector<std::string>({B}), "a budget of one byte did not keep only the last graph");
+    check(acquireRead(registry, D) && listed(registry) == std::vector<std::string>({D}),
+          "acquiring D over the budget did not keep D alone");
+
+    // releasing drops a graph, and the number of nearest neighbours makes another graph
+    registry.setBudget(0);
+    acquireRead(registry, A);
+    registry.release(A, false);
+    check(acquireRead(registry, A), "A was not read again after its release");
+    std::string error;
+    bool read = false;
+    registry.acquire(A, false, false, error, &read, 5);
+    check(read && registry.list().size() == 3, "A with 5 nearest neighbours is not a graph of its own");
+
+    // the instance is charged once built
+    size_t before = registry.getMemoryUsage();
+    ResidentGraph resident = registry.acquire(D, false, true, error);
+    check(resident.instance != nullptr && resident.instance->size() == 100, "the instance of D was not built");
+    check(registry.getMemoryUsage() > before, "the instance of D was not charged");
+
+    ResidentGraph missing = registry.acquire("missing.csv", false, false, error);
+    check(missing.graph == nullptr && !error.empty(), "a missing graph was acquired");
+    check(registry.list().size() == 3, "a missing graph was listed");
+}
+
+/*
+ * Threads acquiring the same graph at once share one read of it.
+ */
+static void checkConcurrentAcquire()
+{
+    GraphRegistry registry("datasets/");
+    int threads = 4;
+    std::vector<char> reads(threads, 0);
+    std::vector<std::shared_ptr<Graph>> graphs(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back([&, t]()
+        {
+            std::string error;
+            bool read = false;
+            graphs[t] = registry.acquire("extra-fully-connected-graphs/edges_700.csv", false, true, error, &read).graph;
+            reads[t] = read;
+        });
+    for (std::thread &worker : workers)
+        worker.join();
+    int count = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        count += reads[t];
+        check(graphs[t] != nullptr && graphs[t] == graphs[0], "the threads got different graphs");
+    }
+    check(count == 1, std::to_string(count) + " threads read the same graph");
+}
+
+int main()
+{
+    checkEviction();
+    checkConcurrentAcquire();
+    return finish();
+}
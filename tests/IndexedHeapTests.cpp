@@ -0,0 +1,191 @@
+/**
+ * @file IndexedHeapTests.cpp
+ * @brief Checks of the indexed d-ary heap and the radix heap against the MutablePriorityQueue of the Dijkstra code.
+ */
+
+#include <random>
+#include "TestUtils.h"
+#include "../src/IndexedHeap.h"
+#include "../src/MutablePriorityQueue.h"
+
+/*
+ * Element of the MutablePriorityQueue used as the reference.
+ */
+struct Item
+{
+    int id = 0;
+    double key = 0;
+    int queueIndex = 0;
+
+    bool operator<(const Item &other) const
+    {
+        return key < other.key;
+    }
+};
+
+/*
+ * Runs the same random pushes, key decreases and pops on an IndexedHeap and on a MutablePriorityQueue and checks that
+ * they pop the same IDs. Keys are distinct, so the pop order is unique.
+ */
+template <int Arity>
+static void checkAgainstMutablePriorityQueue(int capacity, int operations, unsigned seed)
+{
+    std::string name = "arity " + std::to_string(Arity);
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> value(0, 1000000);
+    auto distinctKey = [&](int id)
+    { return (double)value(random) * capacity + id; };
+
+    IndexedHeap<Arity> heap;
+    heap.reset(capacity);
+    MutablePriorityQueue<Item> reference;
+    std::vector<Item> items(capacity);
+    int mismatches = 0, pops = 0;
+    for (int i = 0; i < capacity; i++)
+        items[i].id = i;
+
+    for (int op = 0; op < operations; op++)
+    {
+        int kind = random() % 3;
+        int id = random() % capacity;
+        if (kind == 0 && !heap.contains(id))
+        {
+            double key = distinctKey(id);
+            heap.push(id, key);
+            items[id].key = key;
+            reference.insert(&items[id]);
+        }
+        else if (kind == 1 && heap.contains(id))
+        {
+            double key = std::floor(heap.key(id) / capacity / 2) * capacity + id;
+            if (!(key < heap.key(id)))
+                continue;
+            heap.decreaseKey(id, key);
+            items[id].key = key;
+            reference.decreaseKey(&items[id]);
+        }
+        else if (!heap.empty())
+        {
+            int top = heap.top();
+            int popped = heap.pop();
+            if (popped != top || popped != reference.extractMin()->id)
+                mismatches++;
+            pops++;
+        }
+    }
+    while (!heap.empty())
+    {
+        if (heap.pop() != reference.extractMin()->id)
+            mismatches++;
+        pops++;
+    }
+    check(pops > capacity, name + ": too few pops to compare ");
+    check(mismatches == 0, name + ": " + std::to_string(mismatches) + " pops differ from MutablePriorityQueue");
+    check(reference.empty(), name + ": MutablePriorityQueue still holds IDs after the heap emptied");
+}
+
+/*
+ * Checks that equal keys pop by increasing ID and that pushOrDecrease only ever lowers keys.
+ */
+static void checkTiesAndPushOrDecrease()
+{
+    IndexedHeap<4> heap;
+    heap.reset(10);
+    for (int id : {7, 3, 9, 0, 5})
+        heap.push(id, 1.0);
+    check(heap.size() == 5, "the heap does not hold the 5 pushed IDs");
+    check(!heap.pushOrDecrease(3, 2.0), "pushOrDecrease raised a key");
+    check(heap.pushOrDecrease(9, 0.5), "pushOrDecrease did not lower a key");
+    check(heap.pushOrDecrease(2, 1.0), "pushOrDecrease did not push a new ID");
+    std::vector<int> order;
+    while (!heap.empty())
+        order.push_back(heap.pop());
+    check(order == std::vector<int>({9, 0, 2, 3, 5, 7}), "equal keys do not pop by increasing ID");
+
+    heap.push(4, 3.0);
+    heap.push(6, 2.0);
+    heap.clear();
+    check(heap.empty() && !heap.contains(4) && !heap.contains(6), "clear left IDs in the heap");
+}
+
+/*
+ * Dijkstra on a random graph with integer weights, through a given queue.
+ */
+template <class Queue, class Push, class Pop>
+static std::vector<uint64_t> dijkstra(const std::vector<std::vector<std::pair<int, uint64_t>>> &adj, Queue &queue,
+                                      Push push, Pop pop, std::vector<uint64_t> &popped)
+{
+    std::vector<uint64_t> dist(adj.size(), RadixHeap::NONE);
+    std::vector<char> done(adj.size(), 0);
+    dist[0] = 0;
+    push(queue, 0, 0);
+    while (!queue.empty())
+    {
+        auto [v, d] = pop(queue);
+        popped.push_back(d);
+        done[v] = 1;
+        for (auto &[w, weight] : adj[v])
+            if (!done[w] && d + weight < dist[w])
+            {
+                dist[w] = d + weight;
+                push(queue, w, dist[w]);
+            }
+    }
+    return dist;
+}
+
+/*
+ * Checks that Dijkstra through the radix heap pops keys in non-decreasing order and finds the same distances as
+ * through the indexed heap, with small weights (few buckets) and weights up to 2^40 (many buckets).
+ */
+static void checkRadixHeap(uint64_t maxWeight, unsigned seed)
+{
+    std::string name = "radix heap, weights up to " + std::to_string(maxWeight);
+    int n = 3000, m = 15000;
+    std::mt19937_64 random(seed);
+    std::vector<std::vector<std::pair<int, uint64_t>>> adj(n);
+    for (int v = 1; v < n; v++)
+        adj[random() % v].emplace_back(v, random() % (maxWeight + 1));
+    for (int i = 0; i < m; i++)
+        adj[random() % n].emplace_back(random() % n, random() % (maxWeight + 1));
+
+    RadixHeap radix(n);
+    std::vector<uint64_t> radixPopped;
+    std::vector<uint64_t> radixDist = dijkstra(
+        adj, radix, [](RadixHeap &q, int id, uint64_t key) { q.pushOrDecrease(id, key); },
+        [](RadixHeap &q)
+        {
+            int id = q.pop();
+            return std::make_pair(id, q.key(id));
+        },
+        radixPopped);
+
+    IndexedHeap<4, uint64_t> indexed;
+    indexed.reset(n);
+    std::vector<uint64_t> indexedPopped;
+    std::vector<uint64_t> indexedDist = dijkstra(
+        adj, indexed, [](IndexedHeap<4, uint64_t> &q, int id, uint64_t key) { q.pushOrDecrease(id, key); },
+        [](IndexedHeap<4, uint64_t> &q)
+        {
+            uint64_t key = q.key(q.top());
+            return std::make_pair(q.pop(), key);
+        },
+        indexedPopped);
+
+    check((int)radixPopped.size() == n, name + ": not every vertex was popped once");
+    check(std::is_sorted(radixPopped.begin(), radixPopped.end()), name + ": keys were not popped in order");
+    check(radixPopped == indexedPopped, name + ": the popped keys differ from the indexed heap");
+    check(radixDist == indexedDist, name + ": the distances differ from the indexed heap");
+    check(!radix.pushOrDecrease(0, 0), name + ": an ID already popped was pushed again");
+}
+
+int main()
+{
+    checkAgainstMutablePriorityQueue<2>(2000, 60000, 1);
+    checkAgainstMutablePriorityQueue<4>(2000, 60000, 2);
+    checkAgainstMutablePriorityQueue<8>(2000, 60000, 3);
+    checkTiesAndPushOrDecrease();
+    checkRadixHeap(1000, 4);
+    checkRadixHeap(uint64_t(1) << 40, 5);
+    return finish();
+}
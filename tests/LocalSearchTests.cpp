@@ -0,0 +1,92 @@
+/**
+ * @file LocalSearchTests.cpp
+ * @brief Checks of the neighbour-list 2-opt, its segment-local restart and its journal, and of the iterated local search.
+ */
+
+#include <numeric>
+#include <random>
+#include "../src/Constructors.h"
+#include "../src/LocalSearch.h"
+#include "TestUtils.h"
+
+/*
+ * Checks that no 2-opt move between a vertex and one of its neighbours improves the tour.
+ */
+static bool isLocalOptimum(const TSPInstance &instance, const std::vector<int> &tour, const std::vector<int> &neighbours, int k)
+{
+    int n = (int)tour.size();
+    std::vector<int> pos(n);
+    for (int p = 0; p < n; p++)
+        pos[tour[p]] = p;
+    for (int a = 0; a < n; a++)
+        for (int x = 0; x < k; x++)
+        {
+            int c = neighbours[(size_t)a * k + x];
+            int succA = tour[(pos[a] + 1) % n], succC = tour[(pos[c] + 1) % n];
+            int predA = tour[(pos[a] + n - 1) % n], predC = tour[(pos[c] + n - 1) % n];
+            double forward = instance.dist(a, c) + instance.dist(succA, succC) - instance.dist(a, succA) - instance.dist(c, succC);
+            double backward = instance.dist(a, c) + instance.dist(predA, predC) - instance.dist(a, predA) - instance.dist(c, predC);
+            if (c != succA && c != predA && std::min(forward, backward) < -1e-7)
+                return false;
+        }
+    return true;
+}
+
+int main()
+{
+    auto graph = loadGraph("datasets/extra-fully-connected-graphs/edges_100.csv");
+    TSPInstance instance = TSPInstance::fromGraph(*graph);
+    int n = instance.size(), k = 10;
+    std::vector<int> neighbours = instance.nearestNeighbours(k);
+
+    std::vector<int> tour(n);
+    std::iota(tour.begin(), tour.end(), 0);
+    double start = instance.tourCost(tour);
+    LocalSearchWorkspace workspace;
+    double gain = twoOptNeighbours(instance, tour, neighbours, k, workspace);
+    check(isTour(tour, n), "2-opt did not keep a tour");
+    check(gain <= 0 && near(instance.tourCost(tour) - start, gain), "2-opt misreports its gain");
+    check(isLocalOptimum(instance, tour, neighbours, k), "2-opt stopped before a local optimum");
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    for (int round = 0; round < 50; round++)
+    {
+        // a random reversal, then the 2-opt moves it allows, recorded in the journal
+        std::vector<int> before = tour;
+        int i = pick(rng), j = pick(rng);
+        reverseSegment(tour, workspace.pos, i, j);
+        std::vector<int> perturbed = tour;
+        double perturbedCost = instance.tourCost(tour);
+        std::vector<std::pair<int, int>> journal;
+        std::vector<int> seeds = {tour[i], tour[j], tour[(i + n - 1) % n], tour[(j + 1) % n]};
+        double delta = twoOptFrom(instance, tour, neighbours, k, seeds, workspace, &journal);
+        check(near(instance.tourCost(tour) - perturbedCost, delta), "the gain of twoOptFrom is not the change in cost");
+
+        for (auto it = journal.rbegin(); it != journal.rend(); it++)
+            reverseSegment(tour, workspace.pos, it->first, it->second);
+        check(tour == perturbed, "undoing the journal did not restore the tour");
+        reverseSegment(tour, workspace.pos, i, j);
+        check(tour == before, "undoing the reversal did not restore the tour");
+        bool positions = true;
+        for (int p = 0; p < n; p++)
+            positions = positions && workspace.pos[tour[p]] == p;
+        check(positions, "the positions do not match the tour after undoing");
+    }
+
+    std::vector<int> kicked = tour;
+    for (int round = 0; round < 20; round++)
+        doubleBridge(kicked, rng);
+    check(isTour(kicked, n), "the double bridge did not keep a tour");
+
+    std::vector<int> initial = mstPreorderTour(instance, 0);
+    std::vector<int> ils = initial;
+    SolverControl control(0.3);
+    long long kicks = 0;
+    double total = iteratedLocalSearch(instance, ils, neighbours, k, control, 42, &kicks);
+    check(isTour(ils, n), "iterated local search did not return a tour");
+    check(kicks > 0, "iterated local search tried no kicks");
+    check(near(instance.tourCost(ils) - instance.tourCost(initial), total), "iterated local search misreports its gain");
+    check(isLocalOptimum(instance, ils, neighbours, k), "iterated local search returned a tour that 2-opt improves");
+    return finish();
+}
@@ -0,0 +1,76 @@
+/**
+ * @file LowerBoundTests.cpp
+ * @brief Checks of the Held-Karp lower bound against optimal tours of small instances and tours of larger ones.
+ */
+
+#include <numeric>
+#include "../src/Constructors.h"
+#include "../src/LowerBound.h"
+#include "TestUtils.h"
+
+/*
+ * Length of the optimal tour of a small instance, by trying every order of the vertices after the first.
+ */
+static double optimalTour(const TSPInstance &instance)
+{
+    std::vector<int> tour(instance.size());
+    std::iota(tour.begin(), tour.end(), 0);
+    double best = INF;
+    do
+        best = std::min(best, instance.tourCost(tour));
+    while (std::next_permutation(tour.begin() + 1, tour.end()));
+    return best;
+}
+
+int main()
+{
+    auto graph = loadGraph("datasets/extra-fully-connected-graphs/edges_25.csv");
+    TSPInstance complete = TSPInstance::fromGraph(*graph);
+
+    // on subsets small enough to solve exactly, both bounds stay below the optimum and Held-Karp gets close to it
+    for (int first : {2, 8, 14})
+    {
+        std::vector<int> indexes(9);
+        std::iota(indexes.begin(), indexes.end(), first);
+        TSPInstance instance = complete.subset(indexes);
+        double optimum = optimalTour(instance);
+        HeldKarpBound bound(instance, LowerBoundParameters());
+        SolverControl control(5);
+        double lower = bound.run(control, optimum);
+        std::string name = "vertices " + std::to_string(first) + " to " + std::to_string(first + 8);
+        check(bound.isExact(), name + ": the bound of a dense instance is not exact");
+        check(lower <= optimum + 1e-6, name + ": Held-Karp " + std::to_string(lower) + " above the optimum " + std::to_string(optimum));
+        check(lower >= 0.9 * optimum, name + ": Held-Karp " + std::to_string(lower) + " far below the optimum " + std::to_string(optimum));
+        check(bound.trivialBound() <= optimum + 1e-6, name + ": the trivial bound is above the optimum");
+    }
+
+    // on a larger instance the bound stays below a good tour and converges without an iteration limit
+    auto larger = loadGraph("datasets/extra-fully-connected-graphs/edges_300.csv");
+    TSPInstance instance = TSPInstance::fromGraph(*larger);
+    int k = 10;
+    std::vector<int> neighbours = instance.nearestNeighbours(k);
+    std::vector<int> tour = mstPreorderTour(instance, 0);
+    SolverControl search(0.5);
+    iteratedLocalSearch(instance, tour, neighbours, k, search, 42);
+    double upper = instance.tourCost(tour);
+
+    HeldKarpBound bound(instance, LowerBoundParameters());
+    SolverControl control(20);
+    double lower = bound.run(control, upper);
+    check(lower <= upper + 1e-6, "Held-Karp " + std::to_string(lower) + " above the tour " + std::to_string(upper));
+    check(lower >= bound.trivialBound(), "Held-Karp " + std::to_string(lower) + " below the trivial bound");
+    check(!control.shouldStop(), "the subgradient optimization did not converge before its deadline");
+    check((int)bound.getPenalties().size() == instance.size(), "the penalties do not cover every vertex");
+
+    // a cancelled control stops at once, with the bound of the first 1-tree at most
+    HeldKarpBound stopped(instance, LowerBoundParameters());
+    SolverControl cancelled;
+    cancelled.cancel();
+    check(stopped.run(cancelled, upper) <= upper + 1e-6 && stopped.getIterations() <= 1, "a cancelled bound kept iterating");
+
+    // large coordinate instances use the candidate graph, whose bound is only an estimate
+    auto real = loadGraph("datasets/real-world-graphs/graph2/", true);
+    TSPInstance coordinates = TSPInstance::fromGraph(*real);
+    check(!HeldKarpBound(coordinates, LowerBoundParameters()).isExact(), "the candidate graph bound claims to be exact");
+    return finish();
+}
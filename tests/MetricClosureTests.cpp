@@ -0,0 +1,167 @@
+/**
+ * @file MetricClosureTests.cpp
+ * @brief Checks of the metric closure against a plain Dijkstra, and of the paths and walks it expands.
+ */
+
+#include <numeric>
+#include <queue>
+#include <random>
+#include "TestUtils.h"
+#include "../src/MetricClosure.h"
+
+/*
+ * Shortest path distances from one vertex (by dense index), with Dijkstra over a binary heap, until the targets are
+ * settled.
+ */
+static std::vector<double> dijkstra(const Graph &graph, int source, const std::vector<int> &targets)
+{
+    std::vector<double> dist(graph.getNumVertex(), INF);
+    std::vector<char> isTarget(graph.getNumVertex(), 0);
+    for (int target : targets)
+        isTarget[target] = 1;
+    int left = (int)targets.size();
+    std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, std::greater<>> queue;
+    dist[source] = 0;
+    queue.emplace(0, source);
+    while (!queue.empty())
+    {
+        auto [d, v] = queue.top();
+        queue.pop();
+        if (d > dist[v])
+            continue;
+        if (isTarget[v] && --left == 0)
+            break;
+        for (auto &e : graph.getVertices()[v]->getAdj())
+        {
+            int w = e.second->getDest()->getIndex();
+            if (d + e.second->getWeight() < dist[w])
+            {
+                dist[w] = d + e.second->getWeight();
+                queue.emplace(dist[w], w);
+            }
+        }
+    }
+    return dist;
+}
+
+/*
+ * Length of a walk of vertex IDs over the edges of the graph (INF if two consecutive vertices have no edge).
+ */
+static double walkLength(const Graph &graph, const std::vector<int> &walk)
+{
+    double length = 0;
+    for (size_t a = 0; a + 1 < walk.size(); a++)
+    {
+        Vertex *from = graph.findVertex(walk[a]);
+        auto edge = from->getAdj().find(walk[a + 1]);
+        if (edge == from->getAdj().end())
+            return INF;
+        length += edge->second->getWeight();
+    }
+    return length;
+}
+
+/*
+ * Checks the closure of a graph over some of its vertices: the distances of Dijkstra for 1 and 3 threads, the instance,
+ * and, for the first sampled terminals, a path along edges as long as the distance and the closed walk of a tour.
+ */
+static void checkClosure(const Graph &graph, const std::vector<int> &ids, const std::string &name, int sampled = 1000)
+{
+    int t = (int)ids.size();
+    std::vector<int> indexes;
+    for (int id : ids)
+        indexes.push_back(graph.findVertex(id)->getIndex());
+    MetricClosure closure(graph, ids, 1), parallel(graph, ids, 3);
+    TSPInstance instance = closure.toInstance();
+    check(closure.size() == t && instance.size() == t && instance.isDense(), name + ": wrong closure size");
+
+    int wrongDistances = 0, wrongPaths = 0;
+    for (int i = 0; i < t; i++)
+    {
+        std::vector<double> dist = dijkstra(graph, indexes[i], indexes);
+        for (int j = 0; j < t; j++)
+        {
+            double expected = dist[indexes[j]];
+            wrongDistances += !near(closure.dist(i, j), expected) || parallel.dist(i, j) != closure.dist(i, j) ||
+                              instance.dist(i, j) != closure.dist(i, j) || instance.getId(i) != ids[i];
+            if (i >= sampled || j != (i * 7 + 3) % t)
+                continue;
+            std::vector<int> path = closure.path(i, j);
+            if (expected >= INF)
+                wrongPaths += !path.empty();
+            else
+                wrongPaths += path.empty() || path.front() != ids[i] || path.back() != ids[j] ||
+                              !near(walkLength(graph, path), expected);
+        }
+    }
+    check(wrongDistances == 0, name + ": " + std::to_string(wrongDistances) + " closure distances differ from Dijkstra");
+    check(wrongPaths == 0, name + ": " + std::to_string(wrongPaths) + " paths are not shortest paths along the edges");
+
+    // a tour whose legs all have a path expands into a closed walk as long as the tour
+    std::vector<int> tour(std::min(t, sampled));
+    std::iota(tour.begin(), tour.end(), 0);
+    double cost = instance.tourCost(tour);
+    std::vector<int> walk = closure.expandTour(tour);
+    if (cost >= INF)
+        check(walk.empty(), name + ": a tour with a leg without a path was expanded");
+    else
+        check(!walk.empty() && walk.front() == ids[0] && walk.back() == ids[0] && near(walkLength(graph, walk), cost),
+              name + ": the expanded walk is not a closed walk as long as the tour");
+}
+
+/*
+ * Some vertices of a graph, at random.
+ */
+static std::vector<int> randomIds(const Graph &graph, int count, unsigned seed)
+{
+    std::vector<int> ids = sortedIds(graph);
+    std::shuffle(ids.begin(), ids.end(), std::mt19937(seed));
+    ids.resize(std::min(count, (int)ids.size()));
+    return ids;
+}
+
+/*
+ * A square grid of side vertices with random integer weights, like a small road network.
+ */
+static std::unique_ptr<Graph> grid(int side, unsigned seed)
+{
+    auto graph = std::make_unique<Graph>();
+    std::mt19937 random(seed);
+    for (int id = 0; id < side * side; id++)
+        graph->addVertex(id);
+    for (int r = 0; r < side; r++)
+        for (int c = 0; c < side; c++)
+        {
+            if (c + 1 < side)
+                graph->addBidirectionalEdge(r * side + c, r * side + c + 1, 1 + random() % 100);
+            if (r + 1 < side)
+                graph->addBidirectionalEdge(r * side + c, (r + 1) * side + c, 1 + random() % 100);
+        }
+    return graph;
+}
+
+int main()
+{
+    for (std::string path : {"datasets/toy-graphs/shipping.csv", "datasets/toy-graphs/stadiums.csv",
+                             "datasets/toy-graphs/tourism.csv"})
+    {
+        auto graph = loadGraph(path);
+        checkClosure(*graph, randomIds(*graph, 8, 1), path);
+    }
+    auto sparse = loadGraph("datasets/extra-fully-connected-graphs/edges_300.csv", false, 4);
+    checkClosure(*sparse, randomIds(*sparse, 40, 2), "edges_300 with 4 nearest");
+    auto small = grid(30, 3);
+    checkClosure(*small, randomIds(*small, 60, 4), "30 x 30 grid");
+
+    // too many terminals times vertices to store the predecessors, so the paths are searched again; the terminals are
+    // close together, so every search stops early
+    int side = 420;
+    auto large = grid(side, 5);
+    std::vector<int> corner;
+    for (int r = 0; r < 10; r++)
+        for (int c = 0; c < 10; c++)
+            corner.push_back(r * side + c);
+    check((long long)corner.size() * side * side > MetricClosure::PREDECESSOR_LIMIT, "the large grid stores its predecessors");
+    checkClosure(*large, corner, "420 x 420 grid", 20);
+    return finish();
+}
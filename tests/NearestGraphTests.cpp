@@ -0,0 +1,92 @@
+/**
+ * @file NearestGraphTests.cpp
+ * @brief Checks of complete graphs read keeping only the nearest neighbours of every vertex as edges.
+ */
+
+#include "TestUtils.h"
+
+/*
+ * Weight of the tree left in a scratch by Graph::prim.
+ */
+static double treeWeight(const GraphScratch &scratch)
+{
+    double total = 0;
+    for (size_t i = 0; i < scratch.parent.size(); i++)
+        if (scratch.parent[i] != -1)
+            total += scratch.dist[i];
+    return total;
+}
+
+/*
+ * Reads a complete graph whole and keeping k nearest neighbours, and checks the sparse one: every vertex keeps at least
+ * its k nearest neighbours, with their weights, far fewer edges, the same spanning tree weight, and every distance of
+ * the whole graph through the distance table and the instance.
+ */
+static void checkNearest(const std::string &path, int k)
+{
+    std::string name = path + " with " + std::to_string(k) + " nearest";
+    auto full = loadGraph(path), sparse = loadGraph(path, false, k);
+    check(sortedIds(*full) == sortedIds(*sparse), name + ": the vertices differ from the whole graph");
+    check(sparse->hasDistanceTable() && !full->hasDistanceTable(), name + ": only the sparse graph has a distance table");
+
+    size_t fullEdges = 0, sparseEdges = 0;
+    int fewNeighbours = 0, missingNearest = 0, wrongWeights = 0;
+    for (Vertex *v : full->getVertices())
+    {
+        Vertex *s = sparse->findVertex(v->getId());
+        fullEdges += v->getAdj().size();
+        sparseEdges += s->getAdj().size();
+        if ((int)s->getAdj().size() < std::min(k, (int)v->getAdj().size()))
+            fewNeighbours++;
+
+        // every neighbour strictly closer than the k-th nearest must be kept (ties may keep either)
+        std::vector<double> weights;
+        for (auto &e : v->getAdj())
+            weights.push_back(e.second->getWeight());
+        std::sort(weights.begin(), weights.end());
+        double kth = weights[std::min(k, (int)weights.size()) - 1];
+        for (auto &e : v->getAdj())
+            if (e.second->getWeight() < kth && !s->getAdj().count(e.first))
+                missingNearest++;
+        for (auto &e : s->getAdj())
+        {
+            auto original = v->getAdj().find(e.first);
+            if (original == v->getAdj().end() || original->second->getWeight() != e.second->getWeight())
+                wrongWeights++;
+        }
+    }
+    check(fewNeighbours == 0, name + ": " + std::to_string(fewNeighbours) + " vertices keep fewer than k neighbours");
+    check(missingNearest == 0, name + ": " + std::to_string(missingNearest) + " nearest neighbours were dropped");
+    check(wrongWeights == 0, name + ": " + std::to_string(wrongWeights) + " kept edges are not edges of the whole graph");
+    check(sparseEdges * 4 < fullEdges, name + ": kept " + std::to_string(sparseEdges) + " of " +
+          std::to_string(fullEdges) + " edges");
+
+    GraphScratch fullTree, sparseTree;
+    full->prim(fullTree);
+    sparse->prim(sparseTree);
+    check(near(treeWeight(sparseTree), treeWeight(fullTree)), name + ": the spanning tree weighs " +
+          std::to_string(treeWeight(sparseTree)) + ", the whole graph's " + std::to_string(treeWeight(fullTree)));
+
+    TSPInstance fullInstance = TSPInstance::fromGraph(*full), sparseInstance = TSPInstance::fromGraph(*sparse);
+    int wrongDistances = 0;
+    for (Vertex *v : full->getVertices())
+        for (auto &e : v->getAdj())
+        {
+            Vertex *a = sparse->findVertex(v->getId()), *b = sparse->findVertex(e.first);
+            int i = fullInstance.getIndex(v->getId()), j = fullInstance.getIndex(e.first);
+            wrongDistances += !near(sparse->getDistance(a, b), e.second->getWeight()) ||
+                              !near(sparseInstance.dist(sparseInstance.getIndex(v->getId()), sparseInstance.getIndex(e.first)),
+                                    fullInstance.dist(i, j));
+        }
+    check(wrongDistances == 0, name + ": " + std::to_string(wrongDistances) + " distances differ from the whole graph");
+}
+
+int main()
+{
+    for (int k : {4, 10})
+    {
+        checkNearest("datasets/extra-fully-connected-graphs/edges_300.csv", k);
+        checkNearest("datasets/extra-fully-connected-graphs/edges_700.csv", k);
+    }
+    return finish();
+}
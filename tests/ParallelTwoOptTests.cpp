@@ -0,0 +1,61 @@
+/**
+ * @file ParallelTwoOptTests.cpp
+ * @brief Checks of the parallel best-improvement 2-opt on a complete sample graph.
+ */
+
+#include "../src/Constructors.h"
+#include "../src/ParallelTwoOpt.h"
+#include "TestUtils.h"
+
+/*
+ * Checks that no 2-opt move of the whole tour improves it.
+ */
+static bool isTwoOptOptimal(const TSPInstance &instance, const std::vector<int> &tour)
+{
+    int n = (int)tour.size();
+    for (int i = 0; i + 2 < n; i++)
+        for (int j = i + 2; j < n; j++)
+        {
+            int a = tour[i], b = tour[i + 1], c = tour[j], d = tour[(j + 1) % n];
+            if (d == a)
+                continue;
+            if (instance.dist(a, c) + instance.dist(b, d) - instance.dist(a, b) - instance.dist(c, d) < -1e-7)
+                return false;
+        }
+    return true;
+}
+
+int main()
+{
+    auto graph = loadGraph("datasets/extra-fully-connected-graphs/edges_300.csv");
+    TSPInstance instance = TSPInstance::fromGraph(*graph);
+    std::vector<int> start = nearestNeighbourTour(instance, 0);
+    double startCost = instance.tourCost(start);
+
+    std::vector<int> tours[2];
+    for (int t = 0; t < 2; t++)
+    {
+        int threads = t == 0 ? 1 : 3;
+        tours[t] = start;
+        ParallelTwoOpt solver(instance, threads);
+        SolverControl control;
+        double delta = solver.run(tours[t], control);
+        std::string name = std::to_string(threads) + " threads";
+        check(isTour(tours[t], instance.size()), name + ": not a tour");
+        check(near(instance.tourCost(tours[t]) - startCost, delta), name + ": the gain is not the change in cost");
+        check(solver.getMoves() > 0 && solver.getRounds() > 0, name + ": no move was applied");
+        check(isTwoOptOptimal(instance, tours[t]), name + ": an improving 2-opt move is left");
+    }
+    // the rows are scanned in parallel, but the moves are chosen from all of them in a fixed order
+    check(tours[0] == tours[1], "one and three threads reached different tours");
+
+    // the control is checked after every round, so a cancelled run applies one round of moves
+    std::vector<int> tour = start;
+    SolverControl cancelled;
+    cancelled.cancel();
+    ParallelTwoOpt stopped(instance, 3);
+    double delta = stopped.run(tour, cancelled);
+    check(stopped.getRounds() == 1 && isTour(tour, instance.size()), "a cancelled run went on after its first round");
+    check(near(instance.tourCost(tour) - startCost, delta), "a cancelled run misreports its gain");
+    return finish();
+}
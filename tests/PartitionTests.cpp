@@ -0,0 +1,54 @@
+/**
+ * @file PartitionTests.cpp
+ * @brief Checks of the grid neighbour lists and of the divide-and-conquer solver on a real-world sample graph.
+ */
+
+#include "../src/Constructors.h"
+#include "../src/Partition.h"
+#include "TestUtils.h"
+
+int main()
+{
+    auto graph = loadGraph("datasets/real-world-graphs/graph2/", true);
+    TSPInstance instance = TSPInstance::fromGraph(*graph);
+    int n = instance.size(), k = 8;
+    check(!instance.isDense() && instance.hasCoordinates(), "graph2 is not a coordinate instance without a matrix");
+
+    // the grid lists are sorted, never hold the vertex itself and almost always agree with the exact lists
+    std::vector<int> grid = candidateNeighbours(instance, k);
+    std::vector<int> exact = instance.nearestNeighbours(k);
+    check(grid.size() == (size_t)n * k, "the grid lists have the wrong size");
+    int unsorted = 0, self = 0, missed = 0;
+    for (int v = 0; v < n; v++)
+        for (int x = 0; x < k; x++)
+        {
+            int u = grid[(size_t)v * k + x];
+            self += u == v;
+            if (x > 0 && instance.dist(v, u) < instance.dist(v, grid[(size_t)v * k + x - 1]))
+                unsorted++;
+            // ties may be listed in another order, so the distances are compared
+            if (instance.dist(v, u) > instance.dist(v, exact[(size_t)v * k + x]) + 1e-9)
+                missed++;
+        }
+    check(unsorted == 0 && self == 0, "the grid lists are not sorted neighbour lists");
+    check(missed <= n * k / 100, std::to_string(missed) + " grid neighbours are farther than the exact ones");
+
+    // bisection down to 500 vertices gives 16 clusters of graph2; the merged tour visits every vertex
+    PartitionParameters params;
+    params.clusterSize = 500;
+    params.threads = 3;
+    PartitionSolver solver(instance, params);
+    SolverControl control;
+    std::vector<int> tour = solver.run(control);
+    check(isTour(tour, n), "the partition solver did not return a tour");
+    check(solver.getClusters() == 16, "graph2 was split into " + std::to_string(solver.getClusters()) + " clusters");
+    double nearest = instance.tourCost(nearestNeighbourTour(instance, 0));
+    check(instance.tourCost(tour) < nearest, "the partition tour is longer than the nearest neighbour tour");
+
+    // a cancelled solver still merges every cluster
+    SolverControl cancelled;
+    cancelled.cancel();
+    PartitionSolver stopped(instance, params);
+    check(isTour(stopped.run(cancelled), n), "a cancelled partition solver did not return a tour");
+    return finish();
+}
@@ -0,0 +1,60 @@
+/**
+ * @file PortfolioTests.cpp
+ * @brief Checks of the multi-start portfolio solver on a complete sample graph.
+ */
+
+#include <set>
+#include "../src/Constructors.h"
+#include "../src/Portfolio.h"
+#include "TestUtils.h"
+
+int main()
+{
+    auto graph = loadGraph("datasets/extra-fully-connected-graphs/edges_100.csv");
+    TSPInstance instance = TSPInstance::fromGraph(*graph);
+    int n = instance.size();
+
+    PortfolioParameters params;
+    params.runs = 6;
+    params.threads = 3;
+    Portfolio portfolio(instance, params);
+    SolverControl control(0.6);
+    std::vector<int> tour = portfolio.run(control);
+
+    // every run finished with its own tour, and the published best is the cheapest of them
+    const std::vector<PortfolioRun> &runs = portfolio.getRuns();
+    check((int)runs.size() == params.runs, "the portfolio kept " + std::to_string(runs.size()) + " runs");
+    int cheapest = -1;
+    for (int r = 0; r < (int)runs.size(); r++)
+    {
+        check(isTour(runs[r].tour, n), "run " + std::to_string(r) + " did not build a tour");
+        check(near(runs[r].cost, instance.tourCost(runs[r].tour)), "run " + std::to_string(r) + " misreports its cost");
+        check(runs[r].seed == params.seed + r, "run " + std::to_string(r) + " has seed " + std::to_string(runs[r].seed));
+        check(runs[r].start >= 0 && runs[r].start < n, "run " + std::to_string(r) + " has no start vertex");
+        check(runs[r].restartedFrom < (int)runs.size() && runs[r].restartedFrom != r,
+              "run " + std::to_string(r) + " continued from run " + std::to_string(runs[r].restartedFrom));
+        if (cheapest == -1 || runs[r].cost < runs[cheapest].cost)
+            cheapest = r;
+    }
+    int best = portfolio.getBestRun();
+    check(best != -1 && near(runs[best].cost, runs[cheapest].cost), "the best run is not the cheapest one");
+    check(best != -1 && tour == runs[best].tour, "the portfolio did not return the tour of its best run");
+
+    // the greedy edge runs differ in more than their seed: the start vertex decides how the greedy paths are joined
+    std::vector<int> neighbours = instance.nearestNeighbours(params.neighbours);
+    std::set<std::vector<int>> greedyTours;
+    for (int start = 0; start < 10; start++)
+    {
+        std::vector<int> greedy = greedyEdgeTour(instance, neighbours, params.neighbours, start);
+        check(isTour(greedy, n), "the greedy edge tour from " + std::to_string(start) + " is not a tour");
+        greedyTours.insert(greedy);
+    }
+    check(greedyTours.size() > 1, "every start vertex built the same greedy edge tour");
+
+    // a cancelled portfolio starts no run and still returns a tour
+    SolverControl cancelled;
+    cancelled.cancel();
+    Portfolio stopped(instance, params);
+    check(isTour(stopped.run(cancelled), n) && stopped.getBestRun() == -1, "a cancelled portfolio started runs");
+    return finish();
+}
@@ -0,0 +1,81 @@
+/**
+ * @file PrimTests.cpp
+ * @brief Checks of the minimum spanning trees of Graph::prim, dense and sparse, against Kruskal's algorithm.
+ */
+
+#include <numeric>
+#include <tuple>
+#include "TestUtils.h"
+
+/*
+ * Weight of the minimum spanning forest of a graph, by Kruskal's algorithm over its edges.
+ */
+static double kruskalWeight(const Graph &graph)
+{
+    std::vector<std::tuple<double, int, int>> edges;
+    for (Vertex *v : graph.getVertices())
+        for (auto &e : v->getAdj())
+            if (v->getIndex() < e.second->getDest()->getIndex())
+                edges.emplace_back(e.second->getWeight(), v->getIndex(), e.second->getDest()->getIndex());
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<int> root(graph.getNumVertex());
+    std::iota(root.begin(), root.end(), 0);
+    auto find = [&root](int v)
+    {
+        while (root[v] != v)
+            v = root[v] = root[root[v]];
+        return v;
+    };
+    double total = 0;
+    for (auto &[w, a, b] : edges)
+        if (find(a) != find(b))
+        {
+            root[find(a)] = find(b);
+            total += w;
+        }
+    return total;
+}
+
+/*
+ * Checks that the scratch holds a spanning tree of the graph made of its edges, as light as Kruskal's.
+ */
+static void checkTree(const Graph &graph, const GraphScratch &scratch, const std::string &name)
+{
+    const std::vector<Vertex *> &vertices = graph.getVertices();
+    int n = graph.getNumVertex(), roots = 0, wrongEdges = 0;
+    double total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (scratch.parent[i] == -1)
+        {
+            roots++;
+            continue;
+        }
+        Edge *e = vertices[scratch.parent[i]]->findEdge(vertices[i]);
+        if (e == nullptr || e->getWeight() != scratch.dist[i])
+            wrongEdges++;
+        total += scratch.dist[i];
+    }
+    check(roots == 1 && scratch.parent[graph.findVertex(0)->getIndex()] == -1, name + ": the tree is not rooted at vertex 0");
+    check(wrongEdges == 0, name + ": " + std::to_string(wrongEdges) + " tree edges are not edges of the graph");
+    check(near(total, kruskalWeight(graph)), name + ": the tree weighs " + std::to_string(total) + ", Kruskal's " +
+          std::to_string(kruskalWeight(graph)));
+}
+
+int main()
+{
+    // the complete graphs take the array-scan Prim, the toy graphs the heap one; a reused scratch gives the same tree
+    for (std::string path : {"datasets/extra-fully-connected-graphs/edges_300.csv", "datasets/extra-fully-connected-graphs/edges_700.csv",
+                             "datasets/toy-graphs/shipping.csv", "datasets/toy-graphs/stadiums.csv", "datasets/toy-graphs/tourism.csv"})
+    {
+        auto graph = loadGraph(path);
+        GraphScratch scratch;
+        graph->prim(scratch);
+        checkTree(*graph, scratch, path);
+        std::vector<int> parent = scratch.parent;
+        graph->prim(scratch);
+        check(scratch.parent == parent, path + ": the reused scratch gave another tree");
+    }
+    return finish();
+}
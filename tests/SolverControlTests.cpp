@@ -0,0 +1,77 @@
+/**
+ * @file SolverControlTests.cpp
+ * @brief Checks of the deadlines, cancellation, targets and progress reports of the solvers.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <thread>
+#include "../src/Constructors.h"
+#include "../src/LocalSearch.h"
+#include "TestUtils.h"
+
+int main()
+{
+    // a deadline stops the control once it is reached, and a child never outlives its parent
+    SolverControl parent(0.2);
+    SolverControl child(10, &parent);
+    check(!parent.shouldStop() && !child.shouldStop(), "the controls stopped before their deadline");
+    check(child.remaining() <= 0.2, "the child has more time left than its parent");
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    check(parent.shouldStop() && child.shouldStop(), "the deadline did not stop the controls");
+
+    // cancelling a parent stops its children, not the other way round
+    SolverControl root;
+    SolverControl a(0, &root), b(0, &root);
+    a.cancel();
+    check(a.shouldStop() && !b.shouldStop() && !root.shouldStop(), "cancelling a child stopped another control");
+    root.cancel();
+    check(b.isCancelled() && b.shouldStop(), "cancelling the parent did not stop the children");
+
+    // reports keep the lowest cost, add up the moves and reach the parent; a target stops at the first cost below it
+    SolverControl totals;
+    SolverControl worker(0, &totals);
+    totals.setTarget(90);
+    worker.report(120, 5);
+    worker.report(150, 5);
+    check(worker.getBestCost() == 120 && totals.getBestCost() == 120, "the reports did not keep the lowest cost");
+    check(totals.snapshot().moves == 10, "the moves were not added up");
+    check(!totals.shouldStop(), "the target stopped the control too early");
+    worker.report(90);
+    check(totals.shouldStop() && worker.shouldStop(), "reaching the target did not stop the controls");
+
+    // the progress callback runs periodically until reporting stops
+    std::atomic<int> calls(0);
+    SolverControl reported;
+    reported.startReporting([&calls](const ProgressSnapshot &) { calls++; }, 0.02);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    reported.stopReporting();
+    int seen = calls;
+    check(seen > 0, "the progress callback never ran");
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    check(calls == seen, "the progress callback ran after reporting stopped");
+
+    // Ctrl+C cancels the guarded control
+    SolverControl guarded;
+    {
+        InterruptGuard guard(guarded);
+        std::raise(SIGINT);
+    }
+    check(guarded.isCancelled(), "SIGINT did not cancel the guarded control");
+
+    // an anytime solver stops at the deadline and reports the cost of the tour it returns
+    auto graph = loadGraph("datasets/extra-fully-connected-graphs/edges_100.csv");
+    TSPInstance instance = TSPInstance::fromGraph(*graph);
+    int k = 10;
+    std::vector<int> neighbours = instance.nearestNeighbours(k);
+    std::vector<int> tour = mstPreorderTour(instance, 0);
+    SolverControl deadline(0.3);
+    auto start = std::chrono::steady_clock::now();
+    iteratedLocalSearch(instance, tour, neighbours, k, deadline, 42);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    check(elapsed < 1, "iterated local search ran " + std::to_string(elapsed) + " s past a 0.3 s deadline");
+    check(near(deadline.getBestCost(), instance.tourCost(tour)), "iterated local search reported " +
+          std::to_string(deadline.getBestCost()) + " for a tour of " + std::to_string(instance.tourCost(tour)));
+    return finish();
+}
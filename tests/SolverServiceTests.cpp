@@ -0,0 +1,135 @@
+/**
+ * @file SolverServiceTests.cpp
+ * @brief Checks of the replies of the solver service to JSON line requests: solutions, errors, busy and deadlines.
+ */
+
+#include <map>
+#include <sstream>
+#include "TestUtils.h"
+#include "../src/SolverService.h"
+
+/*
+ * Serves the requests, one per line, and returns every response by the ID of its request (the raw JSON of the ID).
+ */
+static std::map<std::string, std::string> serve(SolverService &service, const std::string &requests)
+{
+    std::istringstream in(requests);
+    std::ostringstream out;
+    service.serveStream(in, out);
+    std::map<std::string, std::string> responses;
+    std::istringstream lines(out.str());
+    std::string line;
+    while (getline(lines, line))
+    {
+        size_t begin = line.find("\"id\":") + 5;
+        responses[line.substr(begin, line.find(',', begin) - begin)] = line;
+    }
+    return responses;
+}
+
+/*
+ * Checks that a response has a field containing a text.
+ */
+static void checkResponse(const std::map<std::string, std::string> &responses, const std::string &id,
+                          const std::string &text)
+{
+    auto it = responses.find(id);
+    check(it != responses.end() && it->second.find(text) != std::string::npos,
+          "response " + id + " lacks " + text + (it == responses.end() ? ", no response" : ": " + it->second));
+}
+
+/*
+ * Checks the solutions and the errors of single requests.
+ */
+static void checkReplies()
+{
+    SolverService service("datasets/", 1);
+    std::string graph = "\"graph\":\"extra-fully-connected-graphs/edges_25.csv\"";
+    auto responses = serve(service,
+        "{\"id\":1," + graph + ",\"algorithm\":\"triangular\"}\n"
+        "{\"id\":2," + graph + ",\"algorithm\":\"2opt\",\"vertices\":[3,5,7,9,11]}\n"
+        "{\"id\":3," + graph + ",\"op\":\"load\"}\n"
+        "{\"id\":4,\"op\":\"fly\"}\n"
+        "{\"id\":5}\n"
+        "{\"id\":6," + graph + ",\"deadline\":-1}\n"
+        "{\"id\":7," + graph + ",\"algorithm\":\"magic\"}\n"
+        "{\"id\":8," + graph + ",\"vertices\":[3,3]}\n"
+        "{\"id\":9,\"graph\":\"missing.csv\"}\n"
+        "{\"id\":10," + graph + ",\"algorithm\":\"ga\",\"threads\":1e9,\"deadline\":1}\n"
+        "{\"id\":11," + graph + ",\"algorithm\":\"aco\",\"threads\":1e300,\"deadline\":1}\n"
+        "{\"id\":\n");
+    check(responses.size() == 12, "12 requests got " + std::to_string(responses.size()) + " responses");
+
+    checkResponse(responses, "1", "\"cost\":");
+    auto it = responses.find("1");
+    if (it != responses.end())
+    {
+        std::string tour = it->second.substr(it->second.find("\"tour\":["));
+        tour = tour.substr(8, tour.find(']') - 8);
+        check(std::count(tour.begin(), tour.end(), ',') == 24, "the tour of the whole graph does not have 25 vertices");
+    }
+    checkResponse(responses, "2", "\"tour\":[");
+    checkResponse(responses, "3", "\"vertices\":25");
+    checkResponse(responses, "4", "\"error\":\"unknown op fly\"");
+    checkResponse(responses, "5", "\"error\":\"missing \\\"graph\\\"\"");
+    checkResponse(responses, "6", "\"error\":\"\\\"deadline\\\" must be positive\"");
+    checkResponse(responses, "7", "\"error\":\"unknown algorithm magic\"");
+    checkResponse(responses, "8", "\"error\":");
+    checkResponse(responses, "9", "\"error\":");
+    checkResponse(responses, "null", "\"error\":");
+    // the threads are limited to the cores instead of starting one island or ant thread per requested thread
+    checkResponse(responses, "10", "\"cost\":");
+    checkResponse(responses, "11", "\"cost\":");
+}
+
+/*
+ * A worker kept busy by a long request: the requests beyond QUEUE_LIMIT are answered "busy" at once, and the queued
+ * ones whose deadline passes while they wait are answered with an error instead of being solved.
+ */
+static void checkBusyAndDeadlines()
+{
+    SolverService service("datasets/", 1);
+    std::string error;
+    check(service.preload("extra-fully-connected-graphs/edges_700.csv", false, error), "could not preload edges_700");
+    check(service.preload("extra-fully-connected-graphs/edges_25.csv", false, error), "could not preload edges_25");
+
+    int waiting = 300;
+    std::string requests = "{\"id\":0,\"graph\":\"extra-fully-connected-graphs/edges_700.csv\",\"algorithm\":\"ils\",\"deadline\":0.5}\n";
+    for (int i = 1; i <= waiting; i++)
+        requests += "{\"id\":" + std::to_string(i) + ",\"graph\":\"extra-fully-connected-graphs/edges_25.csv\",\"deadline\":0.1}\n";
+    auto responses = serve(service, requests);
+
+    checkResponse(responses, "0", "\"cost\":");
+    auto it = responses.find("0");
+    if (it != responses.end())
+    {
+        size_t at = it->second.find("\"solve_microseconds\":");
+        long long solve = at == std::string::npos ? -1 : std::stoll(it->second.substr(at + 21));
+        check(solve >= 0 && solve < 1500000, "the long request did not stop at its deadline: " + it->second);
+    }
+
+    int busy = 0, late = 0, other = 0;
+    for (int i = 1; i <= waiting; i++)
+    {
+        const std::string &response = responses[std::to_string(i)];
+        if (response.find("\"error\":\"busy\"") != std::string::npos)
+            busy++;
+        else if (response.find("\"error\":\"the deadline passed before the request started\"") != std::string::npos)
+            late++;
+        else
+            other++;
+    }
+    // the long request may still be in the queue when it fills
+    int expected = waiting - (int)SolverService::QUEUE_LIMIT;
+    check(busy == expected || busy == expected + 1, std::to_string(busy) + " busy replies, expected " +
+          std::to_string(expected));
+    check(late == waiting - busy, std::to_string(late) + " deadline replies, expected " + std::to_string(waiting - busy));
+    check(other == 0, std::to_string(other) + " waiting requests got another reply");
+}
+
+int main()
+{
+    checkReplies();
+    checkBusyAndDeadlines();
+    return finish();
+}
@@ -0,0 +1,102 @@
+/**
+ * @file SubsetTests.cpp
+ * @brief Checks of the instances over a subset of the vertices of a graph and of the subset solver.
+ */
+
+#include <random>
+#include "TestUtils.h"
+#include "../src/SolverService.h"
+
+/*
+ * Checks that the sub-instance read from the graph has the IDs asked for and the distances of the whole instance.
+ */
+static void checkSubsetDistances(const Graph &graph, const std::string &name, int count, unsigned seed)
+{
+    TSPInstance whole = TSPInstance::fromGraph(graph);
+    std::vector<int> ids = sortedIds(graph);
+    std::shuffle(ids.begin(), ids.end(), std::mt19937(seed));
+    ids.resize(std::min(count, (int)ids.size()));
+    TSPInstance fromGraph = TSPInstance::fromGraph(graph, ids);
+    std::vector<int> indexes;
+    for (int id : ids)
+        indexes.push_back(whole.getIndex(id));
+    TSPInstance fromWhole = whole.subset(indexes);
+
+    int wrongIds = 0, wrongDistances = 0;
+    for (int i = 0; i < (int)ids.size(); i++)
+    {
+        wrongIds += fromGraph.getId(i) != ids[i] || fromGraph.getIndex(ids[i]) != i || fromWhole.getId(i) != ids[i];
+        for (int j = 0; j < (int)ids.size(); j++)
+            wrongDistances += !near(fromGraph.dist(i, j), whole.dist(indexes[i], indexes[j])) ||
+                              !near(fromWhole.dist(i, j), whole.dist(indexes[i], indexes[j]));
+    }
+    check(fromGraph.size() == (int)ids.size() && fromWhole.size() == (int)ids.size(), name + ": wrong subset size");
+    check(wrongIds == 0, name + ": " + std::to_string(wrongIds) + " vertices got the wrong ID or index");
+    check(wrongDistances == 0, name + ": " + std::to_string(wrongDistances) + " distances differ from the whole instance");
+    check(fromGraph.getIndex(-12345) == -1, name + ": a vertex outside the subset has an index");
+}
+
+/*
+ * A subset of a dense instance above DENSE_LIMIT keeps the distances of its parent.
+ */
+static void denseSubsets()
+{
+    int n = TSPInstance::DENSE_LIMIT + 20;
+    std::vector<int> ids(n);
+    std::vector<double> matrix((size_t)n * n);
+    for (int i = 0; i < n; i++)
+    {
+        ids[i] = i;
+        for (int j = 0; j < n; j++)
+            matrix[(size_t)i * n + j] = i == j ? 0 : i + j;
+    }
+    TSPInstance parent = TSPInstance::fromDistances(ids, std::move(matrix));
+    std::vector<int> indexes;
+    for (int i = 10; i < n; i++)
+        indexes.push_back(i);
+    TSPInstance subset = parent.subset(indexes);
+    check(subset.isDense() && subset.dist(0, 1) == 21 && subset.dist(5, (int)indexes.size() - 1) == 15 + n - 1,
+          "a subset of a dense instance lost the distances of its parent");
+}
+
+/*
+ * Solves tours over a subset of the vertices and checks them, and the errors for wrong IDs.
+ */
+static void checkSolveSubset()
+{
+    auto graph = loadGraph("datasets/real-world-graphs/graph2/", true);
+    std::vector<int> ids = sortedIds(*graph);
+    std::shuffle(ids.begin(), ids.end(), std::mt19937(3));
+    ids.resize(150);
+    for (std::string algorithm : {"triangular", "2opt", "ils"})
+    {
+        SolveOptions options;
+        options.algorithm = algorithm;
+        SolverControl control(0.3);
+        TSPInstance instance;
+        std::string error;
+        std::vector<int> tour = solveSubset(*graph, ids, options, control, instance, error);
+        check(isTour(tour, (int)ids.size()) && instance.size() == (int)ids.size(),
+              algorithm + " over a subset did not visit every vertex of it once: " + error);
+    }
+
+    for (std::vector<int> wrong : {std::vector<int>{ids[0], ids[1], ids[0]}, std::vector<int>{ids[0], -7}})
+    {
+        SolveOptions options;
+        SolverControl control;
+        TSPInstance instance;
+        std::string error;
+        check(solveSubset(*graph, wrong, options, control, instance, error).empty() && !error.empty(),
+              "a subset with repeated or unknown IDs was solved");
+    }
+}
+
+int main()
+{
+    checkSubsetDistances(*loadGraph("datasets/extra-fully-connected-graphs/edges_300.csv"), "edges_300", 60, 1);
+    checkSubsetDistances(*loadGraph("datasets/toy-graphs/tourism.csv"), "tourism", 4, 2);
+    checkSubsetDistances(*loadGraph("datasets/real-world-graphs/graph2/", true), "graph2", 300, 3);
+    denseSubsets();
+    checkSolveSubset();
+    return finish();
+}
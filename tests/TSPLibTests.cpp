@@ -0,0 +1,87 @@
+/**
+ * @file TSPLibTests.cpp
+ * @brief Checks of the TSPLIB reader and tour writer, with instances written to temporary files.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "../src/TSPLib.h"
+#include "TestUtils.h"
+
+int main()
+{
+    auto csv = loadGraph("datasets/extra-fully-connected-graphs/edges_25.csv");
+    TSPInstance expected = TSPInstance::fromGraph(*csv);
+    int n = expected.size();
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+
+    // the same matrix written in several of the explicit formats reads back as the same instance
+    for (std::string format : {"FULL_MATRIX", "UPPER_ROW", "LOWER_DIAG_ROW", "UPPER_DIAG_COL"})
+    {
+        std::string file = (directory / ("daproject2-tests-" + format + ".tsp")).string();
+        std::ofstream out(file);
+        out << std::setprecision(17) << "NAME : edges_25\nTYPE : TSP\nDIMENSION : " << n << "\nEDGE_WEIGHT_TYPE : EXPLICIT\n"
+            << "EDGE_WEIGHT_FORMAT : " << format << "\nEDGE_WEIGHT_SECTION\n";
+        bool upperDiagonal = format == "UPPER_DIAG_COL";
+        for (int i = 0; i < n; i++)
+        {
+            int first = format == "FULL_MATRIX" ? 0 : format == "UPPER_ROW" ? i + 1 : 0;
+            int last = format == "FULL_MATRIX" || format == "UPPER_ROW" ? n - 1 : i;
+            for (int j = first; j <= last; j++)
+                out << (upperDiagonal ? expected.dist(j, i) : expected.dist(i, j)) << (j == last ? "\n" : " ");
+        }
+        out << "EOF\n";
+        out.close();
+
+        Graph graph;
+        std::string error;
+        check(readTSPLib(file, graph, error), format + ": " + error);
+        TSPInstance instance = TSPInstance::fromGraph(graph);
+        bool same = instance.size() == n;
+        for (int i = 0; i < n && same; i++)
+            for (int j = 0; j < n && same; j++)
+                same = near(instance.dist(i, j), expected.dist(i, j));
+        check(same, "the " + format + " instance differs from edges_25.csv");
+        std::filesystem::remove(file);
+    }
+
+    // EUC_2D distances are rounded to the nearest integer; node i becomes vertex i - 1
+    std::string file = (directory / "daproject2-tests-euc.tsp").string();
+    std::ofstream(file) << "NAME: square\nDIMENSION: 4\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n"
+                           "1 0 0\n2 3 0\n3 3 4.4\n4 0 4.6\nEOF\n";
+    Graph graph;
+    std::string error;
+    check(readTSPLib(file, graph, error), "EUC_2D: " + error);
+    TSPInstance square = TSPInstance::fromGraph(graph);
+    check(square.size() == 4 && square.getId(0) == 0, "EUC_2D: wrong vertices");
+    check(square.dist(0, 1) == 3 && square.dist(1, 2) == 4 && square.dist(0, 2) == 5 && square.dist(0, 3) == 5,
+          "EUC_2D: distances are not rounded like TSPLIB");
+    std::filesystem::remove(file);
+
+    std::ofstream(file) << "DIMENSION: 3\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n1 0 0\n2 1 1\nEOF\n";
+    Graph truncated;
+    check(!readTSPLib(file, truncated, error), "a truncated NODE_COORD_SECTION was accepted");
+    std::filesystem::remove(file);
+
+    // a malformed or overflowing DIMENSION is reported, not thrown
+    for (std::string dimension : {"abc", "99999999999999999999", "-4", "12x"})
+    {
+        std::ofstream(file) << "NAME: bad\nDIMENSION : " << dimension << "\nEDGE_WEIGHT_TYPE: EUC_2D\nEOF\n";
+        Graph bad;
+        error.clear();
+        check(!readTSPLib(file, bad, error) && error == "invalid DIMENSION", "DIMENSION " + dimension + ": " + error);
+    }
+    std::filesystem::remove(file);
+
+    // tours are written with TSPLIB node numbers and end with -1
+    std::string tourFile = (directory / "daproject2-tests.tour").string();
+    check(writeTSPLibTour(tourFile, "square", {0, 1, 2, 3}, 17), "could not write the tour");
+    std::ifstream in(tourFile);
+    std::stringstream text;
+    text << in.rdbuf();
+    check(text.str().find("TOUR_SECTION\n1\n2\n3\n4\n-1\n") != std::string::npos, "wrong tour file:\n" + text.str());
+    std::filesystem::remove(tourFile);
+    return finish();
+}
@@ -0,0 +1,118 @@
+/**
+ * @file TestUtils.h
+ * @brief This file contains the checks and dataset helpers shared by the test programs.
+ *
+ * Every test program runs from the src/ directory, prints each failing check and returns the number of failed checks,
+ * so ctest reports any failure.
+ */
+
+#ifndef DAPROJECT2_TESTUTILS_H
+#define DAPROJECT2_TESTUTILS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/GraphReader.h"
+#include "../src/TSPInstance.h"
+
+inline int failures = 0; /**< Number of failed checks of the test program. */
+
+/**
+ * @brief Counts a failed check and prints what failed.
+ *
+ * @param condition The checked condition.
+ * @param what Description of the failure.
+ */
+inline void check(bool condition, const std::string &what)
+{
+    if (!condition)
+    {
+        failures++;
+        std::cerr << "FAILED: " << what << std::endl;
+    }
+}
+
+/**
+ * @brief Compares two distances with a relative tolerance, so sums taken in different orders compare equal.
+ *
+ * @param a The first distance.
+ * @param b The second distance.
+ * @return True if they are equal up to the tolerance.
+ */
+inline bool near(double a, double b)
+{
+    if (a >= INF || b >= INF)
+        return a >= INF && b >= INF;
+    return std::abs(a - b) <= 1e-6 * std::max(1.0, std::abs(b));
+}
+
+/**
+ * @brief Reads a sample dataset, ending the test program if it cannot be read.
+ *
+ * @param path The path of the dataset, relative to src/.
+ * @param real Whether it is a real-world graph (a directory with nodes.csv and, optionally, edges.csv).
+ * @param nearest If positive, complete graphs keep only this many nearest neighbours of each vertex as edges.
+ * @return The graph.
+ */
+inline std::unique_ptr<Graph> loadGraph(const std::string &path, bool real = false, int nearest = 0)
+{
+    auto graph = std::make_unique<Graph>();
+    std::string error;
+    if (!readGraphFile(path, real, *graph, error, nearest))
+    {
+        std::cerr << "Could not read " << path << ": " << error << std::endl;
+        std::exit(1);
+    }
+    return graph;
+}
+
+/**
+ * @brief Returns the IDs of the vertices of a graph, in increasing order.
+ *
+ * @param graph The graph.
+ * @return The IDs.
+ */
+inline std::vector<int> sortedIds(const Graph &graph)
+{
+    std::vector<int> ids;
+    for (Vertex *v : graph.getVertices())
+        ids.push_back(v->getId());
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+/**
+ * @brief Checks that a tour visits every vertex of an instance exactly once.
+ *
+ * @param tour The tour, in dense indexes.
+ * @param n The number of vertices of the instance.
+ * @return True if the tour is a permutation of 0 to n - 1.
+ */
+inline bool isTour(std::vector<int> tour, int n)
+{
+    if ((int)tour.size() != n)
+        return false;
+    std::sort(tour.begin(), tour.end());
+    for (int i = 0; i < n; i++)
+        if (tour[i] != i)
+            return false;
+    return true;
+}
+
+/**
+ * @brief Prints the outcome of the test program.
+ *
+ * @return The exit code: the number of failed checks.
+ */
+inline int finish()
+{
+    if (failures == 0)
+        std::cout << "All checks passed" << std::endl;
+    return failures;
+}
+
+#endif // DAPROJECT2_TESTUTILS_H
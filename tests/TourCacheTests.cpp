@@ -0,0 +1,42 @@
+/**
+ * @file TourCacheTests.cpp
+ * @brief Checks of the on-disk tour cache and of the graph fingerprints that key it.
+ */
+
+#include <filesystem>
+#include "../src/TourCache.h"
+#include "TestUtils.h"
+
+int main()
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "daproject2-tests-cache";
+    std::filesystem::remove_all(directory);
+    TourCache cache(directory.string() + "/");
+
+    std::vector<int> ids;
+    double cost = 0;
+    check(!cache.load(1, ids, cost), "an empty cache returned a tour");
+
+    // a tour is kept until a cheaper one is stored, and every fingerprint has its own entry
+    std::vector<int> first = {0, 3, 1, 2}, cheaper = {0, 1, 2, 3};
+    check(cache.store(1, first, 40.5), "the first tour was not stored");
+    check(cache.load(1, ids, cost) && ids == first && cost == 40.5, "the stored tour did not read back");
+    check(!cache.store(1, cheaper, 41), "a more expensive tour replaced the cached one");
+    check(cache.load(1, ids, cost) && ids == first, "the cached tour changed after a refused store");
+    check(cache.store(1, cheaper, 30.25), "a cheaper tour was not stored");
+    check(cache.load(1, ids, cost) && ids == cheaper && cost == 30.25, "the cheaper tour did not read back");
+    check(!cache.load(2, ids, cost), "another fingerprint shares the entry");
+    check(cache.store(2, first, 99) && cache.load(1, ids, cost) && cost == 30.25, "the entries are not separate");
+    std::filesystem::remove_all(directory);
+
+    // the fingerprint depends on the graph, not on the time it was read, and follows weight changes
+    auto a = loadGraph("datasets/toy-graphs/stadiums.csv");
+    auto b = loadGraph("datasets/toy-graphs/stadiums.csv");
+    auto other = loadGraph("datasets/toy-graphs/tourism.csv");
+    check(a->fingerprint() == b->fingerprint(), "the same graph read twice has two fingerprints");
+    check(a->fingerprint() != other->fingerprint(), "two graphs share a fingerprint");
+    uint64_t before = a->fingerprint();
+    a->updateEdgeWeight(0, 1, 12345);
+    check(a->fingerprint() != before, "changing a weight kept the fingerprint");
+    return finish();
+}
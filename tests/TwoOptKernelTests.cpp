@@ -0,0 +1,78 @@
+/**
+ * @file TwoOptKernelTests.cpp
+ * @brief Checks of the blocked 2-opt delta kernel against a plain loop over the same block (built with
+ * DAPROJECT2_AVX2, this checks the AVX2 version).
+ */
+
+#include <numeric>
+#include <random>
+#include "../src/TwoOptKernel.h"
+#include "TestUtils.h"
+
+/*
+ * Compares the kernel with the plain loop for random tours, rows and blocks of an instance.
+ */
+static void compare(const TSPInstance &instance, const std::string &name)
+{
+    int n = instance.size();
+    std::mt19937 rng(11);
+    std::vector<int> tour(n);
+    std::iota(tour.begin(), tour.end(), 0);
+    std::vector<double> edges;
+    int wrong = 0;
+    for (int round = 0; round < 5; round++)
+    {
+        std::shuffle(tour.begin(), tour.end(), rng);
+        std::vector<int> closed(tour);
+        closed.push_back(tour[0]);
+        tourEdges(instance, closed, edges);
+        for (int p = 0; p < n; p++)
+            if (edges[p] != instance.dist(closed[p], closed[p + 1]))
+                wrong++;
+
+        for (int sample = 0; sample < 200; sample++)
+        {
+            int i = std::uniform_int_distribution<int>(0, n - 3)(rng);
+            int jBegin = std::uniform_int_distribution<int>(i + 2, n - 1)(rng);
+            int jEnd = std::uniform_int_distribution<int>(jBegin, n)(rng);
+
+            double expected = 0;
+            int expectedJ = -1;
+            for (int j = jBegin; j < jEnd; j++)
+            {
+                double delta = (instance.dist(closed[i], closed[j]) + instance.dist(closed[i + 1], closed[j + 1]))
+                             - (instance.dist(closed[j], closed[j + 1]) + instance.dist(closed[i], closed[i + 1]));
+                if (delta < expected)
+                {
+                    expected = delta;
+                    expectedJ = j;
+                }
+            }
+            double delta = 0;
+            int j = bestTwoOptMove(instance, closed, edges, i, jBegin, jEnd, delta);
+            if (j != expectedJ || !near(delta, expected))
+                wrong++;
+
+            // a bound no move beats leaves the result alone
+            double bound = expected - 1;
+            if (bestTwoOptMove(instance, closed, edges, i, jBegin, jEnd, bound) != -1 || bound != expected - 1)
+                wrong++;
+        }
+    }
+    check(wrong == 0, std::to_string(wrong) + " kernel results on " + name + " differ from the plain loop");
+}
+
+int main()
+{
+    auto complete = loadGraph("datasets/extra-fully-connected-graphs/edges_300.csv");
+    TSPInstance dense = TSPInstance::fromGraph(*complete);
+    check(dense.isDense(), "edges_300 does not give a dense instance");
+    compare(dense, "edges_300");
+
+    // over DENSE_LIMIT vertices the distances are computed from the coordinates
+    auto real = loadGraph("datasets/real-world-graphs/graph2/", true);
+    TSPInstance coordinates = TSPInstance::fromGraph(*real);
+    check(!coordinates.isDense(), "graph2 gives a dense instance");
+    compare(coordinates, "graph2");
+    return finish();
+}